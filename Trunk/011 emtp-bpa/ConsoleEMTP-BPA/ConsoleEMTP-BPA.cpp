@@ -2,33 +2,983 @@
 //
 
 #include <iostream>
+#include <chrono>
+#include <cmath>
 #include "emtp_cmn.h"
 
+// --bench-format : per-call cost of FORMAT parsing, uncached vs cached
+static int bench_format()
+{
+  static char const* const formats[] = {
+    "(24x,3e8.0,i8)",
+    "(/,' AT 666  OF  \"OVER12\" .   KSW, RNG, BIAS, ANGLE =',1i10,3e16.6)",
+    "(1x,i6,2x,a6,2x,a6,5e15.6,/,(15x,5e15.6))",
+    "(13a6,a2)",
+  };
+  int const ncall = 200000;
+  auto time_per_call = [&](auto&& body) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int n = 0; n < ncall; ++n)
+      for (auto fmt : formats)
+        body(fmt);
+    std::chrono::duration<double, std::nano> dt = std::chrono::steady_clock::now() - t0;
+    return dt.count() / (ncall * std::size(formats));
+  };
+  std::size_t sink = 0;
+  double parse = time_per_call([&](char const* fmt) {
+    fem::format::tokenizer tz(fmt, unsigned(std::strlen(fmt)));
+    sink += tz.tokens.size();
+  });
+  double cached = time_per_call([&](char const* fmt) {
+    fem::format::token_loop tl{ fem::str_cref(fmt) };
+    sink += tl.tokens->size();
+  });
+  char buf[132];
+  double write = time_per_call([&](char const*) {
+    fem::write_loop(fem::str_ref(buf, sizeof(buf)), "(1x,3e15.6,i8)"), 1.0, 2.0, 3.0, 4;
+    sink += buf[0];
+  });
+  std::cout << "FORMAT tokenize " << parse << " ns/call, cached " << cached
+    << " ns/call, internal write " << write << " ns/call (" << sink % 2 << ")\n";
+  return 0;
+}
+
+// --bench-fd : per-step cost of the recursive convolutions of 100 JMarti
+// lines of 20 zeros and 20 poles, the FORTRAN loops vs FdConvolution
+static int bench_fd()
+{
+  int const nline = 100;
+  int const np = 20;
+  int const nstep = 20000;
+  // per line as in SCONST: M, P, Q of the zeros, their states at the K
+  // and M ends, then the same for the poles
+  std::size_t const stride = 10 * np;
+  std::vector<double> init(nline * stride);
+  for (int l = 0; l < nline; ++l) {
+    for (int j = 0; j < 2; ++j) {
+      double* c = &init[l * stride + j * 5 * np];
+      for (int i = 0; i < np; ++i) {
+        double const p = (10.0 + l) * std::pow(1.6 + 0.1 * j, i);
+        c[i] = std::exp(-p * 5.0e-6);
+        c[np + i] = (1.0 - c[i]) / p;
+        c[2 * np + i] = 0.5 * c[np + i];
+      }
+    }
+  }
+  std::vector<double> input(nline + 1);
+  for (int l = 0; l <= nline; ++l)
+    input[l] = std::sin(0.1 * l);
+  double sink[2] = {};
+  auto time_per_step = [&](std::vector<double>& s, int k, auto&& body) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int n = 0; n < nstep; ++n) {
+      for (int l = 0; l < nline; ++l) {
+        double const u = input[l];
+        double const v = input[l + 1];
+        body(&s[l * stride], u, v);
+        sink[k] += s[l * stride + 3 * np];
+      }
+    }
+    std::chrono::duration<double, std::nano> dt = std::chrono::steady_clock::now() - t0;
+    return dt.count() / nstep;
+  };
+  std::vector<double> loops(init);
+  double const t1 = time_per_step(loops, 0, [&](double* s, double u, double v) {
+    double yk = 0.0;
+    double ym = 0.0;
+    for (int j = 0; j < 2; ++j) {
+      double* c = s + j * 5 * np;
+      for (int i = 0; i < np; ++i) {
+        if (j == 0) {
+          c[3 * np + i] = c[np + i] * u + c[2 * np + i] * v + c[i] * c[3 * np + i];
+          c[4 * np + i] = c[np + i] * v + c[2 * np + i] * u + c[i] * c[4 * np + i];
+        }
+        else {
+          c[3 * np + i] = c[i] * c[3 * np + i] + c[np + i] * u + c[2 * np + i] * v;
+          c[4 * np + i] = c[i] * c[4 * np + i] + c[np + i] * v + c[2 * np + i] * u;
+        }
+      }
+      for (int i = 0; i < np; ++i) {
+        yk += c[i] * c[3 * np + i];
+        ym += c[i] * c[4 * np + i];
+      }
+    }
+    s[3 * np] += 1.0e-30 * (yk + ym);
+  });
+  std::vector<double> kernel(init);
+  double const t2 = time_per_step(kernel, 1, [&](double* s, double u, double v) {
+    double yk = 0.0;
+    double ym = 0.0;
+    for (int j = 0; j < 2; ++j) {
+      double* c = s + j * 5 * np;
+      if (j == 0) {
+        emtp::FdConvolution::zeros(c, c + np, c + 2 * np, c + 3 * np, c + 4 * np,
+          u, v, v, u, np);
+      }
+      else {
+        emtp::FdConvolution::poles(c, c + np, c + 2 * np, c + 3 * np, c + 4 * np,
+          u, v, v, u, np);
+      }
+      emtp::FdConvolution::sums(yk, ym, c, c + 3 * np, c + 4 * np, np);
+    }
+    s[3 * np] += 1.0e-30 * (yk + ym);
+  });
+  bool const same = loops == kernel && sink[0] == sink[1];
+  std::cout << "JMARTI " << nline << " lines x " << np << " poles: FORTRAN loops "
+    << t1 / 1000.0 << " us/step, FdConvolution " << t2 / 1000.0 << " us/step, "
+    << (same ? "same results" : "RESULTS DIFFER") << '\n';
+  return same ? 0 : 1;
+}
+
+// --bench-names : node numbers of the branch cards of ladder networks of
+// 1k, 10k and 50k nodes (two names a card, new ones appended to BUS), by
+// the search loop of OVER2 and by NameIndex
+static int bench_names()
+{
+  bool same = true;
+  for (int const nnode : { 1000, 10000, 50000 }) {
+    std::vector<std::string> names(nnode);
+    for (int k = 0; k < nnode; ++k) {
+      char b[16];
+      std::snprintf(b, sizeof(b), "N%05d", k);
+      names[k] = b;
+    }
+    auto ingest = [&](auto&& find, std::vector<int>& nodes) {
+      fem::arr<fem::str<8> > bus(fem::dimension(nnode + 1), fem::fill0);
+      int ntot = 1;
+      bus(1) = " ";
+      nodes.clear();
+      auto t0 = std::chrono::steady_clock::now();
+      for (int k = 0; k + 1 < nnode; ++k) {
+        for (int c = 0; c < 2; ++c) {
+          fem::str<6> name(names[k + c].c_str());
+          int n = find(bus, ntot, name);
+          if (n == 0) {
+            bus(++ntot) = name;
+            n = ntot;
+          }
+          nodes.push_back(n);
+        }
+      }
+      std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+      return dt.count();
+    };
+    std::vector<int> loops, indexed;
+    double const t1 = ingest([](const fem::arr<fem::str<8> >& bus, int ntot,
+      const fem::str<6>& name) {
+      int n = 0;
+      for (int i = 1; i <= ntot; ++i) {
+        if (name == bus(i))
+          n = i;
+      }
+      return n;
+    }, loops);
+    emtp::NameIndex index;
+    double const t2 = ingest([&](const fem::arr<fem::str<8> >& bus, int ntot,
+      const fem::str<6>& name) {
+      return index.last(bus, ntot, name);
+    }, indexed);
+    same = same && loops == indexed;
+    std::cout << "BUS " << nnode << " nodes, " << nnode - 1 << " cards: search loop "
+      << t1 << " s, NameIndex " << t2 << " s, "
+      << (loops == indexed ? "same nodes" : "NODES DIFFER") << '\n';
+  }
+  return same ? 0 : 1;
+}
+
+// LINE CONSTANTS geometries of case0004 - case0006 swept over 6 decades of
+// 50 points from 0.1 Hz: the conductor and frequency cards
+static char const* const lc_cases[][2] = {
+  { "case0004",
+    " 1    .5   .0426 4         1.762   -32.    102.1    32.     18.      0.        2\n"
+    " 2    .5   .0426 4         1.762     0.    102.1    32.     18.      0.        2\n"
+    " 3    .5   .0426 4         1.762    32.    102.1    32.     18.      0.        2\n"
+    " 0    .5   2.4   4          .385   -19.8   130.     83.5\n"
+    " 0    .5   2.4   4          .385    19.8   130.     83.5\n"
+    "BLANK CARD TERMINATING CONDUCTOR CARDS\n"
+    "    100.       0.1         1 111111 111111 1                 6 50\n" },
+  { "case0005",
+    " 1    .5   .1195 4         1.165   -60.    101.2             18.      0.  RAIL 2\n"
+    " 2    .5   .1195 4         1.165   -45.     80.              18.      0.  RAIL 2\n"
+    " 3    .5   .1195 4         1.165   -75.     80.              18.      0.  RAIL 2\n"
+    " 0    .5   1.901 4         .3854   -47.    114.\n"
+    " 0    .5   1.901 4         .3854   -73.    114.\n"
+    " 4    .5   .1191 4         1.196    60.    101.2             18.      0.CARDIN 2\n"
+    " 5    .5   .1191 4         1.196    45.     80.              18.      0.CARDIN 2\n"
+    " 6    .5   .1191 4         1.196    75.     80.              18.      0.CARDIN 2\n"
+    " 0    .5   6.59  4          .36     47.    114.\n"
+    " 0    .5   6.59  4          .36     73.    114.\n"
+    "BLANK CARD TERMINATING CONDUCTOR CARDS\n"
+    "    100.       0.1         1 111111 111111 1                 6 50\n" },
+  { "case0006",
+    " 1    .0   .001  3  1.0    0.994     0.      88.     50.\n"
+    " 2    .0   .002  3  1.0    0.525     6.     100.     75.\n"
+    " 2    .0   .002  3  1.0    0.525    40.     100.     75.\n"
+    "BLANK CARD TERMINATING CONDUCTOR CARDS\n"
+    "      1.       0.1         0 111111 111111 1                 6 50\n" },
+};
+
+// the data deck of one of them, in the temporary directory
+static std::string lc_deck(char const* const (&c)[2])
+{
+  namespace fs = std::filesystem;
+  std::string const deck = (fs::temp_directory_path() / (std::string("bench_lc_") + c[0] + ".dat")).string();
+  std::ofstream out(deck);
+  out << "BEGIN NEW DATA CASE\nLINE CONSTANTS\n" << c[1]
+    << "BLANK CARD TERMINATING FREQUENCY CARDS\n"
+    << "BLANK CARD TERMINATING LINE CONSTANTS CASES\n"
+    << "BLANK CARD TERMINATING THE CASE\n";
+  return deck;
+}
+
+// and the files of its run removed
+static void lc_remove(const std::string& deck)
+{
+  namespace fs = std::filesystem;
+  for (auto const& f : { deck, deck + ".log", deck + ".out", deck + ".out2" }) {
+    std::error_code ec;
+    fs::remove(f, ec);
+  }
+}
+
+// the printout of a run without the lines of a clock: times in SEC. and
+// the date
+static std::vector<std::string> clockless_printout(const std::string& log)
+{
+  std::vector<std::string> lines;
+  std::ifstream in(log);
+  std::string l;
+  while (std::getline(in, l)) {
+    std::size_t const b = l.find_first_not_of(' ');
+    bool const date = b != std::string::npos && l.size() >= b + 19
+      && l[b + 4] == '-' && l[b + 7] == '-' && l[b + 13] == ':';
+    if (!date && l.find("SEC.") == std::string::npos)
+      lines.push_back(l);
+  }
+  return lines;
+}
+
+// --bench-lc : the LINE CONSTANTS cases of case0004 - case0006, swept over
+// 6 decades of 50 points from 0.1 Hz, run with 1 step thread and with one
+// per hardware thread; the printouts must be the same apart from the times
+static int bench_lc()
+{
+  int const nthread = std::max(int(std::thread::hardware_concurrency()), 2);
+  bool same = true;
+  for (auto const& c : lc_cases) {
+    std::string const deck = lc_deck(c);
+    std::vector<std::string> logs[2];
+    double run[2], wait[2];
+    std::int64_t n = 0;
+    for (int k = 0; k < 2; ++k) {
+      emtp::Simulation sim;
+      sim.step_threads(k == 0 ? 1 : nthread);
+      auto const t0 = std::chrono::steady_clock::now();
+      sim.run(deck, deck + ".log", deck + ".out");
+      std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+      run[k] = dt.count();
+      wait[k] = sim.cmn().line_sweep.seconds();
+      n = sim.cmn().line_sweep.frequencies();
+      logs[k] = clockless_printout(deck + ".log");
+    }
+    bool const ok = !logs[0].empty() && logs[0] == logs[1];
+    same = same && ok;
+    std::cout << "LINE CONSTANTS " << c[0] << ", " << n << " frequencies on the step threads: 1 thread "
+      << run[0] << " s (sweep " << wait[0] << " s), " << nthread << " threads " << run[1]
+      << " s (sweep " << wait[1] << " s), " << (ok ? "same printout" : "PRINTOUT DIFFERS") << '\n';
+    lc_remove(deck);
+  }
+  return same ? 0 : 1;
+}
+
+// CABLE CONSTANTS cases of three single-core cables, of three cables in a
+// pipe and of an overhead system, swept over 6 decades of 50 points from
+// 1 Hz: the cards after "CABLE CONSTANTS"
+static char const* const cc_cases[][2] = {
+  { "cables",
+    "    2   -1    3    0    1    0    0    0    0\n"
+    "    2    2    2\n"
+    "       0.0     .0234     .0385     .0413     .0484       0.0       0.0\n"
+    "    1.7E-8       1.0       1.0       3.5    2.1E-7       1.0       1.0       2.3\n"
+    "       0.0     .0234     .0385     .0413     .0484       0.0       0.0\n"
+    "    1.7E-8       1.0       1.0       3.5    2.1E-7       1.0       1.0       2.3\n"
+    "       0.0     .0234     .0385     .0413     .0484       0.0       0.0\n"
+    "    1.7E-8       1.0       1.0       3.5    2.1E-7       1.0       1.0       2.3\n"
+    "       1.0       0.0       1.0       0.3       1.0       0.6\n"
+    "           100.             1.    6   50\n" },
+  { "pipe-type",
+    "    3   -1    3    0    1    0    0    1    0\n"
+    "        .1       .11       .12    1.7E-7      300.        1.        2.        1.\n"
+    "      .045        0.      .045      120.      .045      240.\n"
+    "    2    2    2\n"
+    "       0.0     .0134     .0235     .0253     .0284       0.0       0.0\n"
+    "    1.7E-8       1.0       1.0       3.5    2.1E-7       1.0       1.0       2.3\n"
+    "       0.0     .0134     .0235     .0253     .0284       0.0       0.0\n"
+    "    1.7E-8       1.0       1.0       3.5    2.1E-7       1.0       1.0       2.3\n"
+    "       0.0     .0134     .0235     .0253     .0284       0.0       0.0\n"
+    "    1.7E-8       1.0       1.0       3.5    2.1E-7       1.0       1.0       2.3\n"
+    "       1.0       0.0\n"
+    "           100.             1.    6   50\n" },
+  { "overhead",
+    "    1    1    1    0    1    0    0    0    0\n"
+    "    3    2    1    1\n"
+    "     .0203      .005     .0056      .001       0.0       0.0\n"
+    "    3.2E-8       1.0    2.8E-7       1.0\n"
+    "       20.       -8.       0.0       20.        0.       0.0\n"
+    "       20.        8.       0.0       28.       -5.       0.0\n"
+    "       28.        5.       0.0\n"
+    "           100.             1.    6   50\n" },
+};
+
+// --bench-cc : the CABLE CONSTANTS cases of cc_cases run with 1 step
+// thread and with one per hardware thread; the printouts must be the same
+// apart from the times
+static int bench_cc()
+{
+  namespace fs = std::filesystem;
+  int const nthread = std::max(int(std::thread::hardware_concurrency()), 2);
+  // seconds of the Z matrices, from the case statistics
+  auto z_seconds = [](const std::string& log) {
+    std::ifstream in(log);
+    std::string l;
+    while (std::getline(in, l)) {
+      std::size_t const p = l.find("CABLE CONSTANTS SWEEP:");
+      if (p != std::string::npos)
+        return std::atof(l.c_str() + l.find(" IN ", p) + 4);
+    }
+    return 0.0;
+  };
+  bool same = true;
+  for (auto const& c : cc_cases) {
+    std::string const deck = (fs::temp_directory_path() / (std::string("bench_cc_") + c[0] + ".dat")).string();
+    {
+      std::ofstream out(deck);
+      out << "BEGIN NEW DATA CASE\nCABLE CONSTANTS\n" << c[1]
+        << "BLANK CARD TERMINATING FREQUENCY CARDS\n"
+        << "BLANK CARD TERMINATING CABLE CONSTANTS\n"
+        << "BLANK CARD TERMINATING THE CASE\n";
+    }
+    std::vector<std::string> logs[2];
+    double run[2], z[2];
+    for (int k = 0; k < 2; ++k) {
+      emtp::Simulation sim;
+      sim.step_threads(k == 0 ? 1 : nthread);
+      auto const t0 = std::chrono::steady_clock::now();
+      sim.run(deck, deck + ".log", deck + ".out");
+      std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+      run[k] = dt.count();
+      z[k] = z_seconds(deck + ".log");
+      logs[k] = clockless_printout(deck + ".log");
+    }
+    bool const ok = !logs[0].empty() && logs[0] == logs[1];
+    same = same && ok;
+    std::cout << "CABLE CONSTANTS " << c[0] << ": 1 thread " << run[0] << " s (Z matrices "
+      << z[0] << " s), " << nthread << " threads " << run[1] << " s (Z matrices " << z[1]
+      << " s), " << (ok ? "same printout" : "PRINTOUT DIFFERS") << '\n';
+    lc_remove(deck);
+  }
+  return same ? 0 : 1;
+}
+
+// a grid of  nrow x ncol  nodes joined by single-phase constant-parameter
+// lines of 30 to 90 miles, each node loaded to ground, fed by a 60 Hz
+// source at one corner and run for  tmax  seconds of 5 us steps; the
+// number of lines in  nline
+static std::string lines_deck(int nrow, int ncol, char const* tmax, int& nline)
+{
+  namespace fs = std::filesystem;
+  static char const* const lengths[] = { "30.", "45.", "60.", "90." };
+  auto node = [](int r, int c) {
+    char b[24];
+    std::snprintf(b, sizeof(b), "N%02d%03d", r, c);
+    return std::string(b);
+  };
+  std::string const deck = (fs::temp_directory_path() / "bench_lines.dat").string();
+  std::ofstream out(deck);
+  out << "BEGIN NEW DATA CASE\n  5.0E-6" << std::right << std::setw(8) << tmax << '\n'
+    << "    1000       1       0       0       0       0       0       0       0\n";
+  nline = 0;
+  for (int r = 0; r < nrow; ++r) {
+    for (int c = 0; c < ncol; ++c) {
+      for (int k = 0; k < 2; ++k) {
+        int const r2 = r + k;
+        int const c2 = c + 1 - k;
+        if (r2 < nrow && c2 < ncol) {
+          char card[96];
+          std::snprintf(card, sizeof(card), "-1%s%s%12s%6s%6s%6s%6s 1", node(r, c).c_str(),
+            node(r2, c2).c_str(), "", "0.02", "400.", "2.9E5", lengths[nline++ % 4]);
+          out << card << '\n';
+        }
+      }
+      out << "  " << node(r, c) << "                   2000.\n";
+    }
+  }
+  out << "BLANK CARD ENDING BRANCHES\nBLANK CARD ENDING SWITCHES\n"
+    << "14" << node(0, 0) << "   400000.       60.                           -1.\n"
+    << "BLANK CARD ENDING SOURCES\n  " << node(nrow - 1, ncol - 1) << node(nrow / 2, ncol / 2)
+    << "\nBLANK CARD ENDING NODE VOLTAGE OUTPUT\nBLANK CARD ENDING PLOTS\n"
+    << "BEGIN NEW DATA CASE\nBLANK CARD ENDING THE CASE\n";
+  return deck;
+}
+
+// --bench-lines : the deck of lines_deck() for a 14 x 19 grid (499 lines)
+// over 40000 steps, with the line histories in XK / XM by the FORTRAN
+// code of SUBTS2 and in the rings of line_history.h; the output rows of
+// both, and the seconds of each run
+static int bench_lines()
+{
+  int nline = 0;
+  std::string const deck = lines_deck(14, 19, "2.0E-1", nline);
+  std::string out[2];
+  double run[2] = {};
+  for (int m = 0; m < 2; ++m) {
+    emtp::Simulation sim;
+    sim.line_history(m == 1);
+    auto t0 = std::chrono::steady_clock::now();
+    sim.run(deck, deck + ".log", deck + ".out");
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+    run[m] = dt.count();
+    std::ifstream in(deck + ".out", std::ios::binary);
+    std::string line;
+    std::getline(in, line);
+    out[m].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  bool const same = !out[0].empty() && out[0] == out[1];
+  std::cout << "LINES " << nline << " constant-parameter lines, 40000 steps: XK / XM "
+    << run[0] << " s, rings " << run[1] << " s, " << (same ? "same rows" : "ROWS DIFFER")
+    << '\n';
+  lc_remove(deck);
+  return same ? 0 : 1;
+}
+
+// case0012 scaled to  n  towers: a lightning stroke on the ground wire of
+// the first, the spans between the towers lumped R-L branches, a ZnO
+// arrester from the phase to the ground wire of each tower and flashover
+// switches at the footings of the first 20; in the temporary directory
+static std::string towers_deck(int n)
+{
+  namespace fs = std::filesystem;
+  auto node = [](int k, char const* s) {
+    char b[16];
+    std::snprintf(b, sizeof(b), "T%03d%s", k, s);
+    return std::string(b);
+  };
+  std::string const deck = (fs::temp_directory_path() / "bench_columns.dat").string();
+  std::ofstream out(deck);
+  out << "BEGIN NEW DATA CASE\n1.020E-8  6.0E-6\n"
+    << "    1000       1       0       0       0       0       0       0       0\n"
+    << " 1" << node(n, "PH") << "                  240.40\n"
+    << " 2" << node(n, "GW") << "                  46.800            158.23\n";
+  for (int k = 1; k <= n; ++k) {
+    char card[96];
+    out << "  " << node(k, "GR") << "                    25.0\n";
+    std::snprintf(card, sizeof(card), "-1%s%s%12s%6s%6s%6s%6s 1", node(k, "GW").c_str(),
+      node(k, "GR").c_str(), "", "0.", "100.0", "9.8E8", "100.0");
+    out << card << '\n';
+    if (k < n) {
+      out << "  " << node(k, "PH") << node(k + 1, "PH") << "               .02   .32\n"
+        << "  " << node(k, "GW") << node(k + 1, "GW") << "               .06   .40\n";
+    }
+    out << "92" << node(k, "PH") << node(k, "GW") << "                        5555.\n"
+      << "                  200000.                     -1.0                      0.0\n"
+      << "                    2500.                     26.0                      0.5\n"
+      << "                    9999.\n";
+  }
+  out << "BLANK CARD ENDING BRANCHES\n";
+  for (int k = 1; k <= std::min(n, 20); ++k) {
+    char card[48];
+    std::snprintf(card, sizeof(card), "  %s      %10.3E%10.3E", node(k, "GR").c_str(),
+      2.5e-7 * k, 1.0);
+    out << card << '\n';
+  }
+  out << "BLANK CARD ENDING SWITCHES\n13" << node(1, "GW")
+    << "-1   -10000.               1.E-6     -0.5    80.E-6        0.\n"
+    << "BLANK CARD ENDING SOURCES\n  " << node(1, "GW") << node(1, "PH")
+    << node(n / 2, "GW") << node(n / 2, "PH")
+    << "\nBLANK CARD ENDING NODE VOLTAGE OUTPUT\nBLANK CARD ENDING PLOTS\n"
+    << "BEGIN NEW DATA CASE\nBLANK CARD ENDING THE CASE\n";
+  return deck;
+}
+
+// a mesh of  nrow x ncol  nodes joined by R-L branches, each loaded to
+// ground, with  nz  ZnO arresters to ground spread over it, 20 switches to
+// resistors and a stroke at the center; in the temporary directory
+static std::string mesh_deck(int nrow, int ncol, int nz)
+{
+  namespace fs = std::filesystem;
+  auto node = [](int r, int c) {
+    char b[16];
+    std::snprintf(b, sizeof(b), "R%02dC%02d", r, c);
+    return std::string(b);
+  };
+  std::string const deck = (fs::temp_directory_path() / "bench_columns.dat").string();
+  std::ofstream out(deck);
+  out << "BEGIN NEW DATA CASE\n1.000E-8  6.0E-6\n"
+    << "     100       1       0       0       0       0       0       0       0\n";
+  for (int r = 0; r < nrow; ++r) {
+    for (int c = 0; c < ncol; ++c) {
+      if (c + 1 < ncol)
+        out << "  " << node(r, c) << node(r, c + 1) << "               0.1  0.01\n";
+      if (r + 1 < nrow)
+        out << "  " << node(r, c) << node(r + 1, c) << "               0.1  0.01\n";
+      out << "  " << node(r, c) << "                    400.\n";
+    }
+  }
+  for (int k = 0; k < 20; ++k) {
+    char card[48];
+    std::snprintf(card, sizeof(card), "  SW%02d                       10.", k);
+    out << card << '\n';
+  }
+  std::vector<char> taken(std::size_t(nrow) * ncol, 0);
+  for (int k = 0; k < nz; ++k) {
+    int const r = k * 7 % nrow;
+    int c = (k * 11 + 3) % ncol;
+    while (taken[r * ncol + c])
+      c = (c + 1) % ncol;
+    taken[r * ncol + c] = 1;
+    out << "92" << node(r, c) << "                              5555.\n"
+      << "                  100000.                     -1.0                      0.0\n"
+      << "                    2500.                     26.0                      0.5\n"
+      << "                    9999.\n";
+  }
+  out << "BLANK CARD ENDING BRANCHES\n";
+  for (int k = 0; k < 20; ++k) {
+    char card[48];
+    std::snprintf(card, sizeof(card), "  %sSW%02d  %10.3E%10.3E",
+      node(k * 3 % nrow, (k * 5 + 1) % ncol).c_str(), k, 2e-7 * (k + 1), 1.0);
+    out << card << '\n';
+  }
+  out << "BLANK CARD ENDING SWITCHES\n13" << node(nrow / 2, ncol / 2)
+    << "-1   -30000.               1.E-6     -0.5    80.E-6        0.\n"
+    << "BLANK CARD ENDING SOURCES\n  " << node(nrow / 2, ncol / 2) << node(0, 3)
+    << "\nBLANK CARD ENDING NODE VOLTAGE OUTPUT\nBLANK CARD ENDING PLOTS\n"
+    << "BEGIN NEW DATA CASE\nBLANK CARD ENDING THE CASE\n";
+  return deck;
+}
+
+// --bench-columns : the towers of case0012 with 50 and 100 ZnO arresters,
+// and meshes of 10 x 20 and 30 x 30 nodes with 50 and 100, each run with
+// the FORTRAN loops of SUBTS1 (--legacy-solve), as by default, and with
+// both timed (--bench-solve); ns of one solution of the NCOMP columns each
+// way, the pass the default takes, and the output rows of the runs
+static int bench_columns()
+{
+  struct Case {
+    char const* name;
+    int n, nrow, ncol;
+  };
+  static Case const cases[] = {
+    { "towers", 50, 0, 0 }, { "towers", 100, 0, 0 },
+    { "mesh 10 x 20", 50, 10, 20 }, { "mesh 30 x 30", 100, 30, 30 },
+  };
+  bool same = true;
+  for (auto const& c : cases) {
+    std::string const deck = c.nrow > 0 ? mesh_deck(c.nrow, c.ncol, c.n) : towers_deck(c.n);
+    static emtp::SolveMode const modes[] = {
+      emtp::SolveMode::legacy, emtp::SolveMode::compiled, emtp::SolveMode::bench };
+    std::string out[3];
+    long long compiled = 0, solves = 0, columns = 0, mismatches = 0;
+    int rows = 0, terms = 0;
+    double ns[2] = {};
+    for (int m = 0; m < 3; ++m) {
+      emtp::Simulation sim;
+      sim.solve_mode(modes[m]);
+      sim.table_scale(4);  // the lists of 100 towers, without a second run
+      // without the report of --bench-solve
+      std::ostringstream report;
+      std::streambuf* const cout = std::cout.rdbuf(report.rdbuf());
+      sim.run(deck, deck + ".log", deck + ".out");
+      std::cout.rdbuf(cout);
+      std::ifstream in(deck + ".out", std::ios::binary);
+      std::string line;
+      std::getline(in, line);
+      out[m].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      auto const& ysolve = sim.cmn().ysolve;
+      if (modes[m] == emtp::SolveMode::compiled)
+        compiled = ysolve.column_solves();
+      if (modes[m] == emtp::SolveMode::bench) {
+        rows = ysolve.rows();
+        terms = ysolve.terms();
+        solves = ysolve.column_solves();
+        columns = ysolve.columns();
+        ns[0] = ysolve.column_ns(false);
+        ns[1] = ysolve.column_ns(true);
+        mismatches = ysolve.mismatches();
+      }
+    }
+    bool const ok = !out[0].empty() && out[0] == out[1] && out[0] == out[2] && mismatches == 0;
+    same = same && ok;
+    std::cout << "COLUMNS " << c.name << ", " << c.n << " ZnO arresters, " << rows << " rows, "
+      << terms << " terms, " << solves << " solutions of " << (solves > 0 ? columns / solves : 0)
+      << " columns: loops " << ns[0] << " ns, compiled " << ns[1] << " ns each, takes "
+      << (compiled > 0 ? "compiled" : "the loops") << ", "
+      << (ok ? "same rows" : "ROWS DIFFER") << '\n';
+    lc_remove(deck);
+  }
+  return same ? 0 : 1;
+}
+
+// --bench-zno : the towers of case0012 with 200 and 300 ZnO arresters in
+// one subnetwork, run with the FORTRAN ZINCOX (--legacy-solve) and with
+// the inverses of zno_newton.h; the output rows of both, the seconds of
+// each run and the Newton solutions
+static int bench_zno()
+{
+  static int const cases[][2] = { { 200, 16 }, { 300, 32 } };  // arresters, list scale
+  bool same = true;
+  for (auto const& c : cases) {
+    std::string const deck = towers_deck(c[0]);
+    std::string out[2];
+    double run[2] = {};
+    std::int64_t solutions = 0, iterations = 0, inverted = 0, reused = 0;
+    for (int m = 0; m < 2; ++m) {
+      emtp::Simulation sim;
+      sim.solve_mode(m == 0 ? emtp::SolveMode::legacy : emtp::SolveMode::compiled);
+      sim.table_scale(c[1]);
+      auto t0 = std::chrono::steady_clock::now();
+      sim.run(deck, deck + ".log", deck + ".out");
+      std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+      run[m] = dt.count();
+      std::ifstream in(deck + ".out", std::ios::binary);
+      std::string line;
+      std::getline(in, line);
+      out[m].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      auto const& zno = sim.cmn().zno;
+      solutions = zno.solutions();
+      iterations = zno.iterations();
+      inverted = zno.inverted();
+      reused = zno.reused();
+    }
+    bool const ok = !out[0].empty() && out[0] == out[1];
+    same = same && ok;
+    std::cout << "ZNO towers, " << c[0] << " ZnO arresters, " << solutions
+      << " Newton solutions of " << iterations << " iterations: FORTRAN " << run[0]
+      << " s, zno_newton.h " << run[1] << " s (" << inverted << " inverses, " << reused
+      << " reused), " << (ok ? "same rows" : "ROWS DIFFER") << '\n';
+    lc_remove(deck);
+  }
+  return same ? 0 : 1;
+}
+
+// a TACS deck of  nsup  free-format supplemental variables in a chain on
+// the voltage of a 60 Hz source, over 2000 steps, in the temporary
+// directory
+static std::string tacs_deck(int nsup)
+{
+  namespace fs = std::filesystem;
+  static char const* const forms[] = {
+    "%s * 0.5 - SQRT (ABS (%s)) * COS (OMEGAR * TIMEX)",
+    "%s ** 2 - EXP (- ABS (%s) / 100.) + SIN (SOURCE / 150.)",
+    "( %s .GT. 10.0 ) .OR. ( SOURCE .LT. 0.0 )",
+    "SOURCE / ( %s + 1.0 ) - ATAN (%s) + 150. * 2.0 / 3.0",
+    ".NOT. %s .AND. ( %s .GE. 0.0 )",
+  };
+  std::string const deck = (fs::temp_directory_path() / "bench_tacs.dat").string();
+  std::ofstream out(deck);
+  out << "BEGIN NEW DATA CASE\n  50.E-6     .1\n     500       1       1       1       1\n"
+    << "TACS HYBRID\n90SOURCE\n";
+  char a[8] = "SOURCE", b[8] = "SOURCE";
+  for (int k = 1; k <= nsup; ++k) {
+    char name[8], expr[96];
+    std::snprintf(name, sizeof(name), "X%03d", k);
+    std::snprintf(expr, sizeof(expr), forms[k % 5], a, b);
+    out << "98" << std::left << std::setw(6) << name << "  = " << expr << '\n';
+    std::memcpy(b, a, sizeof(a));
+    std::memcpy(a, name, sizeof(a));
+  }
+  out << "33";
+  for (int k = nsup - 9; k <= nsup; ++k) {
+    char name[8];
+    std::snprintf(name, sizeof(name), "X%03d", k);
+    out << std::left << std::setw(6) << name;
+  }
+  out << "\nBLANK CARD ENDING TACS\n"
+    << "  SOURCELOAD               1.41  3.75\n  LOAD                     200.\n"
+    << "BLANK CARD ENDING BRANCHES\nBLANK CARD ENDING SWITCHES\n"
+    << "14SOURCE       150.     60.         0.                            -1.\n"
+    << "BLANK CARD ENDING SOURCES\n  SOURCELOAD\nBLANK CARD ENDING OUTPUTS\n"
+    << "BLANK CARD ENDING PLOT\nBEGIN NEW DATA CASE\nBLANK\n";
+  return deck;
+}
+
+// --bench-tacs : the deck of tacs_deck() with the supplemental variables
+// interpreted by CSUP and run as the code of tacs_bytecode.h; the output
+// rows of both, and the time of one pass of CSUP over the variables from
+// the state at the end of the run
+static int bench_tacs()
+{
+  int const nsup = 200;
+  std::string const deck = tacs_deck(nsup);
+  std::string out[2];
+  double run[2] = {}, step[2] = {};
+  std::vector<double> values[2];
+  int compiled = 0;
+  std::int64_t instructions = 0;
+  for (int m = 0; m < 2; ++m) {
+    emtp::Simulation sim;
+    sim.tacs_bytecode(m == 1);
+    sim.tacs_timed(true);
+    auto t0 = std::chrono::steady_clock::now();
+    sim.run(deck, deck + ".log", deck + ".out");
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+    run[m] = dt.count();
+    std::ifstream in(deck + ".out", std::ios::binary);
+    std::string line;
+    std::getline(in, line);
+    out[m].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    // CSUP over the chain of the time steps, as TACS3 calls it, without
+    // its own clock
+    emtp::common& cmn = sim.cmn();
+    cmn.tacs_code.timed(false);
+    int const L = cmn.isptacs(cmn.tacsar.kiuty + 4);
+    int const nnn = cmn.tacsar.kxtcs + cmn.tacsar.nuk + cmn.lstat(64);
+    int const npass = 20000;
+    if (L > 0) {
+      t0 = std::chrono::steady_clock::now();
+      for (int n = 0; n < npass; ++n)
+        emtp::csup(cmn, L);
+      dt = std::chrono::steady_clock::now() - t0;
+      step[m] = dt.count() / npass;
+      for (int i = 1; i <= cmn.tacsar.nsup; ++i)
+        values[m].push_back(cmn.sptacs(nnn + i));
+    }
+    compiled = cmn.tacs_code.compiled();
+    instructions = cmn.tacs_code.instructions();
+  }
+  bool const same = !out[0].empty() && out[0] == out[1] && values[0] == values[1];
+  std::cout << "TACS " << nsup << " supplemental variables (" << compiled << " compiled, "
+    << instructions << " instructions): deck interpreted " << run[0] << " s, compiled "
+    << run[1] << " s; CSUP per step interpreted " << step[0] * 1e6 << " us, compiled "
+    << step[1] * 1e6 << " us, " << (same ? "same rows" : "ROWS DIFFER") << '\n';
+  lc_remove(deck);
+  return same ? 0 : 1;
+}
 
 int main(int argc, char const* argv[])
 {
   namespace fs = std::filesystem;
-  std::string input;
-  if (argc < 2) {
+  std::vector<std::string> inputs(argv + std::min(argc, 1), argv + argc);
+  // -j N : threads for the energizations of STATISTICS / SYSTEMATIC cases
+  // --binary, --binary32 : time series to "<out>.bin" as float64 / float32
+  // --bin2csv FILE : convert such a file to the CSV text, as FILE.csv
+  // --decimate NAME=N : keep one step in N of output channel NAME (* : all)
+  // --scale N : EMTP list sizes N times the stock ones (default: from the deck)
+  // --legacy-solve : time steps solved by the FORTRAN loops of SUBTS3, and
+  //   ZnO arresters by those of ZINCOX
+  // --bench-solve : those loops and the compiled kernel, timed side by side
+  // --whole-network : no partitions of the compiled solution at distributed
+  //   lines
+  // --time-chunks : the time of each chunk of those partitions, listed with
+  //   the case statistics
+  // --full-refactor : every switch event retriangularizes all of (Y)
+  // --factor-cache MB : memory for the factors of recurring switch
+  //   configurations (default 64, 0: none)
+  // --legacy-lines : line histories in XK / XM by the FORTRAN code of SUBTS2
+  // --bench-lines : a grid of 499 lines run both ways, timed
+  // --bench-columns : decks of 50 / 100 ZnO arresters with their columns
+  //   solved both ways, timed
+  // --bench-zno : decks of 200 / 300 ZnO arresters with ZINCOX both ways,
+  //   timed
+  // --legacy-fd : JMarti convolutions by the FORTRAN loops of SUBTS2
+  // --bench-fd : those loops and FdConvolution on 100 lines, timed
+  // --bench-names : node numbers of ladder decks of 1k / 10k / 50k nodes
+  //   by the search loop of OVER2 and by the index of the names, timed
+  // --bench-lc : LINE CONSTANTS sweeps of 300 frequencies with 1 and N step
+  //   threads, timed, printouts compared
+  // --bench-cc : CABLE CONSTANTS sweeps of 301 frequencies with 1 and N step
+  //   threads, timed, printouts compared
+  // --legacy-tacs : TACS supplemental variables interpreted by CSUP at each
+  //   step, not run as the code of tacs_bytecode.h
+  // --bench-tacs : a TACS deck of 200 supplemental variables both ways,
+  //   timed per step
+  // --step-threads N : threads of each time step (default 1: serial,
+  //   0: one per hardware thread)
+  // --snapshot T : state of the time loop to "<out>.snap1", ... at time T
+  //   (may be given several times)
+  // --restart FILE : go on from the snapshot FILE, with the output in
+  //   FILE.log and FILE.out
+  // --sweep FILE : the time loop again for each variant of the switch times
+  //   in FILE, from the state at its start; rows in "<out>.<tag>"
+  int nthreads = 0;
+  int scale = 0;
+  auto solve_mode = emtp::SolveMode::compiled;
+  bool network_partitions = true;
+  bool solve_timed = false;
+  bool partial_refactor = true;
+  int factor_cache = 64;
+  bool line_history = true;
+  bool fd_convolution = true;
+  bool tacs_bytecode = true;
+  int step_threads = 1;
+  auto plot_format = emtp::PlotFormat::csv;
+  std::vector<std::pair<std::string, int>> decimation;
+  std::vector<double> snapshots;
+  std::string restart;
+  std::string sweep;
+  for (auto it = inputs.begin(); it != inputs.end(); ) {
+    if (*it == "-j" && it + 1 != inputs.end()) {
+      nthreads = std::atoi((it + 1)->c_str());
+      it = inputs.erase(it, it + 2);
+    }
+    else if (*it == "--scale" && it + 1 != inputs.end()) {
+      scale = std::atoi((it + 1)->c_str());
+      it = inputs.erase(it, it + 2);
+    }
+    else if (*it == "--legacy-solve" || *it == "--bench-solve") {
+      solve_mode = *it == "--legacy-solve" ? emtp::SolveMode::legacy : emtp::SolveMode::bench;
+      it = inputs.erase(it);
+    }
+    else if (*it == "--whole-network") {
+      network_partitions = false;
+      it = inputs.erase(it);
+    }
+    else if (*it == "--time-chunks") {
+      solve_timed = true;
+      it = inputs.erase(it);
+    }
+    else if (*it == "--step-threads" && it + 1 != inputs.end()) {
+      step_threads = std::atoi((it + 1)->c_str());
+      it = inputs.erase(it, it + 2);
+    }
+    else if (*it == "--snapshot" && it + 1 != inputs.end()) {
+      snapshots.push_back(std::atof((it + 1)->c_str()));
+      it = inputs.erase(it, it + 2);
+    }
+    else if (*it == "--restart" && it + 1 != inputs.end()) {
+      restart = fs::absolute(*(it + 1)).string();
+      it = inputs.erase(it, it + 2);
+    }
+    else if (*it == "--sweep" && it + 1 != inputs.end()) {
+      sweep = fs::absolute(*(it + 1)).string();
+      it = inputs.erase(it, it + 2);
+    }
+    else if (*it == "--factor-cache" && it + 1 != inputs.end()) {
+      factor_cache = std::atoi((it + 1)->c_str());
+      it = inputs.erase(it, it + 2);
+    }
+    else if (*it == "--full-refactor") {
+      partial_refactor = false;
+      it = inputs.erase(it);
+    }
+    else if (*it == "--legacy-lines") {
+      line_history = false;
+      it = inputs.erase(it);
+    }
+    else if (*it == "--legacy-fd") {
+      fd_convolution = false;
+      it = inputs.erase(it);
+    }
+    else if (*it == "--legacy-tacs") {
+      tacs_bytecode = false;
+      it = inputs.erase(it);
+    }
+    else if (*it == "--binary" || *it == "--binary32") {
+      plot_format = *it == "--binary" ? emtp::PlotFormat::float64 : emtp::PlotFormat::float32;
+      it = inputs.erase(it);
+    }
+    else if (*it == "--decimate" && it + 1 != inputs.end()) {
+      auto const& arg = *(it + 1);
+      auto const pos = arg.rfind('=');
+      if (pos != std::string::npos) {
+        decimation.emplace_back(arg.substr(0, pos), std::atoi(arg.c_str() + pos + 1));
+      }
+      it = inputs.erase(it, it + 2);
+    }
+    else if (*it == "--bin2csv" && it + 1 != inputs.end()) {
+      try {
+        std::ofstream csv(*(it + 1) + ".csv", std::ios::binary);
+        emtp::PlotReader::to_csv(*(it + 1), csv);
+      }
+      catch (const std::exception& e) {
+        std::cout << e.what() << '\n';
+        return 1;
+      }
+      return 0;
+    }
+    else if (*it == "--bench-format") {
+      return bench_format();
+    }
+    else if (*it == "--bench-lines") {
+      return bench_lines();
+    }
+    else if (*it == "--bench-columns") {
+      return bench_columns();
+    }
+    else if (*it == "--bench-zno") {
+      return bench_zno();
+    }
+    else if (*it == "--bench-fd") {
+      return bench_fd();
+    }
+    else if (*it == "--bench-names") {
+      return bench_names();
+    }
+    else if (*it == "--bench-lc") {
+      return bench_lc();
+    }
+    else if (*it == "--bench-cc") {
+      return bench_cc();
+    }
+    else if (*it == "--bench-tacs") {
+      return bench_tacs();
+    }
+    else {
+      ++it;
+    }
+  }
+  if (inputs.empty()) {
+    std::string input;
     std::cout << "Enter input File name: ";
     std::cin >> input;
+    inputs.push_back(input);
   }
-  else input = argv[1];
-  input = fs::absolute(input).string();
-  if (!fs::exists(input)) {
-    std::cout << "input file : \"" << input << "\" was not found !\n";
-    return 1;
+  // several input files are run one after another in the same context
+  emtp::Simulation sim;
+  sim.energization_threads(nthreads);
+  sim.plot_format(plot_format);
+  sim.table_scale(scale);
+  sim.solve_mode(solve_mode);
+  sim.network_partitions(network_partitions);
+  sim.solve_timed(solve_timed);
+  sim.partial_refactor(partial_refactor);
+  sim.factor_cache(factor_cache);
+  sim.line_history(line_history);
+  sim.fd_convolution(fd_convolution);
+  sim.tacs_bytecode(tacs_bytecode);
+  sim.step_threads(step_threads);
+  for (auto& d : decimation) {
+    sim.plot_decimation(d.first, d.second);
   }
-  try {
-    emtp::program_main(input, input + ".log", input + ".out");
+  for (double t : snapshots) {
+    sim.snapshot_at(t);
   }
-  catch (const std::exception& e) {
-    std::string get_exception_msg(const std::exception & e, int const level = 0);
-    std::cout << get_exception_msg(e) << '\n';
+  if (!restart.empty()) {
+    sim.restart_from(restart);
+  }
+  if (!sweep.empty()) {
+    sim.sweep(sweep);
+  }
+  int rc = 0;
+  for (auto input : inputs) {
+    input = fs::absolute(input).string();
+    if (!fs::exists(input)) {
+      std::cout << "input file : \"" << input << "\" was not found !\n";
+      rc = 1;
+      continue;
+    }
+    try {
+      // a run from a snapshot leaves the files of the first run alone
+      std::string const out = restart.empty() ? input : restart;
+      sim.run(input, out + ".log", out + ".out");
+    }
+    catch (const std::exception& e) {
+      std::string get_exception_msg(const std::exception & e, int const level = 0);
+      std::cout << get_exception_msg(e) << '\n';
+    }
   }
 
   //std::cout << "Hello World!\n";
-  return 0;
+  return rc;
 }
 
 // prints the explanatory string of an exception. If the exception is nested,
@@ -0,0 +1,257 @@
+/***********************************
+EMTP C++
+The terms of a CABLE CONSTANTS geometry that do not depend on the
+frequency, and the sweep of its frequencies evaluated ahead on the step
+threads.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+#include "step_pipeline.h"
+
+namespace emtp {
+
+  // The terms of the earth impedance of ZEGEN and of the pipe impedance of
+  // PTZY2 that depend on the geometry only. GUTS47 fills them before the
+  // frequencies of a geometry, the frequencies read them (on the step
+  // threads too); an angle or a pipe not filled is left to the routine.
+  class CableTerms {
+  public:
+    static constexpr int series = 21;  // ITER of ZEGEN
+    static constexpr int nbess = 19;   // NBESS of PTZY2
+
+    void clear() {
+      angles_.clear();
+      pipes_.clear();
+    }
+
+    // ZEGEN of  th : CS1, SS1, CS2, SS2, CS3, CS4 of the terms  I = 1, ...,
+    // series  of the series, then CS1 - CS4 of the asymptotic expansion
+    void angle(double th) {
+      if (angle_terms(th))
+        return;
+      Angle a;
+      a.th = th;
+      double const sq2 = std::sqrt(2.0);
+      for (int i = 1; i <= series; ++i) {
+        double const t = i - 1;
+        double const t2 = t * 4.f;
+        double* cs = a.cs + 6 * (i - 1);
+        cs[0] = std::cos((t2 + 2.f) * th);
+        cs[1] = std::sin((t2 + 2.f) * th);
+        cs[2] = std::cos((t2 + 4.f) * th);
+        cs[3] = std::sin((t2 + 4.f) * th);
+        cs[4] = std::cos((t2 + 1.f) * th);
+        cs[5] = std::cos((t2 + 3.f) * th);
+      }
+      double* cs = a.cs + 6 * series;
+      cs[0] = sq2 * std::cos(th);
+      cs[1] = std::cos(2.f * th) * 2.f;
+      cs[2] = sq2 * std::cos(3.f * th);
+      cs[3] = 3.f * sq2 * std::cos(5.f * th);
+      angles_.push_back(a);
+    }
+    const double* angle_terms(double th) const {
+      for (auto const& a : angles_) {
+        if (a.th == th)
+          return a.cs;
+      }
+      return nullptr;
+    }
+
+    // PTZY2 of  dr0 ,  th0 : CK = DR0 ** K * COS(K * TH0), K = 1, ..., nbess
+    void pipe(double dr0, double th0) {
+      if (pipe_terms(dr0, th0))
+        return;
+      Pipe p;
+      p.dr0 = dr0;
+      p.th0 = th0;
+      for (int k = 1; k <= nbess; ++k) {
+        double const ak = k;
+        p.ck[k - 1] = std::pow(dr0, k) * std::cos(ak * th0);
+      }
+      pipes_.push_back(p);
+    }
+    const double* pipe_terms(double dr0, double th0) const {
+      for (auto const& p : pipes_) {
+        if (p.dr0 == dr0 && p.th0 == th0)
+          return p.ck;
+      }
+      return nullptr;
+    }
+
+  private:
+    struct Angle {
+      double th;
+      double cs[6 * series + 4];
+    };
+    struct Pipe {
+      double dr0, th0;
+      double ck[nbess];
+    };
+    std::vector<Angle> angles_;
+    std::vector<Pipe> pipes_;
+  };
+
+  // The parts of the impedance matrix of ZYMX at  w , the leading  n x n
+  // of ZS, ZE, ZC, ZP and ZPC by columns
+  struct CableZ {
+    double w = 0.0;
+    std::size_t n = 0;
+    std::vector<std::complex<double>> zs, ze, zc, zp, zpc;
+
+    void resize(std::size_t nw) {
+      n = nw;
+      for (auto* z : { &zs, &ze, &zc, &zp, &zpc })
+        z->assign(n * n, std::complex<double>());
+    }
+  };
+
+  // The sweep of a CABLE CONSTANTS frequency card, evaluated a block of
+  // frequencies ahead on the step threads, like LineSweep of GUTS44. The
+  // frequencies of the block are evaluated by  evaluate(w, z) , which must
+  // read the data of the case only.
+  class CableSweep {
+  public:
+    static constexpr std::size_t window = 64;
+
+    // the time of a block of frequencies, the first and the last in Hz
+    struct Block {
+      double first, last;
+      std::size_t count;
+      double seconds;
+    };
+
+    void pool(StepPool* p) { pool_ = p; }
+
+    // the frequencies of the sweep from  freq , in the order of GUTS47:
+    // FDECAD * EXP(KKK * FACTOR), KKK = 0, ..., IPS - 1 of each decade,
+    // then the last FDECAD; W = FREQ * TWOPI
+    void plan(double freq, double factor, int ik, int ips, double twopi) {
+      clear();
+      double fdecad = freq;
+      for (int iii = 0; iii < ik; ++iii) {
+        freqs_.push_back(fdecad);
+        for (int kkk = 1; kkk < ips; ++kkk) {
+          double const pkkk = kkk;
+          freqs_.push_back(fdecad * std::exp(pkkk * factor));
+        }
+        fdecad = fdecad * 10.0f;
+      }
+      if (ik > 0)
+        freqs_.push_back(fdecad);
+      for (double const f : freqs_)
+        planned_.push_back(f * twopi);
+    }
+    // no sweep: the data of the case may change
+    void clear() {
+      freqs_.clear();
+      planned_.clear();
+      next_ = 0;
+      first_ = last_ = 0;
+    }
+
+    // the parts at  w , from the block of the sweep if  w  is one of its
+    // frequencies
+    template<class Evaluate>
+    const CableZ& z(double w, Evaluate fn) {
+      auto const t0 = std::chrono::steady_clock::now();
+      std::size_t const at = find(w);
+      const CableZ* result = &scratch_;
+      if (at < planned_.size()) {
+        if (at < first_ || at >= last_)
+          evaluate(at, fn);
+        result = &done_[at - first_];
+      }
+      else {
+        fn(w, scratch_);
+        ++matrices_;
+      }
+      std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+      seconds_ += dt.count();
+      return *result;
+    }
+
+    // the matrices evaluated, the seconds GUTS47 waited for them, and the
+    // blocks of the sweeps since reset()
+    std::int64_t matrices() const { return matrices_; }
+    double seconds() const { return seconds_; }
+    const std::vector<Block>& blocks() const { return blocks_; }
+    int threads() const { return pool_ ? pool_->size() : 1; }
+    void reset() {
+      clear();
+      blocks_.clear();
+      matrices_ = 0;
+      seconds_ = 0.0;
+    }
+
+  private:
+    // index of  w  in  planned_ , its size if none
+    std::size_t find(double w) {
+      for (std::size_t n = 0; n < planned_.size(); ++n) {
+        std::size_t const i = (next_ + n) % planned_.size();
+        if (planned_[i] == w) {
+          next_ = i + 1;
+          return i;
+        }
+      }
+      return planned_.size();
+    }
+    // the block of  planned_  from  at , frequency  c, c + n, ...  on step
+    // thread  c  of  n ; what a thread throws is thrown here
+    template<class Evaluate>
+    void evaluate(std::size_t at, Evaluate& fn) {
+      auto const t0 = std::chrono::steady_clock::now();
+      first_ = at;
+      last_ = std::min(at + window, planned_.size());
+      done_.resize(last_ - first_);
+      std::size_t const nthread = std::size_t(threads());
+      std::vector<std::exception_ptr> thrown(nthread);
+      auto chunk = [&](int c) {
+        try {
+          for (std::size_t i = first_ + std::size_t(c); i < last_; i += nthread)
+            fn(planned_[i], done_[i - first_]);
+        }
+        catch (...) {
+          thrown[std::size_t(c)] = std::current_exception();
+        }
+      };
+      if (pool_)
+        pool_->run(chunk);
+      else
+        chunk(0);
+      for (auto const& e : thrown) {
+        if (e) {
+          first_ = last_ = 0;
+          std::rethrow_exception(e);
+        }
+      }
+      matrices_ += std::int64_t(last_ - first_);
+      std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+      blocks_.push_back({ freqs_[first_], freqs_[last_ - 1],
+        last_ - first_, dt.count() });
+    }
+
+    StepPool* pool_ = nullptr;
+    std::vector<double> freqs_;        // FREQ of the sweep
+    std::vector<double> planned_;      // and its W
+    std::size_t next_ = 0;             // where to look first for a frequency
+    std::vector<CableZ> done_;         // planned_[first_ : last_ - 1]
+    std::size_t first_ = 0, last_ = 0;
+    CableZ scratch_;
+    std::vector<Block> blocks_;
+    std::int64_t matrices_ = 0;
+    double seconds_ = 0.0;
+  };
+
+}
@@ -0,0 +1,150 @@
+/***********************************
+EMTP C++
+Card reader of the input data deck: the file is mapped once and handed out
+as 80-column card views into the mapping.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EMTP_DECK_MMAP 1
+#endif
+
+namespace emtp {
+
+  // The deck is memory-mapped where the platform has mmap, otherwise read
+  // with a single read into one buffer; either way a card is a view into
+  // that storage, so reading a card costs a scan for its line end and no
+  // copy. The number of cards is not limited.
+  class DeckReader {
+  public:
+    static constexpr std::size_t card_width = 80;
+
+    DeckReader() = default;
+    DeckReader(const DeckReader&) = delete;
+    DeckReader& operator=(const DeckReader&) = delete;
+    ~DeckReader() { close(); }
+
+    bool open(const std::string& file) {
+      close();
+#ifdef EMTP_DECK_MMAP
+      int const fd = ::open(file.c_str(), O_RDONLY);
+      if (fd < 0)
+        return false;
+      struct stat st;
+      if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* p = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+          ::madvise(p, std::size_t(st.st_size), MADV_SEQUENTIAL);
+          map_ = p;
+          data_ = static_cast<const char*>(p);
+          size_ = std::size_t(st.st_size);
+        }
+      }
+      ::close(fd);
+      if (map_)
+        return open_ = true;
+#endif
+      std::ifstream in(file, std::ios::binary | std::ios::ate);
+      if (!in.is_open())
+        return false;
+      buffer_.resize(std::size_t(in.tellg()));
+      in.seekg(0);
+      if (!buffer_.empty() && !in.read(&buffer_[0], buffer_.size()))
+        return false;
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+      return open_ = true;
+    }
+    void close() {
+#ifdef EMTP_DECK_MMAP
+      if (map_)
+        ::munmap(map_, size_);
+      map_ = nullptr;
+#endif
+      buffer_.clear();
+      buffer_.shrink_to_fit();
+      data_ = nullptr;
+      size_ = pos_ = 0;
+      open_ = false;
+    }
+    bool is_open() const { return open_; }
+    void rewind() { pos_ = 0; }
+    // bytes of the deck, and bytes scanned so far
+    std::size_t bytes() const { return size_; }
+    std::size_t position() const { return pos_; }
+    // FNV-1a of the bytes of the deck, which a snapshot is taken against
+    std::uint64_t hash() const {
+      std::uint64_t h = 14695981039346656037ull;
+      for (std::size_t i = 0; i < size_; ++i)
+        h = (h ^ std::uint8_t(data_[i])) * 1099511628211ull;
+      return h;
+    }
+
+    // Next card image: at most 80 columns, without the line end, a "//"
+    // remark and trailing blanks. Blank lines and "C " comment cards are
+    // skipped. False at the end of the deck.
+    bool next(std::string_view& card) {
+      while (pos_ < size_) {
+        std::string_view line = next_line();
+        if (auto const pos = line.find("//"); pos != std::string_view::npos)
+          line = line.substr(0, pos);
+        line = line.substr(0, line.find_last_not_of(' ') + 1);
+        if (line.empty())
+          continue;
+        line = line.substr(0, card_width);
+        if (line[0] == 'C' && (line.size() == 1 || line[1] == ' '))
+          continue;
+        card = line;
+        return true;
+      }
+      return false;
+    }
+
+    // number of cards of the deck of  file  (0 if it cannot be read)
+    static long count_cards(const std::string& file) {
+      DeckReader deck;
+      long n = 0;
+      if (deck.open(file)) {
+        for (std::string_view card; deck.next(card); )
+          ++n;
+      }
+      return n;
+    }
+
+  private:
+    std::string_view next_line() {
+      std::string_view rest(data_ + pos_, size_ - pos_);
+      auto end = rest.find('\n');
+      if (end == std::string_view::npos)
+        end = rest.size();
+      pos_ += end + 1;
+      auto line = rest.substr(0, end);
+      if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+      return line;
+    }
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+    bool open_ = false;
+    std::string buffer_;  // deck without mapping
+#ifdef EMTP_DECK_MMAP
+    void* map_ = nullptr;
+#endif
+  };
+
+}
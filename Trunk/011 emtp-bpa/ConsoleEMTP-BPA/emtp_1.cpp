@@ -229,6 +229,16 @@ void dimens(
 {
   lsize(dimension(62));
   int n7 = fem::int0;
+  //  LIST SIZES OF 90 OR MORE CELLS GROW WITH  TABLE_SCALE(),  JUST AS
+  //  THE COMMON ARRAYS BEHIND THEM DO.  SMALLER ENTRIES ARE CODES OR FIXED
+  //  TABLES; OVERLAYS 39-47 DIMENSION LOCAL ARRAYS AND ARE NOT SCALED.
+  auto scale = [&lsize](int n) {
+    for (int j = 1; j <= n; ++j) {
+      if (lsize(j) >= 90) {
+        lsize(j) = tabsiz(lsize(j));
+      }
+    }
+  };
   //C!IMPLICIT REAL*8 (A-H, O-Z)
   if (nchain >= 29) {
     goto statement_2900;
@@ -263,6 +273,7 @@ void dimens(
   lsize(28) = 1080;
   n7 = 28 + 1;
   lsize(n7) = 1842869;
+  scale(n7);
 
   //bus1 = "91205";
   //bus2 = "123093";
@@ -279,6 +290,7 @@ void dimens(
   lsize(6) = 3002;
   lsize(7) = 9;
   lsize(8) = 300;
+  scale(8);
   return;
   statement_3100:
   if (nchain > 31) {
@@ -286,6 +298,7 @@ void dimens(
   }
   lsize(1) = 9;
   lsize(2) = 300;
+  scale(2);
   return;
   statement_3900:
   if (nchain > 39) {
@@ -1987,11 +2000,12 @@ void namea6(
   if (maxbus <= 0) {
     goto statement_3423;
   }
-  FEM_DO_SAFE(j, 1, maxbus) {
-    if (text1 == texvec(j)) {
-      goto statement_3446;
-    }
+  //  THE FIRST CELL OF TEXT1, FROM THE INDEX OF THE NAMES (node_names.h)
+  j = cmn.texvec_names.first(texvec, maxbus, text1);
+  if (j != 0) {
+    goto statement_3446;
   }
+  j = maxbus + 1;
   statement_3423:
   if (n24 != 0) {
     goto statement_3438;
@@ -2000,6 +2014,7 @@ void namea6(
     goto statement_3434;
   }
   texvec(n17) = text1;
+  cmn.texvec_names.invalidate();
   n24 = n17;
   FEM_DO_SAFE(j, 1, maxbus) {
     if (texvec(j) != text2) {
@@ -2037,6 +2052,7 @@ void namea6(
   goto statement_9000;
   statement_3455:
   texvec(j) = text2;
+  cmn.texvec_names.invalidate();
   n17 = j;
   statement_9000:
   if (iprsup >= 6) {
@@ -5500,19 +5516,19 @@ void tacs1b(
       wloop, texvec(i);
     }
 
-    cmn.out_stream << getCurrentDateTime() << '\n';
-    cmn.out_stream << "Time";
+    cmn.plot.start(getCurrentDateTime(), false);
+    cmn.plot.column("Time");
     //for (int i = 1; i <= maxbus; ++i)
-    //  cmn.out_stream << ',' << texvec(i)(1,6).std_str();
+    //  cmn.plot.column(texvec(i)(1,6).std_str());
     n2 = kcolcs + 1;
     n3 = kcolcs + ioutcs;
     for (auto i = n2; i <= n3; ++i) {
       n1 = n1 + 1;
       j = cmn.tacsar.jout(kjout + n1);
       auto idx = cmn.tacsar.ilntab(klntab + j);
-      cmn.out_stream << ',' << texvec(idx)(1, 6).std_str();
+      cmn.plot.column(texvec(idx)(1, 6).std_str());
     }
-    cmn.out_stream << '\n';
+    cmn.plot.end_header();
   }
   n2 = kcolcs + 1;
   n3 = kcolcs + ioutcs;
@@ -5712,6 +5728,8 @@ void tacs1(
   ndy5 = kud1 + (niu - 12) * 5;
   goto statement_2210;
   statement_1001:
+  //  A NEW TACS DATA CASE: NOTHING OF THE CODE OF CSUP IS KEPT
+  cmn.tacs_code.clear();
   krsblk = 30;
   kud1 = krsblk + lstat(61) * 4;
   kprsup = kud1 + lstat(64) * 5;
@@ -6542,6 +6560,161 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+// division of CSUP (S.N. 500): zero and the infinity of FLTINF where the
+// exponents of  D7  and  D8  are more than  LIMIT = IVARB(KIUTY + 11)
+// apart
+static double
+csup_divide(
+  common& cmn,
+  double const& d7,
+  double const& d8,
+  int const& limit)
+{
+  if (d7 == 0.0f) {
+    return 0.0f;
+  }
+  int n = 0;
+  if (d8 != 0.0f) {
+    n = alog1z(std::abs(d7)) - alog1z(std::abs(d8));
+    if (n < -limit) {
+      return 0.0f;
+    }
+    if (n <= limit) {
+      return d7 / d8;
+    }
+  }
+  double div = cmn.fltinf;
+  if (d7 < 0.0f) {
+    div = -div;
+  }
+  if (d8 < 0.0f) {
+    div = -div;
+  }
+  return div;
+}
+
+// function  M  (11 to 34) of CSUP (S.N. 111 - 134) of argument  B
+static double
+csup_function(
+  common& cmn,
+  int const& m,
+  double b,
+  int const& limit)
+{
+  int n5 = fem::int0;
+  int n6 = fem::int0;
+  int n7 = fem::int0;
+  switch (m) {
+    case 11: return sinz(b);
+    case 12: return cosz(b);
+    case 13: return std::tan(b);
+    case 14: return cotanz(b);
+    case 15: return sinhz(b);
+    case 16: return std::cosh(b);
+    case 17: return std::tanh(b);
+    case 18: return std::asin(b);
+    case 19: return acosz(b);
+    case 20: return std::atan(b);
+    case 21: return expz(b);
+    case 22: return alogz(b);
+    case 23: return alog1z(b);
+    case 24: return sqrtz(b);
+    case 25: return std::abs(b);
+    case 26: return std::floor(b);
+    case 27: return -b;
+    case 28: return csup_divide(cmn, 1.0f, b, limit);
+    case 29: return b * cmn.twopi / 360.0f;
+    case 30: return b / cmn.twopi * 360.0f;
+    case 31:
+      n5 = b;
+      n6 = n5 / 6;
+      if (n5 < 0) {
+        n5 += 6 * (n6 + 1);
+      }
+      n7 = n5 - 6 * n6;
+      if (n7 == 0) {
+        n7 = 6;
+      }
+      return n7;
+    case 32: return b < 0.0f ? -1.0f : 1.0f;
+    case 33: return b > 10.0f * cmn.flzero ? 0.0f : 1.0f;
+    default: return randnm(cmn, 0.0);
+  }
+}
+
+// supplemental variable  I  of CSUP translated from its cells  N1  to  N2
+// of IVARB (tacs_bytecode.h); CSUP interprets it if  CODE.OK  is false
+static void
+csup_compile(
+  common& cmn,
+  TacsCode& code,
+  int const& n1,
+  int const& n2)
+{
+  auto& ivarb = cmn.isptacs;
+  auto& sptacs = cmn.sptacs;
+  int const kxtcs = cmn.tacsar.kxtcs;
+  int const kprsup = cmn.tacsar.kprsup;
+  int const limit = ivarb(cmn.tacsar.kiuty + 11);
+  std::vector<TacsElement> e;
+  int j = fem::int0;
+  FEM_DOSTEP(j, n1, std::abs(n2), 3) {
+    e.push_back({ ivarb(j + 1), ivarb(j + 2), ivarb(j + 3) });
+  }
+  auto constant = [&](int i2) { return double(sptacs(kprsup + i2)); };
+  auto fold = [&](int m, double b) { return csup_function(cmn, m, b, limit); };
+  if (n2 < 0) {
+    compile_expression(e, kxtcs, constant, fold, code);
+  }
+  else {
+    compile_variable(e, kxtcs, constant, fold, code);
+  }
+}
+
+// one run of the code of a supplemental variable; its value, and B of
+// CSUP set as the interpretation leaves it
+static double
+csup_run(
+  common& cmn,
+  TacsCode& code,
+  double& b)
+{
+  auto& sptacs = cmn.sptacs;
+  double const zfl = 10.0f * cmn.flzero;
+  int const limit = cmn.isptacs(cmn.tacsar.kiuty + 11);
+  double* const r = code.regs.data();
+  for (auto const& o : code.ops) {
+    switch (o.code) {
+      case TacsOp::load: r[o.d] = sptacs(o.a); break;
+      case TacsOp::add: r[o.d] = r[o.a] + r[o.b]; break;
+      case TacsOp::sub: r[o.d] = r[o.a] - r[o.b]; break;
+      case TacsOp::mul: r[o.d] = r[o.a] * r[o.b]; break;
+      case TacsOp::divide: r[o.d] = csup_divide(cmn, r[o.a], r[o.b], limit); break;
+      case TacsOp::power: r[o.d] = fem::pow(r[o.a], r[o.b]); break;
+      case TacsOp::negate: r[o.d] = -r[o.a]; break;
+      case TacsOp::function: r[o.d] = csup_function(cmn, o.fn, r[o.a], limit); break;
+      case TacsOp::not_: r[o.d] = r[o.a] > zfl ? 0.0f : 1.0f; break;
+      case TacsOp::and_: r[o.d] = r[o.a] > zfl && r[o.b] > zfl ? 1.0f : 0.0f; break;
+      case TacsOp::or_: r[o.d] = r[o.a] > zfl || r[o.b] > zfl ? 1.0f : 0.0f; break;
+      case TacsOp::eq: r[o.d] = r[o.b] == r[o.a] ? 1.0f : 0.0f; break;
+      case TacsOp::ne: r[o.d] = r[o.b] != r[o.a] ? 1.0f : 0.0f; break;
+      case TacsOp::lt: r[o.d] = r[o.b] < r[o.a] ? 1.0f : 0.0f; break;
+      case TacsOp::le: r[o.d] = r[o.b] <= r[o.a] ? 1.0f : 0.0f; break;
+      case TacsOp::ge: r[o.d] = r[o.b] >= r[o.a] ? 1.0f : 0.0f; break;
+      case TacsOp::gt: r[o.d] = r[o.b] > r[o.a] ? 1.0f : 0.0f; break;
+      case TacsOp::and1: r[o.d] = r[o.a] >= 1.0f && r[o.b] >= 1.0f ? 1.0f : 0.0f; break;
+      case TacsOp::or1: r[o.d] = r[o.a] >= 1.0f || r[o.b] >= 1.0f ? 1.0f : 0.0f; break;
+      case TacsOp::not1: r[o.d] = r[o.b] < 1.0f ? 1.0f : 0.0f; break;
+      case TacsOp::nand1: r[o.d] = r[o.a] >= 1.0f && r[o.b] >= 1.0f ? 0.0f : 1.0f; break;
+      case TacsOp::nor1: r[o.d] = r[o.a] < 1.0f && r[o.b] < 1.0f ? 1.0f : 0.0f; break;
+    }
+  }
+  if (code.last_b >= 0) {
+    b = r[code.last_b];
+  }
+  return r[code.result];
+}
+
 
 
 void csup(
@@ -6692,6 +6865,8 @@ void csup(
     }
   }
   statement_1000:
+  auto const t0 = cmn.tacs_code.timed() ? std::chrono::steady_clock::now() :
+    std::chrono::steady_clock::time_point();
   nnn = kxtcs + nuk + lstat(64);
   i = L;
   statement_1234:
@@ -6701,6 +6876,17 @@ void csup(
   if (n1 < 0) {
     goto statement_600;
   }
+  //  VARIABLE TRANSLATED BY ITS FIRST PASS, SEE TACS_BYTECODE.H
+  if (cmn.tacs_code.enabled()) {
+    auto& code = cmn.tacs_code.slot(i, n1, n2);
+    if (!code.tried) {
+      csup_compile(cmn, code, n1, n2);
+    }
+    if (code.ok) {
+      a = csup_run(cmn, code, b);
+      goto statement_11;
+    }
+  }
   if (n2 < 0) {
     goto statement_5000;
   }
@@ -6971,9 +7157,9 @@ void csup(
   div = 0.0f;
   statement_530:
   switch (idiv) {
-    case 1: goto statement_7128;
-    case 2: goto statement_7204;
-    case 3: goto statement_6120;
+    case 7128: goto statement_7128;
+    case 7204: goto statement_7204;
+    case 6120: goto statement_6120;
     default: break;
   }
   //C     ------  FREE-FORMAT FORTRAN EXPRESSION  ------                    M28. 371
@@ -7855,6 +8041,13 @@ void csup(
   if (i > 0) {
     goto statement_1234;
   }
+  if (cmn.tacs_code.timed()) {
+    std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+    cmn.tacs_code.count(dt.count());
+  }
+  else {
+    cmn.tacs_code.count(0.0);
+  }
 }
 catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
@@ -15462,7 +15655,7 @@ void pltvar(
   fem::str<80>& buff77 = cmn.buff77;
   fem::str<80>& prom80 = cmn.prom80;
   fem::str<132>& munit6 = cmn.munit6;
-  arr_cref<double> bbus(cmn.bbus, dimension(300));
+  arr_cref<double> bbus(cmn.bbus, dimension(tabsiz(300)));
   double& tmult = cmn.tmult;
   arr_ref<int> mplot(cmn.mplot, dimension(20));
   int& jplt = cmn.jplt;
@@ -21029,6 +21222,7 @@ struct datain_save
   arr<int> lentyp;
   int nchpre;
   int nchsuf;
+  int numhld;
   int numtyp;
   arr<fem::str<12> > typdat;
 
@@ -21039,6 +21233,7 @@ struct datain_save
     lentyp(dimension(18), fem::fill0),
     nchpre(fem::int0),
     nchsuf(fem::int0),
+    numhld(fem::int0),
     numtyp(fem::int0),
     typdat(dimension(18), fem::fill0)
   {}
@@ -21046,7 +21241,6 @@ struct datain_save
 
 bool data_input(common& cmn) try {
   common_write write(cmn);
-  auto& buff77 = cmn.buff77;
   auto& file6 = cmn.file6;
 
   cmn.iprspy = 0;
@@ -21054,23 +21248,28 @@ bool data_input(common& cmn) try {
   cmn.iprsov(1) = 0;  // EMTP DIAGNOSTIC ONLY THRU 1ST OVERLAY
   cmn.m4plot = 2;
 
-  std::string sLine;
-  for (int j = 0; std::getline(cmn.inp_stream, sLine); ) {
-    if (auto pos = sLine.find("//"); pos != std::string::npos) 
-      sLine = sLine.substr(0, pos);  // skip comment "//" 
-    sLine = trim_right(sLine);
-    if (sLine.empty()) continue;
-    sLine.resize(80, ' ');
-    if (sLine.substr(0, 2) == "C ") continue;
-    if (1000 < ++j) {
+  // cards are views into the mapped deck; FILE6 (LIMCRD cards, sized with
+  // the EMTP lists) takes the only copy of them
+  auto& deck = cmn.inp_deck;
+  auto const t0 = std::chrono::steady_clock::now();
+  std::string_view card;
+  int j = 0;
+  while (deck.next(card)) {
+    if (cmn.limcrd < ++j) {
       write(cmn.lunit6, "(1x,a30)"), " Input data cards overflow !";
-      //cmn.log_stream << " Input data cards overflow !\n";
       return false;
     }
-    file6(j) = sLine;
+    file6(j) = fem::str_cref(card.data(), int(card.size()));
     cmn.numcrd = j;
     if (file6(j)(1, 4) == "EOF ") break;
   }
+  std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+  double const sec = std::max(dt.count(), 1.e-9);
+  write(cmn.lunit6,
+    "(' INPUT DECK OF',i9,' CARDS (',i11,' BYTES) READ IN',f10.6,' SEC.',"
+    "f13.0,' CARDS/SEC.',f9.1,' MB/SEC.')"),
+    j, int(std::min(deck.position(), deck.bytes())), sec, j / sec,
+    std::min(deck.position(), deck.bytes()) / sec / 1.e6;
   return true;
 }
 catch (...) {
@@ -21236,7 +21435,7 @@ void datain(
   //C for LMFS
   //C INIT. NUMRUN for LMFS runs
 
-  static int numhld = fem::int0;
+  int& numhld = sve.numhld;
 
   if (kexact != 88333) {
     numrun = 0;
@@ -21295,8 +21494,8 @@ void datain(
   numdcd = 0;
   //C I/O CHANNEL FOR "EMTSPY" INPUT (KEYBOARD)
   munit5 = 5;
-  //C PRESENT FIXED LIMIT ON FILE6 OF "DEKSPY"
-  limcrd = 30000;
+  //C PRESENT LIMIT ON FILE6 OF "DEKSPY" (GROWS WITH THE EMTP LISTS)
+  limcrd = int(file6.size_1d());
   //C INITIALLY ASSUME NO DEBUG PRINTOUT
   n13 = 0;
   //C OLD TACS DATA FORMAT
@@ -23776,6 +23975,55 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+// element reduction of one column of DGELG: COL(R) += -MUL(R) * AKC,
+// four rows per step. Returns the greatest ABS(COL(R)); CHK comes out a
+// NAN if there was a NAN or an infinity among them.
+static double dgelg_reduce(double* __restrict col, const double* __restrict mul,
+  double akc, int n, double& chk)
+{
+  double m0 = 0.0, m1 = 0.0, m2 = 0.0, m3 = 0.0;
+  double c0 = 0.0, c1 = 0.0, c2 = 0.0, c3 = 0.0;
+  int r = 0;
+  for (; r + 4 <= n; r += 4) {
+    double const t0 = std::abs(col[r] += -mul[r] * akc);
+    double const t1 = std::abs(col[r + 1] += -mul[r + 1] * akc);
+    double const t2 = std::abs(col[r + 2] += -mul[r + 2] * akc);
+    double const t3 = std::abs(col[r + 3] += -mul[r + 3] * akc);
+    m0 = t0 > m0 ? t0 : m0;
+    m1 = t1 > m1 ? t1 : m1;
+    m2 = t2 > m2 ? t2 : m2;
+    m3 = t3 > m3 ? t3 : m3;
+    c0 += t0 * 0.0;
+    c1 += t1 * 0.0;
+    c2 += t2 * 0.0;
+    c3 += t3 * 0.0;
+  }
+  for (; r < n; ++r) {
+    double const t0 = std::abs(col[r] += -mul[r] * akc);
+    m0 = t0 > m0 ? t0 : m0;
+    c0 += t0 * 0.0;
+  }
+  chk = c0 + c1 + c2 + c3;
+  m0 = m1 > m0 ? m1 : m0;
+  m2 = m3 > m2 ? m3 : m2;
+  return m2 > m0 ? m2 : m0;
+}
+
+// X(R) += -MUL(R) * V, four rows per step
+static void dgelg_update(double* __restrict x, const double* __restrict mul,
+  double v, int n)
+{
+  int r = 0;
+  for (; r + 4 <= n; r += 4) {
+    x[r] += -mul[r] * v;
+    x[r + 1] += -mul[r + 1] * v;
+    x[r + 2] += -mul[r + 2] * v;
+    x[r + 3] += -mul[r + 3] * v;
+  }
+  for (; r < n; ++r)
+    x[r] += -mul[r] * v;
+}
+
 void dgelg(
   arr_ref<double> r,
   arr_ref<double> a,
@@ -23916,25 +24164,48 @@ void dgelg(
     //C     ELEMENT REDUCTION AND NEXT PIVOT SEARCH                           M35. 384
     piv = 0.0f;
     lst++;
-    j = 0;
-    FEM_DO_SAFE(ii, lst, lend) {
-      pivi = -a(ii);
-      ist = ii + m;
-      j++;
-      FEM_DOSTEP(L, ist, mm, m) {
-        ll = L - j;
-        a(L) += pivi * a(ll);
-        tb = std::abs(a(L));
-        if (tb <= piv) {
-          goto statement_15;
+    //C     (C++) THE REDUCTION OF THE FORTRAN LOOP BY ROWS IS DONE COLUMN BY
+    //C     COLUMN, CONTIGUOUS IN STORAGE, TO THE SAME BITS. OF EQUAL ELEMENTS
+    //C     THE SEARCH KEEPS THE ONE FIRST IN ROW ORDER, AS THE LOOP DID; IT IS
+    //C     DONE AGAIN IN ROW ORDER IF A NAN OR AN INFINITY IS MET.
+    {
+      double* const ap = &a(1) - 1;
+      double* const rp = &r(1) - 1;
+      int const nr = lend - lst + 1;
+      int row = nr;
+      double chk = 0.0;
+      bool nan = false;
+      for (ist = lst + m; ist <= mm; ist += m) {
+        tb = dgelg_reduce(ap + ist, ap + lst, ap[ist - 1], nr, chk);
+        if (chk != chk) {
+          nan = true;
+        }
+        if (tb < piv || tb <= 0.0 || (tb == piv && row == 0)) {
+          continue;
+        }
+        for (j = 0; std::abs(ap[ist + j]) != tb; ++j) {
+        }
+        if (tb > piv || j < row) {
+          piv = tb;
+          i = ist + j;
+          row = j;
+        }
+      }
+      if (nan) {
+        piv = 0.0f;
+        FEM_DO_SAFE(ii, lst, lend) {
+          FEM_DOSTEP(L, ii + m, mm, m) {
+            tb = std::abs(a(L));
+            if (tb <= piv) {
+              continue;
+            }
+            piv = tb;
+            i = L;
+          }
         }
-        piv = tb;
-        i = L;
-        statement_15:;
       }
       FEM_DOSTEP(L, k, nm, m) {
-        ll = L + j;
-        r(ll) += pivi * r(L);
+        dgelg_update(rp + L + 1, ap + lst, rp[L], nr);
       }
     }
     lst += m;
@@ -23980,8 +24251,9 @@ catch (...) {
 }
 
 
+template <typename Cmn>
 void cominv(
-  common& cmn,
+  Cmn& cmn,
   arr_cref<double> a,
   arr_ref<double> b,
   int const& m,
@@ -24101,6 +24373,9 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+template void cominv(common&, arr_cref<double>, arr_ref<double>, int const&,
+  double const&);
+
 
 void last14(
   common& cmn) try
@@ -26706,9 +26981,9 @@ void innr29(
   FEM_CMN_SVE(innr29);
   array(dimension(1));
   ibsout(dimension(1));
-  kount(dimension(1));
-  kpoint(dimension(1));
-  nsum(dimension(1));
+  kount(dimension(cmn.liminc));  // cleared by MOVE0, which honours the size
+  kpoint(dimension(cmn.liminc));
+  nsum(dimension(cmn.liminc));
   bus(dimension(1));
   kmswit(dimension(1));
   kdepsw(dimension(1));
@@ -27560,8 +27835,9 @@ void innr29(
       goto statement_6543;
     }
     dex = totmax / ainsav + 1.0f;
-    index = dex;
-    if (index <= liminc) {
+    //  DEX IS TESTED BEFORE  INDEX = DEX ,  AS A ZERO  BASEV  MAKES IT INFINITE
+    if (dex < liminc + 1) {
+      index = dex;
       goto statement_6020;
     }
     write(lunit6, format_3);
@@ -29510,7 +29786,6 @@ void guts29(
   int n8 = fem::int0;
   int lspars = fem::int0;
   int n4 = fem::int0;
-  arr_1d<1, double> array(fem::fill0);
   int nstat = fem::int0;
   int n6 = fem::int0;
   arr_1d<20, int> lltemp(fem::fill0);
@@ -29547,6 +29822,9 @@ void guts29(
   int iofnsu = fem::int0;
   static const char* format_6249 = "('+FILE NAMES.',9i4)";
   //C!EQUIVALENCE ( ARRAY(1), KARRAY(1) )
+  auto& array = cmn.farray;
+  // an ARRAY cell spans two KARRAY words, whatever NBYTE says
+  int const nwd = sizeof(double) / sizeof(int);
   //C!EQUIVALENCE  (MONCAR(1),    KNT),   (MONCAR(2),  KBASE)
   //C!EQUIVALENCE  (MONCAR(5),  IDIST),   (MONCAR(6),  ITEST)
   //C!EQUIVALENCE  (MONCAR(9), KLOAEP)
@@ -29561,7 +29839,7 @@ void guts29(
       "(' TOP OF \"GUTS29\".  IOFBND, KBURRO, ISTEP =',3i8)"),
       iofbnd, cmn.kburro, istep;
   }
-  n18 = maxo29 * nbyte(4) / nbyte(3) - iofarr;
+  n18 = maxo29 / nwd - iofarr;
   if (istep !=  - 6633) {
     goto statement_5627;
   }
@@ -29594,7 +29872,7 @@ void guts29(
   iofrhs = iofsol + n3;
   iofmat = iofrhs + n3;
   iofksp = iofmat + 2 * n3;
-  iofksp = iofksp * nbyte(4) / nbyte(3) + 1;
+  iofksp = iofksp * nwd + 1;
   n8 = iofksp + n7;
   lspars = 1;
   if (n8 < loopss(2)) {
@@ -30027,7 +30305,7 @@ void guts29(
   xmaxmx = 5.0f * xmaxmx;
   liminc = xmaxmx / aincr + 1.0f;
   statement_6399:
-  iofibs = (iofarr + narray) * nbyte(3) / nbyte(4);
+  iofibs = (iofarr + narray) * nwd;
   iofkou = iofibs + numnvo + nc + nc;
   iofpnt = iofkou + liminc;
   iofnsu = iofpnt + liminc;
@@ -30110,9 +30388,11 @@ void subr29(
   int ioftcl = fem::int0;
   int ioftop = fem::int0;
   int n9 = fem::int0;
-  arr_1d<1, fem::str<8> > text(fem::fill0);
-  arr_1d<1, double> array(fem::fill0);
   //C!w EQUIVALENCE  ( KARRAY(1), TEXT(1), ARRAY(1) )
+  auto text = ArraySpan(reinterpret_cast<fem::str<8>*>(karray.begin()), karray.size() / 2);
+  auto& array = cmn.farray;
+  // a TEXT or ARRAY cell spans two KARRAY words, whatever NBYTE says
+  int const nwd = sizeof(double) / sizeof(int);
   if (iprsup >= 1) {
     write(lunit6,
       "(' AT TOP OF \"SUBR29\".  LSWTCH, LSIZ12, LBUS =',3i8)"),
@@ -30134,16 +30414,16 @@ void subr29(
   stoptp(cmn);
   statement_2368:
   iofbus = 1;
-  iofkms = (iofbus + 2 * lbus) * nbyte(1) / nbyte(4);
+  iofkms = (iofbus + 2 * lbus) * nwd;
   iofkde = iofkms + 2 * lswtch;
   iofibr = iofkde + lswtch;
   iofjbr = iofibr + lsiz12;
-  iofake = (iofjbr + lsiz12) * nbyte(4) / nbyte(3) + 1;
+  iofake = (iofjbr + lsiz12) / nwd + 1;
   ioftst = iofake + lswtch;
   ioftcl = ioftst + lswtch;
   ioftop = ioftcl + lswtch;
   iofarr = ioftop + 2 * lswtch;
-  n9 = iofarr * nbyte(3) / nbyte(4);
+  n9 = iofarr * nwd;
   if (iprsup >= 2) {
     {
       write_loop wloop(cmn, lunit6,
@@ -39073,9 +39353,10 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+template <typename Cmn>
 void
 comhes(
-  common& cmn,
+  Cmn& cmn,
   int const& /* nm */,
   int const& n,
   int const& low,
@@ -39263,9 +39544,10 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+template <typename Cmn>
 void
 comlr(
-  common& cmn,
+  Cmn& cmn,
   int const& /* nm */,
   int const& n,
   int const& low,
@@ -39552,9 +39834,10 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+template <typename Cmn>
 void
 comlr2(
-  common& cmn,
+  Cmn& cmn,
   int const& /* nm */,
   int const& n,
   int const& low,
@@ -40149,9 +40432,10 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+template <typename Cmn>
 void
 dceign(
-  common& cmn,
+  Cmn& cmn,
   arr_ref<double, 2> ar,
   arr_ref<double, 2> ai,
   arr_ref<double, 2> vi,
@@ -40321,9 +40605,10 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+template <typename Cmn>
 void
 redu44(
-  common& cmn,
+  Cmn& cmn,
   arr_ref<double> a,
   arr_ref<double> b,
   int const& n,
@@ -40953,6 +41238,73 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+//  THE FIRST  N5  CARDS OF THE CASE ON LUNIT2 AS COMMENTS OF THE PUNCH
+void
+punch_cards44(
+  common& cmn,
+  int const& n5) try
+{
+  common_read read(cmn);
+  common_write write(cmn);
+  auto& texta6 = cmn.texta6;
+  int n12 = fem::int0;
+  int i = fem::int0;
+  cmn.io.rewind(cmn.lunit2);
+  FEM_DO_SAFE(n12, 1, n5) {
+    try {
+      read_loop rloop(cmn, cmn.lunit2, "(13a6,a2)");
+      FEM_DO_SAFE(i, 1, 14) {
+        rloop, texta6(i);
+      }
+    }
+    catch (fem::read_end const&) {
+      return;
+    }
+    {
+      write_loop wloop(cmn, cmn.lunit7, "('C ',13a6)");
+      FEM_DO_SAFE(i, 1, 13) {
+        wloop, texta6(i);
+      }
+    }
+  }
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
+//  ON A STEP THREAD (SEE LINE_FREQUENCY44): LUNIT2 IS READ BY GUTS44, WHICH
+//  PUTS THE CARDS AT THIS POINT OF THE PUNCH
+void
+punch_cards44(
+  LineCommon& cmn,
+  int const& n5)
+{
+  cmn.cards_at = cmn.punch.size();
+  cmn.cards = n5;
+}
+
+//  NOT REACHED ON A STEP THREAD: ITRNSF = -1 AND LASTOV .NE. 1 ARE LEFT TO
+//  GUTS44
+void
+cimage(
+  LineCommon&)
+{
+  throw std::logic_error("cimage() on a LINE CONSTANTS step thread");
+}
+
+void
+unwind(
+  LineCommon&,
+  arr_ref<double>,
+  int const&,
+  int&,
+  int const&,
+  int const&,
+  arr_ref<int>)
+{
+  throw std::logic_error("unwind() on a LINE CONSTANTS step thread");
+}
+
 struct modal_save
 {
   arr<int> iseq;
@@ -40980,9 +41332,10 @@ struct modal_save
   {}
 };
 
+template <typename Cmn>
 void
 modal(
-  common& cmn,
+  Cmn& cmn,
   arr_cref<double> /* array */,
   arr_ref<double> xwc,
   arr_ref<double> xwy,
@@ -41037,15 +41390,12 @@ modal(
   dummr(dimension(ndim));
   tixf(dimension(nsqr2));
   work1(dimension(nsqr2));
-  common_read read(cmn);
   common_write write(cmn);
-  auto& texta6 = cmn.texta6;
   const auto& date1= cmn.date1;
   const auto& tclock= cmn.tclock;
   const auto& abuff = cmn.abuff;
   auto& twopi = cmn.twopi;
   double& onehaf = cmn.onehaf;
-  auto& lunit2 = cmn.lunit2;
   auto& lunit7 = cmn.lunit7;
   auto& lunit9 = cmn.lunit9;
   auto& lstat = cmn.lstat;
@@ -41120,7 +41470,6 @@ modal(
   double fnorm = fem::double0;
   double theta = fem::double0;
   int n5 = fem::int0;
-  int n12 = fem::int0;
   double b = fem::double0;
   double g = fem::double0;
   int ig = fem::int0;
@@ -41639,26 +41988,8 @@ modal(
     "('C  ***** UNTRANSPOSED K.C. LEE LINE SEGMENT CALCULATED AT',2x,e10.3,"
     "' HZ. *****')"),
     freq;
-  cmn.io.rewind(lunit2);
   n5 = kfull + nfreq + 1;
-  FEM_DO_SAFE(n12, 1, n5) {
-    try {
-      read_loop rloop(cmn, lunit2, "(13a6,a2)");
-      FEM_DO_SAFE(i, 1, 14) {
-        rloop, texta6(i);
-      }
-    }
-    catch (fem::read_end const&) {
-      goto statement_8775;
-    }
-    {
-      write_loop wloop(cmn, lunit7, "('C ',13a6)");
-      FEM_DO_SAFE(i, 1, 13) {
-        wloop, texta6(i);
-      }
-    }
-  }
-  statement_8775:
+  punch_cards44(cmn, n5);
   write(lunit7, "('$VINTAGE, 1')");
   //C ****** TO GET MODAL Y *********                                       M43.3837
   statement_2520:
@@ -42136,9 +42467,10 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+template <typename Cmn>
 void
 symm(
-  common& cmn,
+  Cmn& cmn,
   arr_ref<double> p,
   arr_ref<double> z,
   double const& identifier_switch,
@@ -42288,282 +42620,10 @@ undrfl(
   n1 = -7654;
 }
 
-void
-skin(
-  common& cmn,
-  double const& s,
-  double const& r,
-  double const& freq,
-  double& rf,
-  double& xf) try
-{
-  common_write write(cmn);
-  double& tenm6 = cmn.tenm6;
-  double& unity = cmn.unity;
-  double& onehaf = cmn.onehaf;
-  const auto& fbe = cmn.fbe;
-  const auto& fbed = cmn.fbed;
-  const auto& fke = cmn.fke;
-  const auto& fked = cmn.fked;
-  double& sqrt2 = cmn.sqrt2;
-  double& aaa1 = cmn.aaa1;
-  //
-  double vsmall = fem::double0;
-  int jjj = fem::int0;
-  double s2 = fem::double0;
-  double s3 = fem::double0;
-  double r2 = fem::double0;
-  double qremb = fem::double0;
-  double q2 = fem::double0;
-  auto& lunit6 = cmn.lunit6;
-  double x = fem::double0;
-  double x2 = fem::double0;
-  int iback = fem::int0;
-  double berd = fem::double0;
-  double a = fem::double0;
-  double beid = fem::double0;
-  double b = fem::double0;
-  double gerd = fem::double0;
-  double aremb = fem::double0;
-  double geid = fem::double0;
-  double bremb = fem::double0;
-  double xremb = fem::double0;
-  double ber = fem::double0;
-  double g = fem::double0;
-  double bei = fem::double0;
-  double h = fem::double0;
-  double e = fem::double0;
-  double f = fem::double0;
-  double ger = fem::double0;
-  double gei = fem::double0;
-  double e2f2 = fem::double0;
-  double z = fem::double0;
-  int ialt = fem::int0;
-  int k = fem::int0;
-  double xl = fem::double0;
-  double thetar = fem::double0;
-  double thetai = fem::double0;
-  double phir = fem::double0;
-  double phii = fem::double0;
-  double fr = fem::double0;
-  double fi = fem::double0;
-  double gr = fem::double0;
-  double gi = fem::double0;
-  vsmall = 1.e-37f;
-  undrfl(jjj);
-  s2 = s * s;
-  s3 = (unity - s2) * r;
-  r2 = freq * cmn.valu8 / s3;
-  rf = r;
-  xf = 0.f;
-  if (r2 == 0.f) {
-    goto statement_9900;
-  }
-  qremb = 0.0f;
-  if (s < tenm6) {
-    goto statement_5;
-  }
-  q2 = r2 * s2;
-  if (s2 < 0.8f) {
-    goto statement_11;
-  }
-  if (q2 <= 64.0f && r2 > 64.0f) {
-    write(lunit6,
-      "(' RESULTS FROM SUBROUTINE SKIN UNRELIABLE WITH MQ**2=',f9.4,"
-      "' AND MR**2=',f9.4)"),
-      q2, r2;
-  }
-  statement_11:
-  if (q2 > 64.0f) {
-    qremb = sqrtz(q2) * sqrt2;
-  }
-  x = sqrtz(q2);
-  x2 = x * x / 64.0f;
-  iback = 2;
-  if (x2 <= unity) {
-    goto statement_100;
-  }
-  goto statement_200;
-  statement_4:
-  a = -berd;
-  b = -beid;
-  aremb = gerd;
-  bremb = geid;
-  xremb = x;
-  statement_5:
-  x = sqrtz(r2);
-  x2 = x * x / 64.0f;
-  iback = 1;
-  if (x2 <= unity) {
-    goto statement_100;
-  }
-  goto statement_200;
-  statement_6:
-  g = ber;
-  h = bei;
-  e = berd;
-  f = beid;
-  if (s < tenm6) {
-    goto statement_7;
-  }
-  g = a * ger - b * gei + aremb * ber - bremb * bei;
-  h = a * gei + b * ger + aremb * bei + bremb * ber;
-  e = a * gerd - b * geid + aremb * berd - bremb * beid;
-  f = a * geid + b * gerd + aremb * beid + bremb * berd;
-  statement_7:
-  e2f2 = fem::pow2(e) + fem::pow2(f);
-  s2 = x * s3 * onehaf / e2f2;
-  if (cmn.iprsup >= 1) {
-    write(lunit6, "(' E, F,  E2F2, AND S2 AT 320',4e16.6)"), e, f, e2f2, s2;
-  }
-  rf = (-h * e + g * f) * s2;
-  xf = (g * e + h * f) * s2;
-  goto statement_9900;
-  //C      CALCULATION OF KELVIN-FUNCTIONS FOR ARGUMENT.LE.8.               M14.4066
-  statement_100:
-  z = x2;
-  ber = unity;
-  bei = 0.0f;
-  berd = 0.0f;
-  beid = onehaf;
-  gerd = 0.0f;
-  geid = cmn.valu9;
-  ger = -cmn.valu10;
-  gei = 0.0f;
-  ialt = 1;
-  FEM_DO_SAFE(k, 1, 14) {
-    if (ialt == 1) {
-      goto statement_101;
-    }
-    ber += fbe(k) * z;
-    beid += fbed(k) * z;
-    if (s < tenm6) {
-      goto statement_102;
-    }
-    geid += fked(k) * z;
-    if (iback == 2) {
-      goto statement_102;
-    }
-    ger += fke(k) * z;
-    goto statement_102;
-    statement_101:
-    bei += fbe(k) * z;
-    berd += fbed(k) * z;
-    if (s < tenm6) {
-      goto statement_102;
-    }
-    gerd += fked(k) * z;
-    if (iback == 2) {
-      goto statement_102;
-    }
-    gei += fke(k) * z;
-    statement_102:
-    z = z * x2;
-    ialt = -ialt;
-  }
-  beid = beid * x;
-  berd = berd * x;
-  if (s < tenm6) {
-    goto statement_104;
-  }
-  xl = alogz(x * onehaf);
-  gerd = -xl * berd - ber / x + beid * aaa1 + x * gerd;
-  geid = -xl * beid - bei / x - berd * aaa1 + x * geid;
-  if (iback == 2) {
-    goto statement_104;
-  }
-  ger += -xl * ber + bei * aaa1;
-  gei += -xl * bei - ber * aaa1;
-  statement_104:
-  switch (iback) {
-    case 1: goto statement_6;
-    case 2: goto statement_4;
-    default: break;
-  }
-  //C      CALCULATIONS OF KELVIN-FUNCTIONS FOR ARGUMENT.GT.8.              M14.4104
-  statement_200:
-  x2 = 8.0f / x;
-  z = x2;
-  ber = 0.0f;
-  bei = -cmn.valu11;
-  berd = ber;
-  beid = bei;
-  ger = unity / sqrt2;
-  gei = ger;
-  gerd = ger;
-  geid = gei;
-  ialt = 1;
-  FEM_DO_SAFE(k, 1, 6) {
-    thetar = fbe(k + 14) * z;
-    thetai = fbed(k + 14) * z;
-    phir = fke(k + 14) * z;
-    phii = fked(k + 14) * z;
-    ber += thetar;
-    bei += thetai;
-    ger += phir;
-    gei += phii;
-    if (ialt == 1) {
-      goto statement_201;
-    }
-    berd += thetar;
-    beid += thetai;
-    gerd += phir;
-    geid += phii;
-    goto statement_202;
-    statement_201:
-    berd = berd - thetar;
-    beid = beid - thetai;
-    gerd = gerd - phir;
-    geid = geid - phii;
-    statement_202:
-    ialt = -ialt;
-    z = z * x2;
-  }
-  xl = x * sqrt2;
-  if (qremb < 1.0f) {
-    goto statement_204;
-  }
-  xl = xl - qremb;
-  statement_204:
-  thetar = -xl + berd;
-  thetai = -xl + beid;
-  z = sqrtz(x);
-  x2 = cmn.valu12 / z;
-  z = cmn.valu13 / z * expz(thetar);
-  fr = z * cosz(thetai);
-  fi = z * sinz(thetai);
-  x2 = x2 * expz(ber);
-  thetar = x2 * cosz(bei);
-  thetai = x2 * sinz(bei);
-  z = -fr * gerd + fi * geid;
-  geid = -fr * geid - fi * gerd;
-  gerd = z;
-  z = cmn.aaa2 * expz(-qremb);
-  gr = z * sinz(qremb);
-  gi = z * cosz(qremb);
-  berd = thetar * ger - thetai * gei + gerd * gr - geid * gi;
-  beid = thetar * gei + thetai * ger + gerd * gi + geid * gr;
-  ger = fr;
-  gei = fi;
-  ber = thetar + ger * gr - gei * gi;
-  bei = thetai + ger * gi + gei * gr;
-  switch (iback) {
-    case 1: goto statement_6;
-    case 2: goto statement_4;
-    default: break;
-  }
-  statement_9900:
-  if (jjj == 3) {
-    z = vsmall;
-  }
-}
-catch (...) {
-  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
-}
-
+template <typename Cmn>
 void
 wrte(
-  common& cmn,
+  Cmn& cmn,
   arr_cref<double> p,
   int const& i2,
   int const& i3,
@@ -42646,8 +42706,9 @@ struct output_save
   {}
 };
 
+template <typename Cmn>
 void output(
-  common& cmn,
+  Cmn& cmn,
   int const& metrik,
   arr_cref<double> p,
   arr_cref<double> z,
@@ -42968,6 +43029,698 @@ struct guts44_save
   {}
 };
 
+// The rows of the Z matrix of GUTS44 (phases KCIRCT, ..., 1 from the end
+// of the conductor table, then the others from its start), the P matrix
+// logarithms read back from LUNT13 into P(1 : IP), and the constants of
+// the Carson series and the skin effect.
+static void
+line_geometry44(
+  common& cmn,
+  LineGeometry& g,
+  int const& kfull,
+  int const& kcirct,
+  int const& lphpl1,
+  int const& isegm,
+  double const& rearth,
+  double const& corr) try
+{
+  int k = fem::int0;
+  int j = fem::int0;
+  int i = fem::int0;
+  g.rows.resize(kfull);
+  FEM_DO_SAFE(k, 1, kfull) {
+    j = k - kcirct;
+    if (k <= kcirct) {
+      j = lphpl1 - k;
+    }
+    LineConductor& c = g.rows[k - 1];
+    c.x = static_cast<common_c44b08&>(cmn).x(j);
+    c.y = cmn.y(j);
+    c.r = static_cast<common_c44b05&>(cmn).r(j);
+    c.tb2 = cmn.tb2(j);
+    c.gmd = cmn.gmd(j);
+    c.dz = cmn.dz(j);
+    c.itb3 = cmn.itb3(j);
+    c.segmented = cmn.ic(j) == 0 && isegm > 0;
+  }
+  //  THE DIAGONAL OF LUNT13 IS LEFT FROM THE LAST Z MATRIX, NOT NEEDED
+  g.logp.assign(kfull * (kfull + 1) / 2, 0.0);
+  FEM_DO_SAFE(k, 1, kfull) {
+    FEM_DO_SAFE(j, 1, k - 1) {
+      i = k * (k - 1) / 2 + j;
+      g.logp[i - 1] = cmn.p(i);
+    }
+  }
+  g.rearth = rearth;
+  g.corr = corr;
+  CarsonTables& t = g.tables;
+  t.unity = cmn.unity;
+  t.onehaf = cmn.onehaf;
+  t.twopi = cmn.twopi;
+  t.tenm6 = cmn.tenm6;
+  t.sqrt2 = cmn.sqrt2;
+  t.corchk = cmn.corchk;
+  t.valu2 = cmn.valu2;
+  t.valu3 = cmn.valu3;
+  t.valu4 = cmn.valu4;
+  t.valu8 = cmn.valu8;
+  t.valu9 = cmn.valu9;
+  t.valu10 = cmn.valu10;
+  t.valu11 = cmn.valu11;
+  t.valu12 = cmn.valu12;
+  t.valu13 = cmn.valu13;
+  t.aaa1 = cmn.aaa1;
+  t.aaa2 = cmn.aaa2;
+  FEM_DO_SAFE(i, 1, 30) {
+    t.bcars[i - 1] = cmn.bcars(i);
+    t.ccars[i - 1] = cmn.ccars(i);
+    t.dcars[i - 1] = cmn.dcars(i);
+  }
+  FEM_DO_SAFE(i, 1, 20) {
+    t.fbe[i - 1] = cmn.fbe(i);
+    t.fbed[i - 1] = cmn.fbed(i);
+    t.fke[i - 1] = cmn.fke(i);
+    t.fked[i - 1] = cmn.fked(i);
+  }
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
+//  THE CARDS OF THE CASE ON LUNIT2 UP TO THE FIRST BLANK ONE, AS COMMENTS
+//  OF THE PUNCH (STATEMENT 8770 OF GUTS44)
+void
+punch_case44(
+  common& cmn,
+  int const& ipunch,
+  int const& idebug,
+  int& kount) try
+{
+  common_read read(cmn);
+  common_write write(cmn);
+  auto& texta6 = cmn.texta6;
+  int n5 = fem::int0;
+  int n12 = fem::int0;
+  int i = fem::int0;
+  cmn.io.rewind(cmn.lunit2);
+  FEM_DO_SAFE(n12, 1, 9999) {
+    {
+      read_loop rloop(cmn, cmn.lunit2, "(13a6,a2)");
+      FEM_DO_SAFE(i, 1, 14) {
+        rloop, texta6(i);
+      }
+    }
+    if (ipunch == 0) {
+      {
+        write_loop wloop(cmn, cmn.lunit7, "('C ',13a6)");
+        FEM_DO_SAFE(i, 1, 13) {
+          wloop, texta6(i);
+        }
+      }
+    }
+    if (idebug == 0) {
+      goto statement_8100;
+    }
+    {
+      write_loop wloop(cmn, cmn.lunit1, "(' C ',13a6,a2)");
+      FEM_DO_SAFE(i, 1, 14) {
+        wloop, texta6(i);
+      }
+    }
+    kount++;
+    statement_8100:
+    if (texta6(1) == cmn.blank && texta6(2) == cmn.blank) {
+      n5++;
+    }
+    if (n5 >= 1) {
+      return;
+    }
+  }
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
+//  THE COMMON OF A STEP THREAD FOR A FREQUENCY OF THE SWEEP: THE CONSTANTS
+//  OF GUTS44 AND OF THE ROUTINES IT CALLS, AS THEY ARE ON THE THREAD OF
+//  GUTS44 (WHICH ONLY WAITS FOR THE STEP THREADS MEANWHILE)
+void
+line_common44(
+  LineCommon& lc,
+  const common& cmn)
+{
+  int i = fem::int0;
+  lc.unity = cmn.unity;
+  lc.onehaf = cmn.onehaf;
+  lc.epsiln = cmn.epsiln;
+  lc.flzero = cmn.flzero;
+  lc.tenm6 = cmn.tenm6;
+  lc.t = cmn.t;
+  lc.lastov = cmn.lastov;
+  lc.nchain = cmn.nchain;
+  lc.iprsup = cmn.iprsup;
+  lc.kill = 0;
+  lc.kexact = cmn.kexact;
+  lc.blank = cmn.blank;
+  lc.date1 = cmn.date1;
+  lc.tclock = cmn.tclock;
+  FEM_DO_SAFE(i, 1, 30) {
+    lc.bcars(i) = cmn.bcars(i);
+    lc.ccars(i) = cmn.ccars(i);
+    lc.dcars(i) = cmn.dcars(i);
+  }
+  FEM_DO_SAFE(i, 1, 20) {
+    lc.fbe(i) = cmn.fbe(i);
+    lc.fbed(i) = cmn.fbed(i);
+    lc.fke(i) = cmn.fke(i);
+    lc.fked(i) = cmn.fked(i);
+  }
+  FEM_DO_SAFE(i, 1, 40) {
+    lc.brname(i) = cmn.brname(i);
+  }
+  lc.picon = cmn.picon;
+  lc.sqrt2 = cmn.sqrt2;
+  lc.valu1 = cmn.valu1;
+  lc.valu2 = cmn.valu2;
+  lc.valu3 = cmn.valu3;
+  lc.valu4 = cmn.valu4;
+  lc.valu5 = cmn.valu5;
+  lc.valu6 = cmn.valu6;
+  lc.valu7 = cmn.valu7;
+  lc.valu8 = cmn.valu8;
+  lc.valu9 = cmn.valu9;
+  lc.valu10 = cmn.valu10;
+  lc.valu11 = cmn.valu11;
+  lc.valu12 = cmn.valu12;
+  lc.valu13 = cmn.valu13;
+  lc.corchk = cmn.corchk;
+  lc.aaa1 = cmn.aaa1;
+  lc.aaa2 = cmn.aaa2;
+  lc.ll0 = cmn.ll0;
+  lc.ll1 = cmn.ll1;
+  lc.ll2 = cmn.ll2;
+  lc.ll3 = cmn.ll3;
+  lc.ll5 = cmn.ll5;
+  lc.ll6 = cmn.ll6;
+  lc.ll7 = cmn.ll7;
+  lc.ll8 = cmn.ll8;
+  lc.ll9 = cmn.ll9;
+  lc.ll10 = cmn.ll10;
+  lc.lphase = cmn.lphase;
+  lc.lphpl1 = cmn.lphpl1;
+  lc.lphd2 = cmn.lphd2;
+  lc.lgdbd = cmn.lgdbd;
+  lc.jpralt = cmn.jpralt;
+  lc.nfreq = cmn.nfreq;
+}
+
+//  A FREQUENCY OF A LOGARITHMIC SWEEP OF GUTS44 ON A STEP THREAD, FROM THE
+//  FORMATION OF P TO THE PUNCHED MODAL OR AVERAGED PARAMETERS: WHAT
+//  STATEMENTS 3008 - 13039 DO WHEN LASTOV = 1, IK .GT. 0, KCIRCT .GE. 2,
+//  IDIST = 0, AND IPUNCH, IALTER, IPRSUP, IDEBUG, MUTUAL, MSPEDB ARE ZERO
+//  (SEE GUTS44 AFTER STATEMENT 8806), WITH LUNT13 KEPT IN MEMORY.  WHAT IS
+//  WRITTEN GOES TO  OUT  FOR GUTS44 TO WRITE OUT IN FREQUENCY ORDER.
+void
+line_frequency44(
+  LineCommon& lc,
+  const common& cmn,
+  const LineCase& c,
+  double const& freq,
+  LineFrequency& out) try
+{
+  line_common44(lc, cmn);
+  lc.log.clear();
+  lc.screen.clear();
+  lc.punch.clear();
+  lc.out2_stream.str(std::string());
+  lc.out2_stream.clear();
+  lc.cards_at = 0;
+  lc.cards = -1;
+  out.freq = freq;
+  out.clean = false;
+  out.modal = false;
+  common_write write(lc);
+  auto& p = lc.p;
+  auto& z = static_cast<common_c44b03&>(lc).z;
+  auto& workr1 = lc.workr1;
+  auto& workr2 = lc.workr2;
+  double const& unity = lc.unity;
+  double const& twopi = cmn.twopi;
+  int const& lunit6 = lc.lunit6;
+  int const& lunit7 = lc.lunit7;
+  int& kill = lc.kill;
+  arr_cref<int> jprmat(c.jprmat[0], dimension(17));
+  int const& kfull = c.kfull;
+  int const& kcirct = c.kcirct;
+  int const& metrik = c.metrik;
+  int const& iw = c.iw;
+  int const& imodal = c.imodal;
+  int const& ndim = c.ndim;
+  int const& ntri = c.ntri;
+  int const& nsqr2 = c.nsqr2;
+  double const& dist = c.dist;
+  const LineGeometry& g = c.geometry;
+  //  THE ARRAYS OF MODAL AND OF THE AVERAGED PARAMETERS
+  lc.stg.resize(std::size_t(2 * ntri + 6 * ndim * ndim + 8 * ndim + 2 * nsqr2));
+  double* stg = lc.stg.data();
+  arr_ref<double> xwc(stg[0], dimension(ntri));
+  stg += ntri;
+  arr_ref<double> xwy(stg[0], dimension(ntri));
+  stg += ntri;
+  arr_ref<double, 2> yzr(stg[0], dimension(ndim, ndim));
+  stg += ndim * ndim;
+  arr_ref<double, 2> yzi(stg[0], dimension(ndim, ndim));
+  stg += ndim * ndim;
+  arr_ref<double, 2> tii(stg[0], dimension(ndim, ndim));
+  stg += ndim * ndim;
+  arr_ref<double, 2> tir(stg[0], dimension(ndim, ndim));
+  stg += ndim * ndim;
+  arr_ref<double, 2> tvi(stg[0], dimension(ndim, ndim));
+  stg += ndim * ndim;
+  arr_ref<double, 2> tvr(stg[0], dimension(ndim, ndim));
+  stg += ndim * ndim;
+  arr_ref<double> er(stg[0], dimension(ndim));
+  stg += ndim;
+  arr_ref<double> ei(stg[0], dimension(ndim));
+  stg += ndim;
+  arr_ref<double> theta2(stg[0], dimension(ndim));
+  stg += ndim;
+  arr_ref<double> xtir(stg[0], dimension(ndim));
+  stg += ndim;
+  arr_ref<double> xtii(stg[0], dimension(ndim));
+  stg += ndim;
+  arr_ref<double> zsurge(stg[0], dimension(ndim));
+  stg += ndim;
+  arr_ref<double> dummi(stg[0], dimension(ndim));
+  stg += ndim;
+  arr_ref<double> dummr(stg[0], dimension(ndim));
+  stg += ndim;
+  arr_ref<double> tixf(stg[0], dimension(nsqr2));
+  stg += nsqr2;
+  arr_ref<double> work1(stg[0], dimension(nsqr2));
+  //
+  int ip = fem::int0;
+  int kp = fem::int0;
+  int kk = fem::int0;
+  int k = fem::int0;
+  int i = fem::int0;
+  int i2 = fem::int0;
+  int jp = fem::int0;
+  int n55 = fem::int0;
+  int j56 = fem::int0;
+  double omega = fem::double0;
+  double f1 = fem::double0;
+  double f2 = fem::double0;
+  double dx = fem::double0;
+  double h1 = fem::double0;
+  double h2 = fem::double0;
+  double r1 = fem::double0;
+  double d13 = fem::double0;
+  double cdiag = fem::double0;
+  double coff = fem::double0;
+  double rdiag = fem::double0;
+  double xdiag = fem::double0;
+  double roff = fem::double0;
+  double xoff = fem::double0;
+  double distm = fem::double0;
+  double identifier_switch = fem::double0;
+  std::vector<double> p13, z13;
+  LineGeometry zg;
+  LineZ lz;
+  static const char* format_140 = "('-',i1,2a6,12x,4e12.5,' 1',2x)";
+  static const char* format_1475 = "('-',i1,2a6)";
+  static const char* format_9475 = "(i2,2a6)";
+  static const char* format_228 = "('$VINTAGE, 1')";
+  static const char* format_29 = "('$VINTAGE, 0')";
+  //  ELIMINATION OF EARTH WIRES AND BUNDLING, AS STATEMENTS 49 - 56 (OF  Z
+  //  TOO IF IDENTIFIER_SWITCH .GT. 0)
+  auto eliminate = [&]() {
+    int ki = fem::int0;
+    int k2 = fem::int0;
+    int L = fem::int0;
+    FEM_DO_SAFE(k, kcirct + 1, kfull) {
+      ki = c.ic[std::size_t(k - kcirct - 1)];
+      if (ki == 0) {
+        continue;
+      }
+      i2 = ki * (ki - 1) / 2;
+      k2 = k * (k - 1) / 2;
+      kk = k2 + ki;
+      h1 = p(kk);
+      h2 = z(kk);
+      kk = k2 + k;
+      L = 0;
+      do {
+        if (L < ki) {
+          i2++;
+        }
+        else {
+          i2 += L;
+        }
+        if (L < k) {
+          k2++;
+        }
+        else {
+          k2 += L;
+        }
+        L++;
+        p(k2) = p(k2) - p(i2);
+        if (identifier_switch > 0.f) {
+          z(k2) = z(k2) - z(i2);
+        }
+      } while (L != kfull);
+      p(kk) = p(kk) - h1;
+      if (identifier_switch > 0.f) {
+        z(kk) = z(kk) - h2;
+      }
+    }
+    kp = kcirct * (kcirct + 1) / 2;
+  };
+  omega = twopi * freq;
+  j56 = jprmat(5) + jprmat(6);
+  //C                                                  FORMATION OF P-MATRIX
+  f1 = unity / omega;
+  if (iw > 0) {
+    f1 = unity;
+  }
+  f1 = f1 * lc.valu1;
+  f2 = f1 * 2.0f;
+  zg = g;
+  zg.logp.assign(std::size_t(kfull * (kfull + 1) / 2), 0.0);
+  FEM_DO_SAFE(k, 1, kfull) {
+    const LineConductor& ck = g.rows[std::size_t(k - 1)];
+    FEM_DO_SAFE(i, 1, k - 1) {
+      ip++;
+      const LineConductor& ci = g.rows[std::size_t(i - 1)];
+      dx = fem::pow2((ci.x - ck.x));
+      h1 = ci.y - ck.y;
+      h2 = ci.y + ck.y;
+      if (dx == 0.0f && h1 == 0.0f) {
+        return;
+      }
+      r1 = alogz((dx + h2 * h2) / (dx + h1 * h1));
+      p(ip) = r1 * f1;
+      z(ip) = r1;
+      zg.logp[std::size_t(ip - 1)] = r1;
+    }
+    ip++;
+    p(ip) = alogz(48.f * ck.y / ck.dz) * f2;
+  }
+  if (c.jspecl != 0) {
+    write(lunit6,
+      "(/,/,'0FOLLOWING MATRICES ARE FOR EARTH RESISTIVITY=',f8.2,"
+      "' OHM-M AND FREQUENCY=',f13.2,' HZ. CORRECTION FACTOR=',f10.6)"),
+      g.rearth, freq, g.corr;
+    lc.out2_stream << "\nFOLLOWING MATRICES ARE FOR EARTH RESISTIVITY= " << SState("f0.2") << g.rearth
+      << " OHM-M AND FREQUENCY= " << SState("f0.2") << freq
+      << " HZ. CORRECTION FACTOR= " << SState("f0.6") << g.corr << "\n";
+  }
+  //C                                   REDUCTIONS AND INVERSIONS P-MATRIX
+  identifier_switch = -unity;
+  if (jprmat(1) > 0) {
+    i2 = 1;
+    if (iw == 0) {
+      i2++;
+    }
+    output(lc, metrik, p(1), z(1), identifier_switch, kfull, i2, lc.ll1);
+  }
+  if (jprmat(4) > 0) {
+    i2 = 3;
+    if (iw == 0) {
+      i2++;
+    }
+    FEM_DO_SAFE(i, 1, ip) {
+      z(i) = -p(i);
+    }
+    redu44(lc, z(1), workr1(1), kfull, lc.ll0);
+    if (kill > 0) {
+      return;
+    }
+    output(lc, metrik, z(1), p(1), identifier_switch, kfull, i2, lc.ll1);
+  }
+  if (jprmat(2) + jprmat(3) + j56 != 0) {
+    eliminate();
+    redu44(lc, p(1), workr1(1), kfull, kcirct);
+    if (kill > 0) {
+      return;
+    }
+    if (jprmat(2) + jprmat(3) > 0) {
+      //C     STATEMENT 38
+      if (imodal > 0) {
+        FEM_DO_SAFE(i, 1, kp) {
+          xwc(i) = p(i);
+        }
+      }
+      i2 = 1;
+      if (iw == 0) {
+        i2++;
+      }
+      if (c.j2out > 0) {
+        output(lc, metrik, p(1), z(1), identifier_switch, kcirct, i2, lc.ll2);
+      }
+      //C     THE SYMMETRICAL COMPONENTS ARE ONLY PRINTED IF IK .LE. 0
+      if (jprmat(3) != 0 && j56 != 0) {
+        p13.assign(&p(1), &p(1) + kp);
+        symm(lc, p(1), z(1), identifier_switch, kcirct, kk);
+        std::copy(p13.begin(), p13.end(), &p(1));
+      }
+    }
+    if (j56 > 0) {
+      //C     STATEMENT 39
+      i2 = 3;
+      if (iw == 0) {
+        i2++;
+      }
+      FEM_DO_SAFE(i, 1, kp) {
+        p(i) = -p(i);
+      }
+      redu44(lc, p(1), workr1(1), kcirct, lc.ll0);
+      if (kill > 0) {
+        return;
+      }
+      if (imodal != 1) {
+        cdiag = 0;
+        coff = 0;
+        n55 = 1;
+        FEM_DO_SAFE(i, 1, kcirct) {
+          cdiag += p(n55);
+          FEM_DO_SAFE(jp, n55 - i + 1, n55 - 1) {
+            coff += p(jp);
+          }
+          n55 += i + 1;
+        }
+        cdiag = cdiag / kcirct;
+        coff = coff / (kcirct * (kcirct - 1) / 2);
+        dummi(1) = cdiag + (kcirct - 1) * coff;
+        dummi(2) = cdiag - coff;
+        if (iw != 0) {
+          d13 = twopi * freq;
+          dummi(1) = dummi(1) * d13;
+          dummi(2) = dummi(2) * d13;
+        }
+      }
+      if (c.j5out > 0) {
+        output(lc, metrik, p(1), z(1), identifier_switch, kcirct, i2, lc.ll2);
+      }
+      if (jprmat(6) != 0) {
+        symm(lc, p(1), z(1), identifier_switch, kcirct, kk);
+        i2 = 3;
+        if (iw == 0) {
+          i2++;
+        }
+        if (c.j6out > 0) {
+          output(lc, metrik, p(1), z(1), unity, kk, i2, lc.ll3);
+        }
+      }
+    }
+  }
+  //C                                         FORMATION OF Z-MATRIX
+  identifier_switch = +unity;
+  j56 = jprmat(8) + jprmat(9) + jprmat(11) + jprmat(12);
+  if (j56 + jprmat(7) + jprmat(10) == 0) {
+    goto statement_600;
+  }
+  line_z(zg, freq, lz);
+  ip = 0;
+  FEM_DO_SAFE(k, 1, kfull) {
+    const SkinTrace& trace = lz.skin[std::size_t(k - 1)];
+    if (trace.unreliable) {
+      write(lunit6,
+        "(' RESULTS FROM SUBROUTINE SKIN UNRELIABLE WITH MQ**2=',f9.4,"
+        "' AND MR**2=',f9.4)"),
+        trace.q2, trace.r2;
+    }
+    FEM_DO_SAFE(i, 1, k) {
+      ip++;
+      p(ip) = lz.r[std::size_t(ip - 1)];
+      z(ip) = lz.x[std::size_t(ip - 1)];
+    }
+  }
+  if (jprmat(7) > 0) {
+    output(lc, metrik, p(1), z(1), unity, kfull, lc.ll6, lc.ll1);
+  }
+  if (jprmat(10) > 0) {
+    //C     STATEMENT 250
+    p13.assign(&p(1), &p(1) + ip);
+    z13.assign(&z(1), &z(1) + ip);
+    FEM_DO_SAFE(i, 1, ip) {
+      p(i) = -p(i);
+      z(i) = -z(i);
+    }
+    cxred2(p(1), z(1), workr1(1), workr2(1), kfull, lc.ll0);
+    output(lc, metrik, p(1), z(1), unity, kfull, lc.ll5, lc.ll1);
+    std::copy(p13.begin(), p13.end(), &p(1));
+    std::copy(z13.begin(), z13.end(), &z(1));
+  }
+  if (j56 == 0) {
+    goto statement_600;
+  }
+  eliminate();
+  cxred2(p(1), z(1), workr1(1), workr2(1), kfull, kcirct);
+  if (c.j8out > 0) {
+    output(lc, metrik, p(1), z(1), unity, kcirct, lc.ll6, lc.ll2);
+  }
+  if (imodal > 0) {
+    int itrnsf = c.itrnsf;
+    if (itrnsf != -1 && itrnsf != -9) {
+      itrnsf = 0;
+    }
+    if (kcirct > ndim) {
+      return;
+    }
+    double mdist = dist;
+    double conduc = c.conduc;
+    int mrr = fem::int0;
+    int const nrp = fem::int0;
+    int const ntol = fem::int0;
+    modal(lc, xwc, xwc, xwy, yzr, yzi, tii, tir, tvi, tvr, er, ei,
+      theta2, xtir, xtii, zsurge, dummi, dummr, tixf, work1, freq, kcirct,
+      iw, mdist, metrik, c.fmipkm, ndim, ntri, nsqr2, itrnsf, kfull, mrr,
+      nrp, ntol, conduc);
+    if (kill != 0) {
+      return;
+    }
+    out.modal = true;
+  }
+  if (imodal == 0) {
+    //C     STATEMENT 2202
+    write(lunit7,
+      "('C   PUNCHED CARD OUTPUT OF TRANSPOSED LINE',' WHICH BEGAN AT',2x,2a4,"
+      "2x,2a4)"),
+      lc.tclock, lc.date1;
+    write(lunit7,
+      "('C   ***** TRANSPOSED K.C. LEE LINE SEGMENT CALCULATED AT',2x,e10.3,"
+      "' HZ. *****')"),
+      freq;
+    lc.cards_at = lc.punch.size();
+    lc.cards = 0;
+  }
+  //C     STATEMENT 3734
+  j56 = jprmat(11) + jprmat(12);
+  if (jprmat(9) > 0) {
+    //C     STATEMENTS 253, 45454
+    p13.assign(&p(1), &p(1) + kp);
+    z13.assign(&z(1), &z(1) + kp);
+    d13 = twopi * freq;
+    if (imodal == 0) {
+      rdiag = 0;
+      xdiag = 0;
+      roff = 0;
+      xoff = 0;
+      n55 = 1;
+      FEM_DO_SAFE(i, 1, kcirct) {
+        rdiag += p(n55);
+        xdiag += z(n55);
+        FEM_DO_SAFE(jp, n55 - i + 1, n55 - 1) {
+          roff += p(jp);
+          xoff += z(jp);
+        }
+        n55 += i + 1;
+      }
+      rdiag = rdiag / kcirct;
+      xdiag = xdiag / kcirct;
+      roff = roff / (kcirct * (kcirct - 1) / 2);
+      xoff = xoff / (kcirct * (kcirct - 1) / 2);
+      xtir(1) = rdiag + (kcirct - 1) * roff;
+      xtii(1) = xdiag + (kcirct - 1) * xoff;
+      xtir(2) = rdiag - roff;
+      xtii(2) = xdiag - xoff;
+      write(lunit7, format_228);
+      FEM_DO_SAFE(i, 1, 2) {
+        zsurge(i) = sqrtz(xtii(i) / dummi(i));
+        er(i) = d13 / sqrtz(xtii(i) * dummi(i));
+      }
+      FEM_DO_SAFE(i, 1, kcirct) {
+        if (i <= 2) {
+          write(lunit7, format_140), i, lc.brname(2 * i - 1), lc.brname(2 * i),
+            xtir(i), zsurge(i), er(i), dist;
+        }
+        else if (i <= 9) {
+          write(lunit7, format_1475), i, lc.brname(2 * i - 1), lc.brname(2 * i);
+        }
+        else {
+          write(lunit7, format_9475), i, lc.brname(2 * i - 1), lc.brname(2 * i);
+        }
+      }
+      write(lunit7, format_29);
+    }
+    //C     STATEMENT 256
+    symm(lc, p(1), z(1), unity, kcirct, kk);
+    if (c.j9out > 0) {
+      output(lc, metrik, p(1), z(1), unity, kk, lc.ll6, lc.ll3);
+    }
+    if (jprmat(6) != 0) {
+      goto statement_13039;
+    }
+    if (j56 == 0) {
+      goto statement_600;
+    }
+    std::copy(p13.begin(), p13.end(), &p(1));
+    std::copy(z13.begin(), z13.end(), &z(1));
+  }
+  if (j56 != 0) {
+    //C     STATEMENT 203
+    FEM_DO_SAFE(i, 1, kp) {
+      p(i) = -p(i);
+      z(i) = -z(i);
+    }
+    cxred2(p(1), z(1), workr1(1), workr2(1), kcirct, lc.ll0);
+    if (jprmat(11) > 0) {
+      output(lc, metrik, p(1), z(1), unity, kcirct, lc.ll5, lc.ll2);
+    }
+    if (jprmat(12) != 0) {
+      symm(lc, p(1), z(1), unity, kcirct, kk);
+      output(lc, metrik, p(1), z(1), unity, kk, lc.ll5, lc.ll3);
+    }
+  }
+  statement_600:
+  if (dist != 0.f && jprmat(13) + jprmat(14) + jprmat(15) + jprmat(16) != 0) {
+    if (metrik == 1) {
+      distm = dist / c.fmipkm;
+      write(lunit6, "(/,' MATRICES FOR LINE LENGTH =',f8.3,' KM.')"), distm;
+    }
+    else {
+      write(lunit6, "(/,' MATRICES FOR LINE LENGTH =',e13.6,' MILES.')"), dist;
+    }
+    write(lunit6,
+      "('+',41x,'CANNOT BE CALCULATED WITH NUMBER OF EQUIVALENT CONDUCTORS=',"
+      "i3)"),
+      kcirct;
+  }
+  statement_13039:
+  out.clean = true;
+  out.log.swap(lc.log);
+  out.screen.swap(lc.screen);
+  out.punch.swap(lc.punch);
+  out.out2 = lc.out2_stream.str();
+  out.cards_at = lc.cards_at;
+  out.cards = lc.cards;
+  out.t = lc.t;
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
 void guts44(common& cmn,  // Line Constants 
   arr_cref<double> array,
   arr_ref<double> xwc,
@@ -43044,7 +43797,6 @@ void guts44(common& cmn,  // Line Constants
   auto& lstat = cmn.lstat;
   int& icheck = cmn.icheck;
   int& ipunch = cmn.ipunch;
-  int& izero = cmn.izero;
   int& lastov = cmn.lastov;
   int& ktab = cmn.ktab;
   int& ialter = cmn.ialter;
@@ -43243,33 +43995,12 @@ void guts44(common& cmn,  // Line Constants
   int kk = fem::int0;
   int L = fem::int0;
   int kp = fem::int0;
-  int imax = fem::int0;
   double g1 = fem::double0;
-  int ix = fem::int0;
-  double xm = fem::double0;
-  double xs = fem::double0;
-  double rm = fem::double0;
-  double s = fem::double0;
   double z1 = fem::double0;
-  double zl = fem::double0;
-  double s1 = fem::double0;
-  double c1 = fem::double0;
-  double cs = fem::double0;
-  double sn = fem::double0;
-  double phi = fem::double0;
-  int m5 = fem::int0;
-  double error = fem::double0;
-  int k5 = fem::int0;
   int i5 = fem::int0;
-  double deltap = fem::double0;
-  double deltaq = fem::double0;
-  double s2 = fem::double0;
-  double c2 = fem::double0;
   double distkm = fem::double0;
   int n8 = fem::int0;
   int kount = fem::int0;
-  int n5 = fem::int0;
-  int n12 = fem::int0;
   int idebug = fem::int0;
   double rzero = fem::double0;
   double xzero = fem::double0;
@@ -44221,6 +44952,7 @@ void guts44(common& cmn,  // Line Constants
   if (mfrqpr > 0) {
     write(lunit6, format_3004);
   }
+  cmn.line_sweep.plan(fdecad, factor, ik, ips);
   goto statement_3006;
   statement_3005:
   iii++;
@@ -44284,6 +45016,96 @@ void guts44(common& cmn,  // Line Constants
   }
   statement_8806:
   kkk++;
+  //  THE FREQUENCIES OF A SWEEP BUT THE FIRST AND THE LAST ARE DONE ON THE
+  //  STEP THREADS BY LINE_FREQUENCY44, A WINDOW AHEAD, IN THE
+  //  CONFIGURATIONS IT TAKES; WHAT THEY PRINTED AND PUNCHED IS WRITTEN OUT
+  //  HERE IN THE ORDER OF THE FREQUENCIES
+  if (kkk > 1 && ik > 0 && lastov == 1 && kexact != 88333 && iprint != 1 &&
+      ipunch == 0 && ialter <= 0 && iprsup == 0 && idebug == 0 &&
+      mutual == 0 && mspedb == 0 && kcirct >= 2 && kcirct <= kfull &&
+      ((dist == 0.0f && ipunch != 44) || kcirct >= cmn.lphd2) &&
+      itrnsf != -1 &&
+      (imodal > 0 ? jprmat(2) + jprmat(3) > 0 :
+        imodal < 0 || jprmat(5) + jprmat(6) > 0) &&
+      !(jprmat(9) > 0 && jprmat(6) == 0 && jprmat(11) + jprmat(12) != 0)) {
+    LineCase lcase;
+    line_geometry44(cmn, lcase.geometry, kfull, kcirct, lphpl1, isegm,
+      rearth, corr);
+    lcase.geometry.logp.clear();
+    bool bundled = true;
+    FEM_DO_SAFE(k, 1, kcirct) {
+      bundled = bundled && ic(lphpl1 - k) != 0;
+    }
+    FEM_DO_SAFE(k, 1, kfull - kcirct) {
+      lcase.ic.push_back(ic(k));
+    }
+    FEM_DO_SAFE(k, 1, 17) {
+      lcase.jprmat[k - 1] = jprmat(k);
+    }
+    lcase.j2out = j2out;
+    lcase.j5out = j5out;
+    lcase.j6out = j6out;
+    lcase.j8out = j8out;
+    lcase.j9out = j9out;
+    lcase.jspecl = jspecl;
+    lcase.iw = iw;
+    lcase.metrik = metrik;
+    lcase.imodal = imodal;
+    lcase.itrnsf = itrnsf;
+    lcase.kcirct = kcirct;
+    lcase.kfull = kfull;
+    lcase.ndim = ndim;
+    lcase.ntri = ntri;
+    lcase.nsqr2 = nsqr2;
+    lcase.fmipkm = fmipkm;
+    lcase.dist = dist;
+    lcase.conduc = conduc;
+    while (bundled &&
+        int(cmn.line_commons.size()) < cmn.line_sweep.threads()) {
+      cmn.line_commons.push_back(std::make_unique<LineCommon>());
+    }
+    const LineFrequency* lf = bundled ? cmn.line_sweep.frequency(lcase, freq,
+      [&](int thread, double f, LineFrequency& out) {
+        line_frequency44(*cmn.line_commons[std::size_t(thread)], cmn, lcase,
+          f, out);
+      }) : nullptr;
+    if (lf && lf->clean) {
+      if (!lf->screen.empty()) {
+        cmn.io.simple_ostream(6)->put(lf->screen.data(), lf->screen.size());
+      }
+      if (!lf->log.empty()) {
+        cmn.io.simple_ostream(lunit6)->put(lf->log.data(), lf->log.size());
+      }
+      cmn.out2_stream << lf->out2;
+      if (lf->cards_at > 0) {
+        cmn.io.simple_ostream(lunit7)->put(lf->punch.data(), lf->cards_at);
+      }
+      if (lf->cards > 0) {
+        punch_cards44(cmn, lf->cards);
+      }
+      if (lf->cards == 0) {
+        kount = 0;
+        cmn.io.rewind(lunit1);
+        punch_case44(cmn, ipunch, idebug, kount);
+      }
+      if (lf->punch.size() > lf->cards_at) {
+        cmn.io.simple_ostream(lunit7)->put(lf->punch.data() + lf->cards_at,
+          lf->punch.size() - lf->cards_at);
+      }
+      if (lf->modal) {
+        if (nfreq == 3) {
+          ntol++;
+        }
+        if (itrnsf != -1 && itrnsf != -9) {
+          itrnsf = 0;
+        }
+        conduc = 0.0f;
+        cmn.t = lf->t;
+      }
+      omega = twopi * freq;
+      goto statement_3006;
+    }
+  }
   statement_3007:
   omega = twopi * freq;
   if (ik > 0) {
@@ -44580,16 +45402,6 @@ void guts44(common& cmn,  // Line Constants
   f1 = valu2 * sqrtz(freq / rearth);
   statement_100:
   f2 = omega * valu3;
-  imax = 30;
-  if (corr == 0.f || rearth == 0.f) {
-    imax = -1;
-  }
-  if (corr > corchk) {
-    imax = corr - onehaf;
-  }
-  if (imax > 31) {
-    imax = 30;
-  }
   {
     read_loop rloop(cmn, lunt13, fem::unformatted);
     FEM_DO_SAFE(i, 1, ip) {
@@ -44599,272 +45411,46 @@ void guts44(common& cmn,  // Line Constants
   //C     SEGMENTED, 1, VAX E/T CAN SKIP TRANSLATION OF REWIND:             M29.4201
   cmn.io.rewind(lunt13);
   ip = 0;
-  statement_120:
-  k++;
-  if (k > kfull) {
-    goto statement_200;
-  }
-  if (k <= kcirct) {
-    goto statement_129;
-  }
-  j = k - kcirct;
-  goto statement_121;
-  statement_129:
-  j = lphpl1 - k;
-  statement_121:
-  x1 = x(j);
-  y1 = y(j);
-  r1 = r(j);
-  h1 = tb2(j);
-  h2 = unity - 2.0f * h1;
-  if (h1 > 0.f) {
-    skin(cmn, h2, r1, freq, r1, h1);
-  }
-  g1 = gmd(j);
-  ix = itb3(j);
-  izero = 1;
-  xm = 0.f;
-  if (ic(j) == 0 && isegm > 0) {
-    izero = 0;
-  }
-  if (ix < 2) {
-    goto statement_150;
-  }
-  if (ix == 3) {
-    g1 = g1 * dz(j) / 2.0f;
-  }
-  xs = alogz(24.0f * y1 / g1) * onehaf;
-  statement_122:
-  if (ix != 4) {
-    goto statement_125;
-  }
-  xs += h1 / f2 - onehaf * alogz(dz(j) * onehaf / g1);
-  statement_125:
-  i = 0;
-  statement_123:
-  i++;
-  ip++;
-  if (i == k) {
-    goto statement_124;
-  }
-  j = i - kcirct;
-  if (i <= kcirct) {
-    j = lphpl1 - i;
-  }
-  rm = 0.f;
-  if (izero == 0) {
-    goto statement_126;
-  }
-  xm = p(ip) / 4.0f;
-  if (imax < 0) {
-    goto statement_126;
-  }
-  dx = std::abs(x(j) - x1);
-  h2 = y(j) + y1;
-  s = sqrtz(h2 * h2 + dx * dx);
-  z1 = s * f1;
-  if (z1 > 5.0f) {
-    goto statement_151;
-  }
-  //C                    BEGIN CARSON SERIES FOR MUTUAL IMPEDANCE IF Z.LE.5.M14.3312
-  rm = twopi / 16.f;
-  zl = alogz(z1);
-  xm += (valu4 - zl) * onehaf;
-  if (imax == 0) {
-    goto statement_126;
-  }
-  s1 = dx / s;
-  c1 = h2 / s;
-  cs = c1 * z1;
-  sn = s1 * z1;
-  if (imax > 1) {
-    phi = std::asin(s1);
-  }
-  m5 = 0;
-  error = 0.f;
-  statement_1110:
-  k5 = 0;
-  i5 = m5 * 4;
-  statement_1111:
-  k5++;
-  i5++;
-  if (k5 == 1 || k5 == 3) {
-    goto statement_1113;
-  }
-  deltap = ((ccars(i5) - zl) * cs + phi * sn) * bcars(i5);
-  h1 = -dcars(i5) * cs;
-  if (k5 == 4) {
-    goto statement_1114;
-  }
-  deltaq = h1;
-  statement_1004:
-  rm += deltap;
-  xm += deltaq;
-  if (i5 == imax) {
-    goto statement_126;
-  }
-  if (corr > corchk) {
-    goto statement_1005;
-  }
-  if (std::abs(deltap) < corr && std::abs(deltaq) < corr) {
-    goto statement_1115;
-  }
-  error = 0.f;
-  statement_1005:
-  h1 = sn * c1 + cs * s1;
-  cs = (cs * c1 - sn * s1) * z1;
-  sn = h1 * z1;
-  if (k5 < 4) {
-    goto statement_1111;
-  }
-  m5++;
-  goto statement_1110;
-  statement_1113:
-  deltaq = bcars(i5) * cs;
-  deltap = deltaq;
-  if (k5 == 1) {
-    deltap = -deltap;
-  }
-  goto statement_1004;
-  statement_1114:
-  deltaq = -deltap;
-  deltap = h1;
-  goto statement_1004;
-  statement_1115:
-  if (error > onehaf) {
-    goto statement_126;
-  }
-  error = unity;
-  goto statement_1005;
-  //C                      END CARSON SERIES FOR MUTUAL IMPEDANCE IF Z.LE.5.M14.3355
-  //C                                                                       M14.3356
-  //C                    BEGIN CARSON SERIES FOR MUTUAL IMPEDANCE IF Z.GT.5.M14.3357
-  statement_151:
-  s = s * z1;
-  sn = dx / s;
-  cs = h2 / s;
-  s2 = sn * cs * 2.0f;
-  c2 = cs * cs - sn * sn;
-  rm = -c2;
-  FEM_DOSTEP(i5, 1, 7, 2) {
-    rm += ccars(i5) * cs;
-    xm += dcars(i5) * cs;
-    h1 = cs * s2 + sn * c2;
-    cs = cs * c2 - sn * s2;
-    sn = h1;
-  }
-  //C                      END CARSON SERIES FOR MUTUAL IMPEDANCE IF Z.GT.5.M14.3370
-  statement_126:
-  p(ip) = rm * f2;
-  z(ip) = xm * f2;
-  if (iprsup >= 4) {
-    write(lunit6, "(' AT 4439 ',6i10,2e16.6)"), i, k, kfull, kcirct,
-      i5, ip, p(ip), z(ip);
-  }
-  goto statement_123;
-  statement_124:
-  if (imax < 0) {
-    goto statement_128;
-  }
-  r1 = r1 / f2;
-  z1 = y1 * f1 * 2.0f;
-  if (z1 > 5.0f) {
-    goto statement_152;
-  }
-  //C                    BEGIN CARSON SERIES FOR SELF IMPEDANCE IF Z.LE.5.0 M14.3381
-  r1 += twopi / 16.f;
-  zl = alogz(z1);
-  xs += (valu4 - zl) * onehaf;
-  if (imax == 0) {
-    goto statement_127;
-  }
-  m5 = 0;
-  cs = z1;
-  error = 0.f;
-  statement_2110:
-  k5 = 0;
-  i5 = m5 * 4;
-  statement_2111:
-  k5++;
-  i5++;
-  if (k5 == 1 || k5 == 3) {
-    goto statement_2113;
-  }
-  deltap = (ccars(i5) - zl) * bcars(i5) * cs;
-  h1 = -dcars(i5) * cs;
-  if (k5 == 4) {
-    goto statement_2114;
-  }
-  deltaq = h1;
-  statement_2004:
-  r1 += deltap;
-  xs += deltaq;
-  if (i5 == imax) {
-    goto statement_127;
-  }
-  if (corr > corchk) {
-    goto statement_2005;
-  }
-  if (std::abs(deltap) < corr && std::abs(deltaq) < corr) {
-    goto statement_2115;
-  }
-  error = 0.f;
-  statement_2005:
-  cs = cs * z1;
-  if (k5 < 4) {
-    goto statement_2111;
-  }
-  m5++;
-  goto statement_2110;
-  statement_2113:
-  deltaq = bcars(i5) * cs;
-  deltap = deltaq;
-  if (k5 == 1) {
-    deltap = -deltap;
-  }
-  goto statement_2004;
-  statement_2114:
-  deltaq = -deltap;
-  deltap = h1;
-  goto statement_2004;
-  statement_2115:
-  if (error > onehaf) {
-    goto statement_127;
-  }
-  error = unity;
-  goto statement_2005;
-  //C                      END CARSON SERIES FOR SELF IMPEDANCE IF Z.LE.5.0 M14.3418
-  //C                                                                       M14.3419
-  //C                    BEGIN CARSON SERIES FOR SELF IMPEDANCE IF Z.GT.5.0 M14.3420
-  statement_152:
-  cs = unity / z1;
-  c2 = cs * cs;
-  r1 = r1 - c2;
-  FEM_DOSTEP(i5, 1, 7, 2) {
-    r1 += ccars(i5) * cs;
-    xs += dcars(i5) * cs;
-    cs = cs * c2;
-  }
-  //C                      END CARSON SERIES FOR SELF IMPEDANCE IF Z.GT.5.0 M14.3428
-  statement_127:
-  r1 = r1 * f2;
-  statement_128:
-  z(ip) = xs * f2;
-  p(ip) = r1;
-  if (iprsup >= 4) {
-    write(lunit6, "(' AT 4440 ',6i10,2e16.6)"), i, k, kfull, kcirct,
-      i5, ip, p(ip), z(ip);
-  }
-  goto statement_120;
-  statement_150:
-  xs = g1 / f2;
-  if (ix == 1) {
-    xs = xs * freq / 60.0f;
+  //  THE ROWS OF THE Z MATRIX BY LINE_Z (SEE LINE_CONSTANTS.H): FROM THE
+  //  SWEEP EVALUATED AHEAD ON THE STEP THREADS IF FREQ IS ONE OF ITS
+  //  FREQUENCIES.  WHAT SKIN AND IPRSUP .GE. 4 PRINT FOR A ROW FOLLOWS IT.
+  {
+    LineGeometry geometry;
+    line_geometry44(cmn, geometry, kfull, kcirct, lphpl1, isegm, rearth, corr);
+    const LineZ& lz = cmn.line_sweep.z(geometry, freq);
+    FEM_DO_SAFE(k, 1, kfull) {
+      const SkinTrace& trace = lz.skin[k - 1];
+      if (trace.unreliable) {
+        write(lunit6,
+          "(' RESULTS FROM SUBROUTINE SKIN UNRELIABLE WITH MQ**2=',f9.4,"
+          "' AND MR**2=',f9.4)"),
+          trace.q2, trace.r2;
+      }
+      if (trace.kelvin && iprsup >= 1) {
+        write(lunit6, "(' E, F,  E2F2, AND S2 AT 320',4e16.6)"), trace.e,
+          trace.f, trace.e2f2, trace.s2;
+      }
+      FEM_DO_SAFE(i, 1, k) {
+        ip++;
+        p(ip) = lz.r[ip - 1];
+        z(ip) = lz.x[ip - 1];
+        if (lz.terms[ip - 1] >= 0) {
+          i5 = lz.terms[ip - 1];
+        }
+        if (iprsup < 4) {
+          continue;
+        }
+        if (i < k) {
+          write(lunit6, "(' AT 4439 ',6i10,2e16.6)"), i, k, kfull, kcirct,
+            i5, ip, p(ip), z(ip);
+        }
+        else {
+          write(lunit6, "(' AT 4440 ',6i10,2e16.6)"), i, k, kfull, kcirct,
+            i5, ip, p(ip), z(ip);
+        }
+      }
+    }
   }
-  xs += alogz(y1 * 2.0f) * onehaf;
-  g1 = 24.0f * y1 / expz(2.0f * xs);
-  goto statement_122;
-  //C                                                                       M14.3441
   //C                                  ROUTINES FOR Z-PRINTING AND INVERSIONM14.3442
   //C     IMPEDANCE MATRIX FOR PHYSICAL CONDUCTORS IS IN P(1),...P(IP) (REALM14.3443
   //C     PART) AND Z(1)....Z(IP) (IMAGINARY PART).                         M14.3444
@@ -44979,42 +45565,8 @@ void guts44(common& cmn,  // Line Constants
       freq;
   }
   statement_8770:
-  cmn.io.rewind(lunit2);
-  n5 = 0;
   //C     IF ( JDATCS .GT. 0 )  GO TO 8777                                  M43.3397
-  FEM_DO_SAFE(n12, 1, 9999) {
-    {
-      read_loop rloop(cmn, lunit2, "(13a6,a2)");
-      FEM_DO_SAFE(i, 1, 14) {
-        rloop, texta6(i);
-      }
-    }
-    if (ipunch == 0) {
-      {
-        write_loop wloop(cmn, lunit7, "('C ',13a6)");
-        FEM_DO_SAFE(i, 1, 13) {
-          wloop, texta6(i);
-        }
-      }
-    }
-    if (idebug == 0) {
-      goto statement_8100;
-    }
-    {
-      write_loop wloop(cmn, lunit1, "(' C ',13a6,a2)");
-      FEM_DO_SAFE(i, 1, 14) {
-        wloop, texta6(i);
-      }
-    }
-    kount++;
-    statement_8100:
-    if (texta6(1) == blank && texta6(2) == blank) {
-      n5++;
-    }
-    if (n5 >= 1) {
-      goto statement_8777;
-    }
-  }
+  punch_case44(cmn, ipunch, idebug, kount);
   statement_8777:
   if (ialter <= 0) {
     goto statement_3734;
@@ -53416,8 +53968,8 @@ zegen(
   int const& isyst) try
 {
   common_write write(cmn);
-  auto& bin = cmn.bin;
-  auto& bkn = cmn.bkn;
+  arr_1d<20, std::complex<double> > bin(fem::fill0);
+  arr_1d<20, std::complex<double> > bkn(fem::fill0);
   double& fzero = cmn.fzero;
   double& pai = cmn.pai;
   int& logsix = static_cast<common_com47&>(cmn).logsix;
@@ -53475,6 +54027,7 @@ zegen(
   double verbin = fem::double0;
   double p1 = fem::double0;
   double q1 = fem::double0;
+  const double* terms = nullptr;
   unity = 1.0f;
   c1 = cmplxz(cmn.u2p, fzero);
   cj = cmn.cimag1;
@@ -53527,6 +54080,9 @@ zegen(
       "'IMAG-XE',19x,'W',19x,'E',/,1x,4e20.11)"),
       isyst, ixa, be1, be2, xa, th, xa1, xe, w, e;
   }
+  //  THE COS AND SIN OF THE MULTIPLES OF TH FROM CABLE_TERMS IF GUTS47
+  //  FILLED THEM FOR TH (SEE CABLE_CONSTANTS.H)
+  terms = cmn.cable_terms.angle_terms(th);
   if (e > 5.f) {
     goto statement_60;
   }
@@ -53547,12 +54103,22 @@ zegen(
     t = i - 1;
     t1 = t * 2.f;
     t2 = t * 4.f;
+    if (terms != nullptr) {
+      cs1 = terms[6 * (i - 1)];
+      ss1 = terms[6 * (i - 1) + 1];
+      cs2 = terms[6 * (i - 1) + 2];
+      ss2 = terms[6 * (i - 1) + 3];
+      cs3 = terms[6 * (i - 1) + 4];
+      cs4 = terms[6 * (i - 1) + 5];
+      goto statement_25;
+    }
     cs1 = cosz((t2 + 2.f) * th);
     ss1 = sinz((t2 + 2.f) * th);
     cs2 = cosz((t2 + 4.f) * th);
     ss2 = sinz((t2 + 4.f) * th);
     cs3 = cosz((t2 + 1.f) * th);
     cs4 = cosz((t2 + 3.f) * th);
+    statement_25:
     if (i > 1) {
       goto statement_30;
     }
@@ -53602,10 +54168,18 @@ zegen(
     4.f - b4 + sq2 * (b1 + b3);
   goto statement_70;
   statement_60:
+  if (terms != nullptr) {
+    cs1 = terms[6 * CableTerms::series];
+    cs2 = terms[6 * CableTerms::series + 1];
+    cs3 = terms[6 * CableTerms::series + 2];
+    cs4 = terms[6 * CableTerms::series + 3];
+    goto statement_65;
+  }
   cs1 = sq2 * cosz(th);
   cs2 = cosz(2.f * th) * 2.f;
   cs3 = sq2 * cosz(3.f * th);
   cs4 = 3.f * sq2 * cosz(5.f * th);
+  statement_65:
   p1 = (cs1 + (cs4 / fem::pow3(e) + cs3 / e - cs2) / e) / e;
   q1 = (cs1 + (cs4 / fem::pow2(e) - cs3) / fem::pow2(e)) / e;
   statement_70:
@@ -54154,8 +54728,8 @@ sczy2(
   al3i(dimension(ldm));
   zc(dimension(ldn, ldn));
   common_write write(cmn);
-  auto& bin = cmn.bin;
-  auto& bkn = cmn.bkn;
+  arr_1d<20, std::complex<double> > bin(fem::fill0);
+  arr_1d<20, std::complex<double> > bkn(fem::fill0);
   std::complex<double>& czero = cmn.czero;
   double& fzero = cmn.fzero;
   double& u2p = cmn.u2p;
@@ -54475,8 +55049,8 @@ ptzy2(
   zp(dimension(ldn, ldn));
   zpc(dimension(ldn, ldn));
   common_write write(cmn);
-  auto& bin = cmn.bin;
-  auto& bkn = cmn.bkn;
+  arr_1d<20, std::complex<double> > bin(fem::fill0);
+  arr_1d<20, std::complex<double> > bkn(fem::fill0);
   std::complex<double>& czero = cmn.czero;
   double& e2p = cmn.e2p;
   const auto& radp = cmn.radp;
@@ -54535,6 +55109,7 @@ ptzy2(
   double d1 = fem::double0;
   double d2 = fem::double0;
   int nc1 = fem::int0;
+  const double* terms = nullptr;
   unity = 1.0f;
   contwo = 2.0f;
   c3 = cmplxz(usp, fzero);
@@ -54611,10 +55186,17 @@ ptzy2(
       if (dci(i) * dci(j) < 1.e-6f) {
         goto statement_21;
       }
+      //  DR0**K * COS(K*TH0) FROM CABLE_TERMS IF GUTS47 FILLED THEM
+      terms = cmn.cable_terms.pipe_terms(dr0(i, j), th0(i, j));
       FEM_DO_SAFE(k, 1, nbess) {
         k1 = k + 1;
         ak = k;
-        ck = fem::pow(dr0(i, j), k) * cosz(ak * th0(i, j));
+        if (terms != nullptr) {
+          ck = terms[k - 1];
+        }
+        else {
+          ck = fem::pow(dr0(i, j), k) * cosz(ak * th0(i, j));
+        }
         c1 = cmplxz(ck, fzero);
         c9 = ak * (usp + 1.f);
         c2 = cmplxz(c9, fzero);
@@ -54740,8 +55322,8 @@ skin47(
   std::complex<double>& zcc) try
 {
   common_write write(cmn);
-  auto& bin = cmn.bin;
-  auto& bkn = cmn.bkn;
+  arr_1d<20, std::complex<double> > bin(fem::fill0);
+  arr_1d<20, std::complex<double> > bkn(fem::fill0);
   double& fzero = cmn.fzero;
   int& logsix = static_cast<common_com47&>(cmn).logsix;
   int& iprs47 = cmn.iprs47;
@@ -55282,6 +55864,64 @@ zymx(
       nw, isyst, cmn.np2, itypec, numaki, cmn.npc, cmn.ncc, izflag,
       iyflag, w;
   }
+  //  UNLESS THEY PRINT, ZS, ZE, ZC, ZP AND ZPC OF OLZY, SCZY1, SCZY2 AND
+  //  PTZY2 FROM THE SWEEP EVALUATED AHEAD ON THE STEP THREADS IF W IS ONE
+  //  OF ITS FREQUENCIES (SEE CABLE_CONSTANTS.H)
+  if (iprs47 < 1) {
+    const CableZ& parts = cmn.cable_sweep.z(w,
+      [&](double const& wk, CableZ& z) {
+      arr<std::complex<double>, 2> zsk(dimension(ldn, ldn), fem::fill0);
+      arr<std::complex<double>, 2> zek(dimension(ldn, ldn), fem::fill0);
+      arr<std::complex<double>, 2> zck(dimension(ldn, ldn), fem::fill0);
+      arr<std::complex<double>, 2> zpk(dimension(ldn, ldn), fem::fill0);
+      arr<std::complex<double>, 2> zpck(dimension(ldn, ldn), fem::fill0);
+      std::complex<double> const sk = cmplxz(fzero, wk);
+      switch (itypec) {
+        case 2:
+          sczy1(cmn, wk, isyst, zy, dir, dij, ang, hi, di, zsk, zek, ldm, ldn);
+          sczy2(cmn, sk, ncpp, radi, usi, usr, bio, bi1, bi2, bi3, bi4, bi5,
+            al1i, al2i, al3i, zck, ldm, ldn);
+          break;
+        case 3:
+          if (npp != 0) {
+            sczy1(cmn, wk, isyst, zy, dir, dij, ang, hi, di, zsk, zek, ldm, ldn);
+          }
+          sczy2(cmn, sk, ncpp, radi, usi, usr, bio, bi1, bi2, bi3, bi4, bi5,
+            al1i, al2i, al3i, zck, ldm, ldn);
+          ptzy2(cmn, sk, ncpp, dci, dr0, th0, al0, zpk, zpck, ldm, ldn);
+          break;
+        default:
+          olzy(cmn, wk, ncpp, zy, dij, ang, usi, usr, esi, hi, di, zsk, zek,
+            zck, ldm, ldn);
+          break;
+      }
+      z.w = wk;
+      z.resize(std::size_t(nw));
+      int ik = fem::int0;
+      int jk = fem::int0;
+      FEM_DO_SAFE(jk, 1, nw) {
+        FEM_DO_SAFE(ik, 1, nw) {
+          std::size_t const ij = std::size_t(ik - 1) + z.n * std::size_t(jk - 1);
+          z.zs[ij] = zsk(ik, jk);
+          z.ze[ij] = zek(ik, jk);
+          z.zc[ij] = zck(ik, jk);
+          z.zp[ij] = zpk(ik, jk);
+          z.zpc[ij] = zpck(ik, jk);
+        }
+      }
+    });
+    FEM_DO_SAFE(j, 1, nw) {
+      FEM_DO_SAFE(i, 1, nw) {
+        std::size_t const ij = std::size_t(i - 1) + parts.n * std::size_t(j - 1);
+        zs(i, j) = parts.zs[ij];
+        ze(i, j) = parts.ze[ij];
+        zc(i, j) = parts.zc[ij];
+        zp(i, j) = parts.zp[ij];
+        zpc(i, j) = parts.zpc[ij];
+      }
+    }
+    goto statement_800;
+  }
   switch (itypec) {
     case 1: goto statement_710;
     case 2: goto statement_720;
@@ -56897,6 +57537,7 @@ guts47(
     write(lunit2, format_4230), bufsem;
   }
   read(abuff, format_902), d9, freq, ik, ips, dist, j13, j14;
+  cmn.cable_sweep.clear();
   ipunch = j13;
   roe = d9;
   itrnsf = j14;
@@ -57513,6 +58154,17 @@ guts47(
       }
     }
   }
+  //  THE TERMS OF ZEGEN AND PTZY2 THAT DEPEND ON THE GEOMETRY ONLY, ONCE
+  //  BEFORE ITS FREQUENCIES (SEE CABLE_CONSTANTS.H)
+  cmn.cable_terms.clear();
+  FEM_DO_SAFE(i, 1, npc) {
+    FEM_DO_SAFE(j, i, npc) {
+      cmn.cable_terms.angle(ang(i, j));
+      if (itypec == 3) {
+        cmn.cable_terms.pipe(dr0(i, j), th0(i, j));
+      }
+    }
+  }
   iprint = 0;
   statement_9003:
   statement_706:
@@ -57589,6 +58241,7 @@ guts47(
   write(6, star), " guts47.   Below S.N. 7456, VOLTBC(6) = ", voltbc(6);
   dist = 0.0f;
   cmn.icheck = iprint - 1;
+  cmn.cable_sweep.plan(fdecad, factor, ik, ips, twopi);
   goto statement_3007;
   statement_3005:
   iii++;
@@ -57718,6 +58371,7 @@ guts47(
     write(lunit2, format_4230), bufsem;
   }
   read(abuff, format_902), d9, freq, ik, ips, dist, j13, j14;
+  cmn.cable_sweep.clear();
   freqsv = freq;
   if (d9 != 0.f) {
     goto statement_3899;
@@ -64851,6 +65505,7 @@ subr51(
     default: break;
   }
   statement_6001:
+  cmn.list_overflow = lstat(16);
   write(lunit6,
     "(5x,'STORAGE EXCEEDED FOR LIST NUMBER ',i2,"
     "'.   SEE DIMENSIONED LIMIT IN TABULATION BELOW.',/,5x,"
@@ -70148,6 +70803,77 @@ over55(
     "(5x,'SIZE LIST 5.   STORAGE FOR (Y) AND',' TRIANGULARIZED (Y).',6x,"
     "'NO. TIMES =',i5,3x,'FACTORS =',i5,2x,2i10,' (LYMAT)')"),
     ktrlsw(3), iprsov(36), lstat(25), cmn.lymat;
+  if (cmn.node_ordering != 0) {
+    write(lunit6,
+      "(20x,'NODE ORDERING NODORD =',i2,'.   FACTOR TERMS =',i10,"
+      "'   FILL-IN =',i10,'   ORDERING',f11.6,' SEC.')"),
+      cmn.node_ordering, int(cmn.factor_terms), int(cmn.factor_fill),
+      cmn.order_seconds;
+  }
+  {
+    auto const& r = cmn.refactor;
+    write(lunit6,
+      "(20x,'TRIANGULARIZATIONS OF (Y):  FULL',i8,' IN',f11.6,' SEC.   PARTIAL',"
+      "i8,' IN',f11.6,' SEC.   ROWS',i10,' OF',i10)"),
+      int(r.full()), r.full_seconds(), int(r.partial()), r.partial_seconds(),
+      int(r.partial_rows()), int(r.partial_total());
+  }
+  if (cmn.ysolve.steps() > 0) {
+    auto const& y = cmn.ysolve;
+    write(lunit6,
+      "(20x,'NETWORK PARTITIONS:',i7,'   NODES',i8,' TO',i8,'   STEPS',i9,"
+      "'   CHUNKS',i3)"),
+      int(y.partitions()), y.smallest_partition(), y.largest_partition(),
+      int(y.steps()), int(y.chunks());
+    FEM_DO_SAFE(i, 1, int(y.chunks())) {
+      auto const t = y.timing(i - 1);
+      if (y.timed()) {
+        write(lunit6,
+          "(25x,'CHUNK',i3,':  PARTITIONS',i7,' TO',i7,'   NODES',i8,"
+          "'   NS PER STEP',f12.1)"),
+          i, int(t.first + 1), int(t.last), t.nodes, t.ns_per_step;
+      }
+      else {
+        write(lunit6,
+          "(25x,'CHUNK',i3,':  PARTITIONS',i7,' TO',i7,'   NODES',i8)"),
+          i, int(t.first + 1), int(t.last), t.nodes;
+      }
+    }
+  }
+  if (cmn.factor_cache.enabled()) {
+    auto const& c = cmn.factor_cache;
+    write(lunit6,
+      "(20x,'FACTOR CACHE:  HITS',i8,'   MISSES',i8,'   ENTRIES',i6,"
+      "'   KBYTES',i10,' OF',i10)"),
+      int(c.hits()), int(c.misses()), int(c.entries()),
+      int(c.bytes() >> 10), int(c.budget() >> 10);
+  }
+  if (!cmn.cable_sweep.blocks().empty()) {
+    auto const& c = cmn.cable_sweep;
+    write(lunit6,
+      "(20x,'CABLE CONSTANTS SWEEP:  Z MATRICES',i8,' IN',f11.6,' SEC.',"
+      "'   THREADS',i4)"),
+      int(c.matrices()), c.seconds(), c.threads();
+    FEM_DO_SAFE(i, 1, int(c.blocks().size())) {
+      auto const& b = c.blocks()[i - 1];
+      write(lunit6,
+        "(25x,'BLOCK',i4,':  FREQ',e13.5,' TO',e13.5,' HZ   MATRICES',i6,"
+        "' IN',f11.6,' SEC.')"),
+        i, b.first, b.last, int(b.count), b.seconds;
+    }
+  }
+  cmn.cable_sweep.reset();
+  if (cmn.tacs_code.calls() > 0) {
+    auto const& c = cmn.tacs_code;
+    write(lunit6,
+      "(20x,'TACS SUPPLEMENTALS:  COMPILED',i6,'   INTERPRETED',i6,"
+      "'   INSTRUCTIONS',i8,'   CSUP',i10,' CALLS')"),
+      c.compiled(), c.interpreted(), int(c.instructions()), int(c.calls());
+    if (c.timed()) {
+      write(lunit6, "(20x,'CSUP IN',f11.6,' SEC.')"), c.seconds();
+    }
+  }
+  cmn.tacs_code.reset();
   write(lunit6,
     "(5x,'SIZE LIST 6.   NUMBER OF ENTRIES IN',' SWITCH TABLE.',15x,"
     "'NO. FLOPS =',i6,14x,2i10,' (LSWTCH)')"),
@@ -70160,6 +70886,14 @@ over55(
     "(5x,'SIZE LIST 8.   NUMBER OF PAST HISTORY POINTS FOR DISTRIBUTED LINES.'"
     ",28x,2i10,' (LPAST)')"),
     lstat(28), cmn.lpast;
+  if (cmn.lines.steps() > 0) {
+    auto const& h = cmn.lines;
+    write(lunit6,
+      "(20x,'LINE HISTORY RINGS:  MODES',i7,'   RINGS',i5,'   STEPS',i9,"
+      "'   NS PER MODE-STEP',f9.2,'   CHUNKS',i3)"),
+      int(h.modes()), int(h.rings()), int(h.steps()), h.ns_per_mode_step(),
+      int(h.chunks());
+  }
   write(lunit6,
     "(5x,'SIZE LIST 9.   NUMBER OF NONLINEAR ELEMENTS.',51x,2i10,' (LNONL)')"),
     lstat(29), cmn.lnonl;
@@ -70167,6 +70901,14 @@ over55(
     "(5x,'SIZE LIST 10.  NUMBER OF POINTS DEFINING NONLINEAR CHARACTERISTICS.'"
     ",28x,2i10,' (LCHAR)')"),
     lstat(30), cmn.lchar;
+  if (cmn.zno.solutions() > 0) {
+    auto const& z = cmn.zno;
+    write(lunit6,
+      "(20x,'ZNO NEWTON:  SOLUTIONS',i8,'   ITERATIONS',i9,'   MAX',i4,"
+      "'   MAX ABS(DV / ZNVREF)',e11.3,'   INVERSES',i7,'   REUSED',i8)"),
+      int(z.solutions()), int(z.iterations()), z.max_iterations(), z.max_dv(),
+      int(z.inverted()), int(z.reused());
+  }
   write(lunit6,
     "(5x,'SIZE LIST 11.  NUMBER OF BRANCH OR SELECTIVE-NODE-VOLTAGE OUTPUTS.',"
     "29x,2i10,' (LSMOUT)')"),
@@ -71635,6 +72377,220 @@ struct program_main_save
   {}
 };
 
+// The saved locals of the subroutines of this file in a snapshot (see
+// snapshot_step), in the order of their definition.
+void snapshot_saves_1(
+  Snapshot& s,
+  common& cmn) try
+{
+  if (auto* v = s.saved<tables_save>(cmn.tables_sve, "tables")) {
+    s(v->iprsav);
+  }
+  if (auto* v = s.saved<frefld_save>(cmn.frefld_sve, "frefld")) {
+    s(v->chtacs);
+  }
+  if (auto* v = s.saved<cimage_save>(cmn.cimage_sve, "cimage")) {
+    s(v->charc, v->chtacs, v->jpntr, v->n11, v->n12, v->n13, v->n8, v->text4,
+      v->text5, v->textax, v->textay);
+  }
+  if (auto* v = s.saved<namea6_save>(cmn.namea6_sve, "namea6")) {
+    s(v->n17, v->text2);
+  }
+  if (auto* v = s.saved<tacs1a_save>(cmn.tacs1a_sve, "tacs1a")) {
+    s(v->alnrcl, v->ch9, v->cha, v->chd, v->chdolr, v->che, v->chg, v->chl,
+      v->chn, v->cho, v->chq, v->chr, v->cht, v->comma, v->eqlsgn, v->opname,
+      v->sepch, v->sminus, v->smultp, v->splus, v->supfn, v->supop, v->text1,
+      v->text4, v->text5, v->text6, v->text7);
+  }
+  if (auto* v = s.saved<tacs1b_save>(cmn.tacs1b_sve, "tacs1b")) {
+    s(v->delay);
+  }
+  if (auto* v = s.saved<tacs1_save>(cmn.tacs1_sve, "tacs1")) {
+    s(v->sbn, v->sminus, v->splus, v->stacs);
+  }
+  if (auto* v = s.saved<spyout_save>(cmn.spyout_sve, "spyout")) {
+    s(v->filbyt, v->fkar1, v->fkar2, v->forbyt, v->j, v->k, v->n11, v->n12,
+      v->pltbuf, v->terra, v->text10);
+  }
+  if (auto* v = s.saved<spyink_save>(cmn.spyink_sve, "spyink")) {
+    s(v->d12, v->d13, v->d13z, v->d14, v->d15, v->d17, v->d18, v->d24, v->d8,
+      v->filbyt, v->fkar1, v->fkar2, v->forbyt, v->i, v->ioutcs, v->ip, v->j,
+      v->k, v->kaliu, v->kiuty, v->klntab, v->kofsce, v->koncur, v->konsce,
+      v->konsup, v->kontot, v->kptplt, v->kud1, v->kud2, v->kud3, v->kxtcs,
+      v->L, v->lunit6, v->m, v->mmfind, v->mmhold, v->mstrng, v->n1, v->n11,
+      v->n12, v->n13, v->n14, v->n15, v->n16, v->n17, v->n18, v->n2, v->n22,
+      v->n23, v->n24, v->n3, v->n33, v->n4, v->n42, v->n43, v->n5, v->n6,
+      v->n66, v->n7, v->n77, v->n8, v->n9, v->ndx1, v->ndx2, v->ndx3, v->ndx4,
+      v->niu, v->nsmout, v->nsup, v->nuk, v->numnv0, v->pltbuf, v->text1,
+      v->text2);
+  }
+  if (auto* v = s.saved<setrtm_save>(cmn.setrtm_sve, "setrtm")) {
+    s(v->alltim, v->averag, v->back, v->batch, v->buslst, v->char20, v->choice,
+      v->column, v->cursor, v->d1, v->d6, v->debug, v->end, v->extrem,
+      v->filbyt, v->file30, v->fkar1, v->fkar2, v->flush, v->forbyt, v->help,
+      v->ibrnch, v->ibsout, v->inner, v->ip, v->j, v->jbrnch, v->jj, v->label,
+      v->lastpl, v->level, v->limits, v->linezz, v->longer, v->lunt15,
+      v->messag, v->metric, v->multip, v->n1, v->n2, v->n22, v->n23, v->noplot,
+      v->offset, v->out, v->pen, v->photo, v->playba, v->pltbuf, v->printe,
+      v->punch, v->purge, v->refile, v->repeat, v->rescal, v->setcol, v->setdat,
+      v->show, v->size, v->slope, v->smooth, v->stack, v->stop, v->tek,
+      v->texblk, v->timesp, v->timeun, v->xyplot);
+  }
+  if (auto* v = s.saved<chrplt_save>(cmn.chrplt_sve, "chrplt")) {
+    s(v->alltim, v->averag, v->back, v->batch, v->buslst, v->char20, v->choice,
+      v->column, v->cursor, v->d1, v->d2, v->d3, v->debug, v->din1, v->din2,
+      v->dol, v->dt, v->end, v->extrem, v->filbyt, v->file30, v->fkar1,
+      v->fkar2, v->flush, v->forbyt, v->help, v->hmax, v->hmin, v->ibrnch,
+      v->ibsout, v->idat, v->inch, v->inner, v->ip, v->j, v->j1, v->jbrnch,
+      v->k, v->kunit6, v->kwtspy, v->kzero, v->L, v->label, v->lastpl,
+      v->letter, v->level, v->limcol, v->limits, v->linepr, v->linezz,
+      v->longer, v->m, v->messag, v->metric, v->mu6std, v->multip, v->n4,
+      v->noplot, v->numtit, v->offset, v->out, v->pen, v->photo, v->playba,
+      v->pltbuf, v->printe, v->punch, v->purge, v->refile, v->repeat, v->rescal,
+      v->setcol, v->setdat, v->show, v->size, v->slope, v->smooth, v->stack,
+      v->stop, v->t, v->tek, v->temp, v->texblk, v->timesp, v->timeun, v->vmax,
+      v->vmin, v->vspan, v->xyplot);
+  }
+  if (auto* v = s.saved<tpplot_save>(cmn.tpplot_sve, "tpplot")) {
+    s(v->alltim, v->averag, v->back, v->batch, v->buslst, v->char20, v->choice,
+      v->column, v->cursor, v->debug, v->end, v->extrem, v->filbyt, v->file30,
+      v->fkar1, v->fkar2, v->flush, v->forbyt, v->help, v->hmax, v->hmin, v->i,
+      v->ibrnch, v->ibsout, v->ihs, v->inner, v->j, v->jbrnch, v->k, v->kill,
+      v->L, v->label, v->lastpl, v->level, v->limcol, v->limits, v->linezz,
+      v->longer, v->ltek, v->m, v->messag, v->metric, v->mline, v->multip,
+      v->n1, v->noplot, v->numbco, v->numnam, v->numnvo, v->numout, v->nv,
+      v->offset, v->out, v->pen, v->photo, v->playba, v->pltbuf, v->printe,
+      v->punch, v->purge, v->refile, v->repeat, v->rescal, v->setcol, v->setdat,
+      v->show, v->size, v->slope, v->smooth, v->stack, v->stop, v->tek,
+      v->texblk, v->timesp, v->timeun, v->xyplot);
+  }
+  if (auto* v = s.saved<spying_save>(cmn.spying_sve, "spying")) {
+    s(v->chard7, v->d1, v->d13, v->d2, v->d3, v->d34, v->d4, v->d5, v->d6,
+      v->d8, v->filbyt, v->fkar1, v->fkar2, v->forbyt, v->i, v->icomm,
+      v->idmxxx, v->ind, v->intype, v->j, v->jwdsav, v->k, v->k1, v->k2, v->k3,
+      v->kansav, v->khead, v->kp, v->L, v->m, v->n1, v->n10, v->n12, v->n13,
+      v->n14, v->n15, v->n16, v->n17, v->n18, v->n2, v->n22, v->n23, v->n24,
+      v->n26, v->n27, v->n33, v->n4, v->n5, v->n6, v->n7, v->n8, v->n9,
+      v->nchd2, v->num2, v->num3, v->num5, v->numask, v->numbco, v->numbrn,
+      v->numnam, v->pltbuf, v->spdate, v->spytim, v->tim1rp, v->tim2rp,
+      v->twhen, v->val1rp, v->val2rp, v->xl);
+  }
+  if (auto* v = s.saved<emtspy_save>(cmn.emtspy_sve, "emtspy")) {
+    s(v->filbyt, v->fkar1, v->fkar2, v->forbyt, v->n18, v->pltbuf);
+  }
+  if (auto* v = s.saved<initsp_save>(cmn.initsp_sve, "initsp")) {
+    s(v->textay);
+  }
+  if (auto* v = s.saved<datain_save>(cmn.datain_sve, "datain")) {
+    s(v->dumnam, v->filsav, v->komlev, v->lentyp, v->nchpre, v->nchsuf,
+      v->numhld, v->numtyp, v->typdat);
+  }
+  if (auto* v = s.saved<plotng_save>(cmn.plotng_sve, "plotng")) {
+    s(v->kdig, v->klank, v->kom, v->ktsin, v->kut);
+  }
+  if (auto* v = s.saved<innr29_save>(cmn.innr29_sve, "innr29")) {
+    s(v->normal, v->texnam, v->text1, v->text2, v->text3, v->text4, v->text5,
+      v->text6, v->text7, v->text8);
+  }
+  if (auto* v = s.saved<fltdat_save>(cmn.fltdat_sve, "fltdat")) {
+    s(v->chara, v->charb, v->charc, v->charq, v->kblank, v->kfill, v->korig);
+  }
+  if (auto* v = s.saved<statrs_save>(cmn.statrs_sve, "statrs")) {
+    s(v->c1);
+  }
+  if (auto* v = s.saved<guts29_save>(cmn.guts29_sve, "guts29")) {
+    s(v->text1, v->text2, v->text3, v->text5, v->text6, v->text7);
+  }
+  if (auto* v = s.saved<axis_save>(cmn.axis_sve, "axis")) {
+    s(v->hgt1, v->hgt2, v->hgt3, v->text1, v->tic, v->ticd2);
+  }
+  if (auto* v = s.saved<linplt_save>(cmn.linplt_sve, "linplt")) {
+    s(v->k, v->klank, v->kline, v->kom, v->ktsin, v->kut, v->kxline, v->max5,
+      v->min5);
+  }
+  if (auto* v = s.saved<subr31_save>(cmn.subr31_sve, "subr31")) {
+    s(v->kscale, v->ll0, v->ll1, v->ll10, v->ll16, v->ll18, v->ll2, v->ll24,
+      v->ll3, v->ll6, v->ll78, v->llmin1, v->llmin3, v->text1, v->text10,
+      v->text11, v->text12, v->text13, v->text14, v->text15, v->text16,
+      v->text18, v->text19, v->text2, v->text20, v->text22, v->text23,
+      v->text24, v->text25, v->text26, v->text27, v->text28, v->text29,
+      v->text3, v->text30, v->text31, v->text32, v->text33, v->text4, v->text5,
+      v->text6, v->text7, v->text8, v->text9, v->textax);
+  }
+  if (auto* v = s.saved<ftplot_save>(cmn.ftplot_sve, "ftplot")) {
+    s(v->blank, v->text1, v->text2, v->text3);
+  }
+  if (auto* v = s.saved<misc39_save>(cmn.misc39_sve, "misc39")) {
+    s(v->text1, v->text2, v->text3, v->text4);
+  }
+  if (auto* v = s.saved<subr39_save>(cmn.subr39_sve, "subr39")) {
+    s(v->text1, v->text10, v->text11, v->text12, v->text13, v->text14,
+      v->text15, v->text2, v->text3, v->text4, v->text5, v->text6, v->text7,
+      v->text8, v->text9);
+  }
+  if (auto* v = s.saved<unwind_save>(cmn.unwind_sve, "unwind")) {
+    s(v->bom, v->kunf);
+  }
+  if (auto* v = s.saved<modal_save>(cmn.modal_sve, "modal")) {
+    s(v->iseq, v->text10, v->text2, v->text3, v->text4, v->text5, v->text6,
+      v->text7, v->text8, v->text9);
+  }
+  if (auto* v = s.saved<output_save>(cmn.output_sve, "output")) {
+    s(v->txtkm, v->txtmi);
+  }
+  if (auto* v = s.saved<guts44_save>(cmn.guts44_sve, "guts44")) {
+    s(v->englis, v->fmetrc, v->mrr, v->nrp, v->text1, v->text2, v->text3,
+      v->text4, v->text5, v->text6, v->text7, v->text8, v->text9);
+  }
+  if (auto* v = s.saved<xift_save>(cmn.xift_sve, "xift")) {
+    s(v->n1);
+  }
+  if (auto* v = s.saved<tdfit_save>(cmn.tdfit_sve, "tdfit")) {
+    s(v->text7, v->text8, v->text9);
+  }
+  if (auto* v = s.saved<guts45_save>(cmn.guts45_sve, "guts45")) {
+    s(v->text1, v->text10, v->text11, v->text12, v->text13, v->text14,
+      v->text15, v->text16, v->text17, v->text2, v->text3, v->text5, v->text6);
+  }
+  if (auto* v = s.saved<print_save>(cmn.print_sve, "print")) {
+    s(v->text1, v->text2);
+  }
+  if (auto* v = s.saved<prcon_save>(cmn.prcon_sve, "prcon")) {
+    s(v->iseq);
+  }
+  if (auto* v = s.saved<guts47_save>(cmn.guts47_sve, "guts47")) {
+    s(v->text1, v->text2, v->text3);
+  }
+  s.saved<blockdata_unnamed_save>(cmn.blockdata_unnamed_sve, "blockdata_unnamed");
+  s.saved<blockdata_blkplt_save>(cmn.blockdata_blkplt_sve, "blockdata_blkplt");
+  if (auto* v = s.saved<bctran_save>(cmn.bctran_sve, "bctran")) {
+    s(v->maxit);
+  }
+  if (auto* v = s.saved<over41_save>(cmn.over41_sve, "over41")) {
+    s(v->t1, v->t2, v->t3, v->text10, v->text11, v->text12, v->text9, v->typec);
+  }
+  if (auto* v = s.saved<hysdat_save>(cmn.hysdat_sve, "hysdat")) {
+    s(v->ibot, v->itop);
+  }
+  if (auto* v = s.saved<arrdat_save>(cmn.arrdat_sve, "arrdat")) {
+    s(v->text1, v->text2, v->text3, v->text4, v->text55, v->text92, v->textb);
+  }
+  if (auto* v = s.saved<subr51_save>(cmn.subr51_sve, "subr51")) {
+    s(v->kpen);
+  }
+  if (auto* v = s.saved<subr55_save>(cmn.subr55_sve, "subr55")) {
+    s(v->text1, v->text11, v->text12, v->text13, v->text14, v->text15,
+      v->text16, v->text17, v->text18, v->text19, v->text2, v->text3, v->text4,
+      v->text5);
+  }
+  if (auto* v = s.saved<program_main_save>(cmn.program_main_sve, "program_main")) {
+    s(v->ll34);
+  }
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
 void fildel(
   common& cmn,
   int const lun)
@@ -71680,20 +72636,322 @@ public:
   }
 };
 
-inline common& Comm()
+Simulation::Simulation()
+{
+  reset();
+}
+
+Simulation::~Simulation() = default;
+
+void Simulation::reset()
+{
+  reset(scale_ > 0 ? std::min(scale_, int(max_table_scale)) : run_scale_);
+}
+
+void Simulation::reset(int scale)
 {
   static char const* argv[] = { "test" };
-  static common comm(1, argv);
-  return comm;
-};
+  // release the old context first so its pages are returned before the
+  // new (demand-zero) COMMON blocks are mapped
+  cmn_.reset();
+  int const saved = emtp::table_scale();
+  emtp::table_scale() = scale;
+  try {
+    cmn_ = std::make_unique<common>(1, argv);
+  }
+  catch (...) {
+    emtp::table_scale() = saved;
+    throw;
+  }
+  emtp::table_scale() = saved;
+  run_scale_ = scale;
+  used_ = false;
+}
+
+// Stock lists hold some 3000 nodes and branches, and every branch, source
+// or switch takes a card of its own; so the cards of the deck bound the
+// size of its network from above.
+int Simulation::deck_table_scale(const std::string& inpFile)
+{
+  long const ncards = DeckReader::count_cards(inpFile);
+  int scale = 1;
+  while (ncards > 3000L * scale && scale < max_table_scale) {
+    scale *= 2;
+  }
+  return scale;
+}
+
+void Simulation::run(
+  const std::string& inpFile,
+  const std::string& logFile,
+  const std::string& outFile)
+{
+  int scale = scale_ > 0 ? std::min(scale_, int(max_table_scale))
+    : deck_table_scale(inpFile);
+  if (!restart_file_.empty()) {
+    scale = Snapshot::peek(restart_file_).scale;  // the lists of the snapshot
+  }
+  for (;;) {
+    if (used_ || scale != run_scale_) {
+      reset(scale);  // never let a case see the COMMON or *_sve state of the last
+    }
+    used_ = true;
+    run_once(inpFile, logFile, outFile);
+    // a list overflow kills the case: grow all lists and run the deck again
+    int const list = cmn_->list_overflow;
+    if (list == 0 || scale >= max_table_scale) {
+      return;
+    }
+    std::cout << "EMTP list " << list << " exceeded at scale " << scale
+      << ", run again at scale " << 2 * scale << std::endl;
+    scale *= 2;
+  }
+}
+
+void Simulation::run_once(
+  const std::string& inpFile,
+  const std::string& logFile,
+  const std::string& outFile)
+{
+  // DIMENS reads the scale of this context
+  struct ScaleGuard {
+    int saved = emtp::table_scale();
+    ~ScaleGuard() { emtp::table_scale() = saved; }
+  } guard;
+  emtp::table_scale() = run_scale_;
+  cmn_->plot_format = plot_format_;
+  cmn_->solve_mode = solve_mode_;
+  cmn_->network_partitions = network_partitions_;
+  cmn_->ysolve.partitioned(network_partitions_);
+  cmn_->ysolve.timed(solve_timed_);
+  cmn_->partial_refactor = partial_refactor_;
+  cmn_->factor_cache.budget(std::size_t(std::max(factor_cache_mb_, 0)) << 20);
+  cmn_->line_history = line_history_;
+  cmn_->fd_convolution = fd_convolution_;
+  cmn_->tacs_code.enabled(tacs_bytecode_);
+  cmn_->tacs_code.timed(tacs_timed_);
+  int step_threads = step_threads_;
+  if (step_threads <= 0) {
+    step_threads = std::max(int(std::thread::hardware_concurrency()), 1);
+  }
+  cmn_->step_pool.resize(step_threads);
+  cmn_->lines.pool(&cmn_->step_pool);
+  cmn_->ysolve.pool(&cmn_->step_pool);
+  cmn_->line_sweep.pool(&cmn_->step_pool);
+  cmn_->cable_sweep.pool(&cmn_->step_pool);
+  cmn_->plot.pipeline(step_threads > 1);
+  cmn_->snapshots.times = snapshot_times_;
+  std::sort(cmn_->snapshots.times.begin(), cmn_->snapshots.times.end());
+  cmn_->snapshots.base = outFile;
+  cmn_->snapshots.restart = restart_file_;
+  cmn_->snapshots.deck = inpFile;
+  if (!sweep_file_.empty()) {
+    cmn_->sweep.variants = read_sweep(sweep_file_);
+  }
+  for (auto& d : plot_decimation_) {
+    cmn_->plot.decimate(d.first, d.second);
+  }
+  int nthreads = nthreads_;
+  if (nthreads <= 0) {
+    nthreads = std::max(int(std::thread::hardware_concurrency()), 1);
+  }
+  EnergizationPlan plan(inpFile, nthreads, run_scale_);
+  cmn_->energ_plan = &plan;
+  try {
+    program_main(*cmn_, inpFile, logFile, outFile);
+  }
+  catch (...) {
+    cmn_->energ_plan = nullptr;
+    throw;
+  }
+  cmn_->energ_plan = nullptr;
+  cmn_->plot.close();
+  if (solve_mode_ == SolveMode::bench) {
+    cmn_->ysolve.report(std::cout);
+  }
+}
+
+EnergizationPlan::EnergizationPlan(std::string inpFile, int nthreads, int scale)
+  : inpFile_(std::move(inpFile))
+  , nthreads_(std::max(nthreads, 1))
+  , scale_(std::max(scale, 1))
+{}
+
+EnergizationPlan::~EnergizationPlan()
+{
+  finish();
+}
+
+void EnergizationPlan::start(int ncase, int first, int nenerg, double seed)
+{
+  finish();
+  ncase_ = ncase;
+  first_ = first;
+  nenerg_ = nenerg;
+  seed_ = seed;
+  int count = std::max(std::abs(nenerg) - first + 1, 0);
+  slots_ = std::vector<Slot>(count);
+  pending_ = true;
+  abort_ = false;
+  // no more workers than energizations, nor than hardware threads: the
+  // workers only compute, and more of them would take turns on the cores,
+  // each with its own COMMON in the caches
+  int const hardware = std::max(int(std::thread::hardware_concurrency()), 1);
+  int n = std::min({ nthreads_, count, hardware });
+  // deal out contiguous runs of KNT; a worker whose run is exhausted steals
+  // from the tail of another, so the head (wanted first by the master) is
+  // left to its owner
+  queues_.clear();
+  for (int i = 0; i < n; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (int i = 0; i < count; ++i) {
+    queues_[size_t(i) * n / count]->knts.push_back(first + i);
+  }
+  for (int i = 0; i < n; ++i) {
+    threads_.emplace_back(&EnergizationPlan::work, this, i);
+  }
+}
+
+void EnergizationPlan::finish()
+{
+  abort_ = true;
+  for (auto& t : threads_) {
+    t.join();
+  }
+  threads_.clear();
+  pending_ = false;
+}
+
+bool EnergizationPlan::next(int id, int& knt)
+{
+  if (abort_) {
+    return false;
+  }
+  {
+    auto& q = *queues_[id];
+    std::lock_guard<std::mutex> lock(q.mtx);
+    if (!q.knts.empty()) {
+      knt = q.knts.front();
+      q.knts.pop_front();
+      return true;
+    }
+  }
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    auto& q = *queues_[(id + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(q.mtx);
+    if (!q.knts.empty()) {
+      knt = q.knts.back();
+      q.knts.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void EnergizationPlan::work(int id)
+{
+  namespace fs = std::filesystem;
+  table_scale() = scale_;  // for DIMENS on this thread
+  Simulation sim;
+  sim.table_scale(scale_);
+  int knt = 0;
+  while (next(id, knt)) {
+    // only the extrema of a worker are wanted, not its printout
+    std::string scratch = (fs::temp_directory_path()
+      / ("emtp_energ_" + fem::utils::random_name_simple(8))).string();
+    std::exception_ptr error;
+    try {
+      sim.reset();
+      auto& cmn = sim.cmn();
+      cmn.energ_plan = this;
+      cmn.energ_knt = knt;
+      program_main(cmn, inpFile_, scratch + ".log", scratch + ".out");
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (!slots_[knt - first_].done) {
+        throw std::runtime_error("no extrema from the worker");
+      }
+    }
+    catch (...) {
+      try {
+        std::throw_with_nested(std::runtime_error(
+          "energization " + std::to_string(knt)));
+      }
+      catch (...) {
+        error = std::current_exception();
+      }
+    }
+    std::error_code ec;
+    for (auto ext : { ".log", ".out", ".out2" }) {
+      fs::remove(scratch + ext, ec);
+    }
+    if (error) {
+      deliver(knt, EnergizationRecord{}, error);
+    }
+  }
+}
+
+void EnergizationPlan::deliver(
+  int knt,
+  EnergizationRecord&& rec,
+  std::exception_ptr error)
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto& slot = slots_[knt - first_];
+    if (slot.done) {
+      return;
+    }
+    slot.rec = std::move(rec);
+    slot.error = error;
+    slot.done = true;
+  }
+  ready_.notify_all();
+}
+
+void EnergizationPlan::capture(const common& cmn)
+{
+  EnergizationRecord rec;
+  size_t n = std::min(size_t(4 * cmn.lsiz12), cmn.xmax.size_1d());
+  rec.xmax.assign(cmn.xmax.begin(), cmn.xmax.begin() + n);
+  rec.angle = cmn.angle;
+  rec.angtpe = cmn.angtpe;
+  rec.nswtpe = cmn.nswtpe;
+  rec.times = cmn.energ_times;
+  deliver(cmn.energ_knt, std::move(rec), nullptr);
+}
+
+void EnergizationPlan::restore(common& cmn, int knt)
+{
+  std::unique_lock<std::mutex> lock(mtx_);
+  auto& slot = slots_.at(knt - first_);
+  ready_.wait(lock, [&slot] { return slot.done; });
+  if (slot.error) {
+    std::rethrow_exception(slot.error);
+  }
+  std::copy(slot.rec.xmax.begin(), slot.rec.xmax.end(), cmn.xmax.begin());
+  cmn.angle = slot.rec.angle;
+  cmn.angtpe = slot.rec.angtpe;
+  cmn.nswtpe = slot.rec.nswtpe;
+  cmn.energ_times = slot.rec.times;
+}
+
+void program_main(
+  const std::string& inpFile,
+  const std::string& logFile,
+  const std::string& outFile)
+{
+  // stacksize exceeds: common cmn(0, 0);
+  Simulation sim;
+  sim.run(inpFile, logFile, outFile);
+}
 
 void program_main(
+  common& cmn,
   const std::string& inpFile, 
   const std::string& logFile, 
   const std::string& outFile) try
 {
-  // stacksize exceeds: common cmn(0, 0);
-  auto& cmn = Comm();
 
 #ifdef _DEBUG // test
   {
@@ -71717,8 +72975,7 @@ void program_main(
   }
 #endif // _DEBUG // test
 
-  cmn.inp_stream.open(inpFile);
-  if (!cmn.inp_stream.good()) {
+  if (!cmn.inp_deck.open(inpFile)) {
     std::cout << "Cannot open '" << inpFile << "' !\n";
     return;
   }
@@ -71826,6 +73083,7 @@ void program_main(
   cmn.out_stream.open(outFile);  // open output streams
   if (!cmn.out_stream.is_open())
     return;
+  cmn.plot.open(cmn.out_stream, outFile + ".bin", cmn.plot_format);
   cmn.out2_stream.open(outFile + '2');   // steady state result
   if (!cmn.out2_stream.is_open()) {
     std::cout << "Cannot open '" << outFile + '2' << "' !\n";
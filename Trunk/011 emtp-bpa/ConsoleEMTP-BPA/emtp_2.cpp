@@ -2336,6 +2336,11 @@ namespace emtp {
     cmn.io.open(lunit3, fem::file_not_specified)
       .form("UNFORMATTED")
       .status("SCRATCH");
+    //  NOT THE DEFAULT "io_unit_009" OF THE WORKING DIRECTORY, WHICH
+    //  CONCURRENT SIMULATIONS WOULD SHARE
+    cmn.io.open(cmn.lunit9, fem::file_not_specified)
+      .form("UNFORMATTED")
+      .status("SCRATCH");
     //C               UNIT 8 IS CALCOMP PLOT FILE (UNUSED WITH OUR VAX-VERSATEM24. 367
     //C               CONNECTION )                                            M24. 368
     cmn.io.open(lunt10, fem::file_not_specified)
@@ -3554,12 +3559,18 @@ statement_2843:
   if (kill > 0) {
     goto statement_9200;
   }
-  read(abuff, format_3415), deltat, tmax, d1, d2, d3, tolmat, t;
+  //C     COLUMNS 57-64:  NODORD  (NODE ORDERING OF "OVER7", SEE NODE_ORDER.H)
+  read(abuff, format_3415), deltat, tmax, d1, d2, d3, tolmat, t, d8;
   if (t == 0.0f) {
     t = 0.0f;
   }
+  cmn.node_ordering = 0;
+  if (d8 > 0.0 && d8 < 3.0) {
+    cmn.node_ordering = int(d8);
+  }
   goto statement_4202;
 statement_4201:
+  cmn.node_ordering = 0;
   nfrfld = 1;
   nright = 0;
   freone(cmn, deltat);
@@ -3871,6 +3882,8 @@ statement_4269:
   }
   cmn.ntot = 1;
   cmn.maxbus = 0;
+  cmn.bus_names.invalidate();
+  cmn.texvec_names.invalidate();
   n23 = 0;
   namea6(cmn, blank, n23);
   cmn.icheck = 1;
@@ -9330,20 +9343,13 @@ statement_110:
   n3 = 0;
   n4 = 0;
   ityold = itype;
-  FEM_DO_SAFE(i, 1, ntot) {
-    if (bus1 == bus(i)) {
-      n1 = i;
-    }
-    if (bus2 == bus(i)) {
-      n2 = i;
-    }
-    if (bus3 == bus(i)) {
-      n3 = i;
-    }
-    if (bus4 == bus(i)) {
-      n4 = i;
-    }
-  }
+  //  THE LAST CELL OF EACH NAME IN BUS(1 : NTOT), FROM THE INDEX OF THE
+  //  NAMES (node_names.h); I AS THE SEARCH LOOP LEFT IT
+  n1 = cmn.bus_names.last(bus, ntot, bus1);
+  n2 = cmn.bus_names.last(bus, ntot, bus2);
+  n3 = cmn.bus_names.last(bus, ntot, bus3);
+  n4 = cmn.bus_names.last(bus, ntot, bus4);
+  i = ntot + 1;
   if (model == 0) {
     goto statement_4005;
   }
@@ -18982,6 +18988,7 @@ statement_6347:
     ispum(cmn.iujtho), spum(cmn.iureqs), spum(cmn.iuepso), spum(cmn.iudcoe), 
     ispum(cmn.iukcoi), spum(cmn.iuvolt), spum(cmn.iuangl), ispum(cmn.iunodf), 
     ispum(cmn.iunodm), ispum(cmn.iukumo), ispum(cmn.iujumo), spum(cmn.iuumou));
+  cmn.bus_names.invalidate();  // UMDATB RENAMES CELLS OF BUS
 
   if (kill > 0) {
     return;
@@ -19124,11 +19131,11 @@ statement_27:
   lstat(19) = 317;
   return;
 statement_317:
-  FEM_DO_SAFE(i, 1, ntot) {
-    if (bus1 == bus(i)) {
-      goto statement_330;
-    }
+  i = cmn.bus_names.first(bus, ntot, bus1);
+  if (i != 0) {
+    goto statement_330;
   }
+  i = ntot + 1;
   lstat(19) = 320;
 statement_4258:
   kill = 12;
@@ -19221,11 +19228,11 @@ statement_7658:
   }
   crest(kconst - 1) = a * gus3 / gus2 / gus4;
   gus3 = gus4 * gus2 / gus3;
-  FEM_DO_SAFE(k, 1, ntot) {
-    if (bus1 == bus(k)) {
-      goto statement_342;
-    }
+  k = cmn.bus_names.first(bus, ntot, bus1);
+  if (k != 0) {
+    goto statement_342;
   }
+  k = ntot + 1;
   lstat(19) = 341;
   goto statement_4258;
 statement_342:
@@ -20003,16 +20010,9 @@ statement_3519:
   namesw(kswtch) = n24;
   adelay(kswtch) = 0.f;
   atemp = a;
-  n1 = 0;
-  n2 = 0;
-  FEM_DO_SAFE(i, 1, ntot) {
-    if (bus1 == bus(i)) {
-      n1 = i;
-    }
-    if (bus2 == bus(i)) {
-      n2 = i;
-    }
-  }
+  n1 = cmn.bus_names.last(bus, ntot, bus1);
+  n2 = cmn.bus_names.last(bus, ntot, bus2);
+  i = ntot + 1;
   iprint = 1;
   if (n1 != 0) {
     goto statement_211;
@@ -20386,16 +20386,9 @@ statement_3344:
   kloaep = kswtch;
   goto statement_225;
 statement_34605:
-  n5 = 0;
-  n6 = 0;
-  FEM_DO_SAFE(i, 1, ntot) {
-    if (bus5 == bus(i)) {
-      n5 = i;
-    }
-    if (bus6 == bus(i)) {
-      n6 = i;
-    }
-  }
+  n5 = cmn.bus_names.last(bus, ntot, bus5);
+  n6 = cmn.bus_names.last(bus, ntot, bus6);
+  i = ntot + 1;
   if (n5 * n6 == 1) {
     goto statement_225;
   }
@@ -21575,6 +21568,123 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+// FILL-REDUCING RENUMBERING FOR "OVER7" (NODORD OF THE FLOATING-POINT
+// MISCELLANEOUS DATA CARD), IN PLACE OF THE TINNEY SCHEME. IT LEAVES
+// WHAT THE TINNEY SCHEME LEAVES: NORDER, ICH2, AND THE ROWS  INDEX / ILOC
+// OF THE FACTORS IN THE NEW NUMBERS. FALSE IF THE NETWORK IS NOT AS
+// EXPECTED, OR ITS FACTORS DO NOT FIT; "OVER7" THEN RENUMBERS AS BEFORE.
+bool over7_ordering(
+  common& cmn) try
+{
+  int const ntot = cmn.ntot;
+  int const ncurr = cmn.ncurr;
+  auto& norder = cmn.norder;
+  auto& index = cmn.index;
+  auto& iloc = cmn.iloc;
+  auto ich2 = ArraySpan(reinterpret_cast<int*>(&cmn.diag(1)), cmn.diag.size_1d());
+  auto loc = ArraySpan(reinterpret_cast<int*>(&cmn.diab(1)), cmn.diab.size_1d());
+  auto kownt = ArraySpan(reinterpret_cast<int*>(&cmn.solr(1)), cmn.solr.size_1d());
+  auto korder = ArraySpan(reinterpret_cast<int*>(&cmn.bnd(1)), cmn.bnd.size_1d());
+  auto kolum = ArraySpan(reinterpret_cast<int*>(&cmn.gnd(1)), cmn.gnd.size_1d());
+  int const iofkol = cmn.iofgnd;
+  int const iofkor = cmn.iofbnd;
+  //C     NODE GRAPH OF THE CONNECTIVITY LISTS OF "OVER6" (OR "OVER9").
+  //C     STAGE -1 FOR KNOWN-VOLTAGE NODES, WHICH ARE NEVER ELIMINATED.
+  NodeGraph g;
+  g.n = ntot;
+  g.ptr.assign(ntot + 1, 0);
+  std::vector<int> stage(ntot, 0);
+  int nz = 0;
+  for (int i = 1; i <= ntot; ++i) {
+    for (int lt = loc(i); lt != 0; lt = korder(iofkor + lt)) {
+      g.adj.push_back(kolum(iofkol + lt) - 1);
+    }
+    g.ptr[i] = int(g.adj.size());
+    if (kownt(i) == -1) {
+      stage[i - 1] = -1;
+    }
+    else {
+      nz++;
+    }
+  }
+  if (nz != ncurr) {
+    return false;
+  }
+  //C     GROUND IS NUMBERED FIRST (UNLESS KNOWN, AS IN THE STEADY STATE),
+  //C     AND KNOWN NODES LAST IN NODE ORDER.
+  std::vector<int> perm;
+  perm.reserve(ntot);
+  if (kownt(1) != -1) {
+    stage[0] = -1;
+    perm.push_back(0);
+  }
+  //C     IN THE TRANSIENT NETWORK, SWITCH NODES (2) AND THEIR NEIGHBOURS
+  //C     (1) ARE ELIMINATED LAST, SO THAT A SWITCH EVENT RETRIANGULARIZES
+  //C     ONLY THE LAST ROWS OF (Y)  (PARTIAL_FACTOR.H).
+  std::vector<int> late(ntot, 0);
+  if (cmn.lastov <= cmn.nchain) {
+    for (int k = 1; k <= cmn.kswtch; ++k) {
+      for (int m : { cmn.kmswit(k), cmn.kmswit(cmn.lswtch + k) }) {
+        m = std::abs(m);
+        if (m > 1 && m <= ntot && stage[m - 1] >= 0) {
+          late[m - 1] = 2;
+        }
+      }
+    }
+    for (int i = 0; i < ntot; ++i) {
+      if (late[i] != 2) {
+        continue;
+      }
+      for (int k = g.ptr[i]; k < g.ptr[i + 1]; ++k) {
+        int const u = g.adj[k];
+        if (late[u] == 0 && stage[u] >= 0) {
+          late[u] = 1;
+        }
+      }
+    }
+    for (int i = 0; i < ntot; ++i) {
+      if (late[i] != 0) {
+        stage[i] = -1;
+      }
+    }
+  }
+  if (NodeOrdering(cmn.node_ordering) == NodeOrdering::dissection) {
+    stage = node_order::dissection_stages(g, stage);
+  }
+  for (int i = 0; i < ntot; ++i) {
+    if (late[i] != 0) {
+      stage[i] = (1 << 21) + late[i];
+    }
+  }
+  auto const elim = node_order::min_degree(g, stage);
+  perm.insert(perm.end(), elim.begin(), elim.end());
+  for (int i = 1; i <= ntot; ++i) {
+    if (kownt(i) == -1) {
+      perm.push_back(i - 1);
+    }
+  }
+  if (int(perm.size()) != ntot) {
+    return false;
+  }
+  auto const f = node_order::symbolic(g, perm, ncurr);
+  if (f.ptr[ntot] > std::min(cmn.lsiz23, int(iloc.size_1d()))) {
+    return false;
+  }
+  for (int j = 1; j <= ntot; ++j) {
+    norder(perm[j - 1] + 1) = j;
+    ich2(j) = perm[j - 1] + 1;
+    index(j) = f.ptr[j - 1] + 1;
+  }
+  for (int k = 1; k <= f.ptr[ntot]; ++k) {
+    iloc(k) = f.col[k - 1] + 1;
+  }
+  cmn.ioffd = f.ptr[ntot];
+  return true;
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
 // NETWORK NODE RENUMBERING ROUTINE (JOHN WALKER'S OLD           
 // SUBROUTINE NUMBER).                                           
 void over7(
@@ -21644,6 +21754,9 @@ void over7(
   int ks = fem::int0;
   int ls = fem::int0;
   int kb = fem::int0;
+  int method = fem::int0;
+  int norig = fem::int0;
+  std::chrono::steady_clock::time_point t0;
   static const char* format_4568 = "('  \"EXIT  MODULE OVER7.\"')";
   static const char* format_47881 =
     "(/,' (NORDER(I), I=1, NTOT)   AFTER TRANSIENT-NETWORK RENUMBERING .',"
@@ -21688,6 +21801,31 @@ void over7(
         ndx1);
   }
 statement_4054:
+  //C     TERMS OF THE ORIGINAL NETWORK, AND TIME OF THE RENUMBERING, FOR
+  //C     ITS SUMMARY. NODORD .NE. 0 RENUMBERS BY "OVER7_ORDERING" INSTEAD.
+  t0 = std::chrono::steady_clock::now();
+  norig = 0;
+  method = 0;
+  if (cmn.node_ordering == 0 && iprsup < 1) {
+    goto statement_4055;
+  }
+  FEM_DO_SAFE(i, 1, ntot) {
+    for (j = loc(i); j != 0; j = korder(iofkor + j)) {
+      k = kolum(iofkol + j);
+      if (k > i && (kownt(i) != -1 || kownt(k) != -1)) {
+        norig++;
+      }
+    }
+  }
+  if (cmn.node_ordering == 0) {
+    goto statement_4055;
+  }
+  if (!over7_ordering(cmn)) {
+    goto statement_4055;
+  }
+  method = cmn.node_ordering;
+  goto statement_5236;
+statement_4055:
   ioffd = 0;
   td = 0.0f;
   zzza = 0.0f;
@@ -21867,6 +22005,28 @@ statement_5236:
   if (ioffd > lstat(43)) {
     lstat(43) = ioffd;
   }
+  if (cmn.node_ordering == 0 && iprsup < 1) {
+    goto statement_5276;
+  }
+  //C     SUMMARY OF THE RENUMBERING: TERMS OF THE ROWS OF ELIMINATED NODES.
+  {
+    std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+    k = index(ncurr + 1) - 1;
+    if (lastov <= nchain) {
+      cmn.factor_terms = k;
+      cmn.factor_fill = k - norig;
+      cmn.order_seconds = dt.count();
+    }
+    if (cmn.noutpr == 0) {
+      write(lunit6,
+        "(' RENUMBERING OF THE ',a,' NETWORK BY ',a,'.   NODES',i8,"
+        "'   ELIMINATED',i8,/,' FACTOR TERMS',i10,'   FILL-IN',i10,"
+        "'   ORIGINAL TERMS',i10,'   ORDERING TIME',f11.6,' SEC.')"),
+        lastov <= nchain ? "TRANSIENT" : "STEADY-STATE",
+        method == 1 ? "MINIMUM DEGREE" : method == 2 ? "NESTED DISSECTION" : "TINNEY SCHEME 2",
+        ntot, ncurr, k, k - norig, norig, dt.count();
+    }
+  }
 statement_5276:
   if (lastov > nchain) {
     goto statement_5283;
@@ -29285,6 +29445,7 @@ statement_2200:
   statement_3535:;
   }
 statement_1024:
+  cmn.texvec_names.invalidate();  // TEXVEC(1) HELD THE NAMES ABOVE
   if (kconst == 0) {
     goto statement_1034;
   }
@@ -29961,7 +30122,7 @@ void sseqiv(
   auto& volti = static_cast<common_c0b123&>(cmn).volti;
 
   arr_ref<double> voltk(static_cast<common_c0b124&>(cmn).voltk,
-    dimension(3000));
+    dimension(tabsiz(3000)));
   //
   int idk = fem::int0;
   auto& lunit6 = cmn.lunit6;
@@ -34160,21 +34321,18 @@ void pltfil(
 
   //
 
-  if (450 < k) {
+  //  THE CHANNELS OF  CMN.PLOT  ARE NOT LIMITED IN NUMBER.   "OVER15"
+  //  SIZES  VOLTI  FOR ALL OF THEM, SO THIS IS ONLY A CONSISTENCY CHECK.
+  if (k > int(volti.size())) {
     write(cmn.lunit6,
-      "('Error in \"PLTFIL\", the number of output variables ',i3,"
-      "' exceeds the limit of 450.')"), k;
+      "('Error in \"PLTFIL\", the number of output variables ',i8,"
+      "' exceeds the size of  VOLTI ,',i8,'.')"), k, int(volti.size());
     throw std::out_of_range("in \'pltfil\'");
   }
 
 
-  cmn.out_stream << SState("e12.5") << volti[0]; // time
-  if (-1 < volti(1)) { // the last item is -9999
-    for (int i = 1; i < k; ++i) {
-      cmn.out_stream << ',' << SState("e12.5") << volti[i];
-    }
-  }
-  cmn.out_stream << '\n';
+  // time, then the output variables (none if the time is the -9999 flag)
+  cmn.plot.row(&volti[0], -1 < volti(1) ? std::max(k, 1) : 1);
 
 
 
@@ -36794,11 +36952,22 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+struct randnm_save
+{
+  std::uint64_t seed = 0;
+  int knt = 0;
+  int ksw = 0;
+  std::uint64_t key = 0;
+  std::uint64_t ctr = 0;
+  std::vector<double> bulk;
+};
+
 double randnm(
   common& cmn,
   double const& x) try
 {
   double return_value = fem::double0;
+  FEM_CMN_SVE(randnm);
   const auto& moncar = cmn.moncar;
   //
   int knt = fem::int0;
@@ -36845,17 +37014,25 @@ double randnm(
   if (x == 0.0f) {
     goto statement_4213;
   }
-  //C SKIP 2ND OR LATER SEED
-  if (knt > 1) {
-    goto statement_9800;
-  }
   n14 = x;
   if (n14 / 2 * 2 == n14) {
     n14++;
   }
+  //  EVERY ENERGIZATION RE-SEEDS WITH  (X, KNT) , SO ITS DRAWS DO NOT
+  //  DEPEND ON WHICH CONTEXT SIMULATES IT, NOR IN WHAT ORDER.   DRAWS
+  //  THEN COME FROM STREAM 0 UNTIL  =RANSTR=  SELECTS A SWITCH STREAM.
+  sve.seed = static_cast<std::uint64_t>(n14);
+  sve.knt = knt;
+  sve.bulk.clear();
+  ranstr(cmn, 0);
   //C 29 Dec 1987, change from  (N1, N2)
   statement_4213:
-  return_value = std::rand(); //w ran(n14);
+  if (sve.ctr == 0 && sve.ksw > 0 && sve.ksw <= (int)sve.bulk.size()) {
+    sve.ctr++;
+    return_value = sve.bulk[sve.ksw - 1];
+    goto statement_9800;
+  }
+  return_value = CounterRng::uniform(sve.key, sve.ctr++); //w ran(n14);
   goto statement_9800;
   statement_7265:
   return_value = sandnm(cmn, x);
@@ -36866,6 +37043,42 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+void ranstr(
+  common& cmn,
+  int const& ksw) try
+{
+  FEM_CMN_SVE(randnm);
+  //  SELECT STREAM  KSW  OF THE CURRENT  (SEED, KNT) .   SWITCH  KSW  DRAWS
+  //  FROM ITS OWN STREAM, SO ITS TIMES DO NOT DEPEND ON HOW MANY NUMBERS
+  //  THE OTHER SWITCHES CONSUMED BEFORE IT.
+  sve.ksw = ksw;
+  sve.key = CounterRng::key(sve.seed, sve.knt, ksw);
+  sve.ctr = 0;
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
+void ranblk(
+  common& cmn,
+  int const& kswtch) try
+{
+  FEM_CMN_SVE(randnm);
+  //  BULK MODE:  PRE-DRAW THE FIRST NUMBER OF STREAMS  1, ..., KSWTCH  IN
+  //  ONE PASS.   =RANDNM=  HANDS THEM OUT AS EACH STREAM IS FIRST USED.
+  //  THE VALUES ARE IDENTICAL TO THOSE OF THE ONE-AT-A-TIME PATH.
+  if (cmn.xmaxmx < 0.0f) {
+    return;
+  }
+  sve.bulk.resize(std::max(kswtch, 0));
+  if (kswtch > 0) {
+    CounterRng::fill(sve.bulk.data(), sve.seed, sve.knt, 1, kswtch);
+  }
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
 void tacs2(
   common& cmn) try
 {
@@ -40419,6 +40632,7 @@ void over12(
   int mxpair = fem::int0;
   int n2 = fem::int0;
   int L = fem::int0;
+  int nrep = fem::int0;
   arr_1d<2, fem::str<8> > atim(fem::fill0);
   double seed = fem::double0;
   double d8 = fem::double0;
@@ -40680,6 +40894,44 @@ statement_13000:
   }
   inecho = lunt12;
   cmn.io.rewind(lunt12);
+  if (nenerg == 0) {
+    goto statement_13010;
+  }
+  cmn.energ_case++;
+  if (cmn.energ_plan == nullptr || cmn.energ_knt > 0) {
+    goto statement_13010;
+  }
+  //  THE ENERGIZATIONS ARE SIMULATED BY THE WORKER CONTEXTS OF THE PLAN,
+  //  ALL WITH THE SAME SEED.  AFTER  "OMIT BASE CASE"  THIS CONTEXT
+  //  SIMULATES THE FIRST ENERGIZATION ITSELF.
+  time44(cmn, atim(1));
+  runtym(d1, d2);
+  seed = seedy(cmn, atim(1)) + 1000.f * (d1 + d2);
+  seed = 2.0f * seed;
+  if (jseedr >= nenerg) {
+    seed = seedr;
+  }
+  n2 = 1;
+  if (kbase == intinf) {
+    n2 = 2;
+  }
+  //  THE SWITCH VECTORS WHICH S.N. 4088 OR 166 WRITE ON  LUNIT3  FOR
+  //  "GUTS29" , STILL UNTOUCHED BY THE BASE CASE.  THE WORKER CONTEXTS
+  //  RETURN THE SWITCH TIMES OF EACH ENERGIZATION (SEE  "OVER20" ).
+  cmn.io.rewind(lunit3);
+  if (isw == 4444) {
+    write_loop wloop(cmn, lunit3, fem::unformatted);
+    FEM_DO_SAFE(i, 1, ntot) {
+      wloop, bus(i);
+    }
+  }
+  FEM_DO_SAFE(i, 1, kswtch) {
+    j = lswtch + i;
+    write(lunit3, fem::unformatted), kmswit(i), kmswit(j), adelay(i),
+      crit(i), topen(j), kdepsw(i);
+  }
+  write(lunit3, fem::unformatted), kloaep;
+  cmn.energ_plan->start(cmn.energ_case, n2, nenerg, seed);
 statement_13010:
   if (kbase >= 2 && kbase != intinf) {
     goto statement_156;
@@ -40740,6 +40992,17 @@ statement_156:
     write(lunt10, fem::unformatted), i, adelay(i), crit(i), topen(j);
   statement_7259:;
   }
+  if (cmn.energ_knt <= 0) {
+    goto statement_7261;
+  }
+  //  WORKER CONTEXT:  ONLY ENERGIZATION  ENERG_KNT  OF THE PLANNED CASE.
+  //  ANY OTHER STATISTICS CASE OF THE DECK IS REDUCED TO ITS BASE CASE.
+  if (cmn.energ_case != cmn.energ_plan->ncase()) {
+    goto statement_7263;
+  }
+  knt = cmn.energ_knt;
+  goto statement_166;
+statement_7261:
   if (kbase != intinf) {
     goto statement_7263;
   }
@@ -40908,6 +41171,9 @@ statement_409:
   if (jseedr >= nenerg) {
     seed = seedr;
   }
+  if (cmn.energ_plan != nullptr) {
+    seed = cmn.energ_plan->seed();
+  }
   d8 = randnm(cmn, seed);
   if (iprsup >= 1) {
     write(lunit6,
@@ -40920,7 +41186,7 @@ statement_409:
   if (itest == 1) {
     goto statement_1646;
   }
-  if (knt > 1) {
+  if (knt > 1 && cmn.energ_knt == 0) {
     goto statement_1615;
   }
   nswtpe = 0;
@@ -40978,6 +41244,7 @@ statement_1615:
   statement_1620:;
   }
 statement_1646:
+  ranblk(cmn, kswtch);
   FEM_DO_SAFE(ksw, 1, kswtch) {
     if (std::abs(adelay(ksw)) != 44444.f) {
       goto statement_700;
@@ -41018,6 +41285,7 @@ statement_1646:
     }
     bias = 0.0f;
   statement_664:
+    ranstr(cmn, ksw);
     timev = crit(ksw);
     n = kdepsw(ksw);
     if (kloaep == 0) {
@@ -41101,11 +41369,14 @@ statement_1646:
     }
     goto statement_700;
   statement_690:
-    time44(cmn, atim(1));
-    runtym(d1, d2);
-    seed = seedy(cmn, atim(1)) + 1000.f * (d1 + d2);
-    seed = 2.0f * seed;
-    d8 = randnm(cmn, seed);
+    //  NO CLOCK RE-SEEDING WHEN THE DRAWS MUST BE REPRODUCIBLE PER KNT
+    if (cmn.energ_plan == nullptr) {
+      time44(cmn, atim(1));
+      runtym(d1, d2);
+      seed = seedy(cmn, atim(1)) + 1000.f * (d1 + d2);
+      seed = 2.0f * seed;
+      d8 = randnm(cmn, seed);
+    }
     rng = randnm(cmn, zerofl);
     ltdelt++;
     moncar(3) = ltdelt;
@@ -41135,6 +41406,12 @@ statement_1646:
     }
   }
 statement_300:
+  if (cmn.energ_knt > 0) {
+    //  WORKER CONTEXT:  THE MASTER WRITES THESE RECORDS ON ITS  LUNIT3
+    cmn.energ_times.assign(1, ranoff);
+    cmn.energ_times.insert(cmn.energ_times.end(), &tclose(1), &tclose(1) + kswtch);
+    cmn.energ_times.insert(cmn.energ_times.end(), &topen(1), &topen(1) + kswtch);
+  }
   {
     write_loop wloop(cmn, lunit3, fem::unformatted);
     wloop, ranoff;
@@ -41449,7 +41726,7 @@ statement_703:
     }
   }
 statement_702:
-  if (knt == 1) {
+  if (knt == 1 || cmn.energ_knt > 0) {
     goto statement_598;
   }
   n9 = ipntv(11);
@@ -41474,10 +41751,16 @@ statement_188:
 statement_190:
   nj = klorow + lswtch;
   ns2 = tdns(klorow);
+  //  A WORKER CONTEXT STARTS FROM SCRATCH, SO IT STEPS THE  INDTV
+  //  COUNTERS THROUGH ENERGIZATIONS  1, ..., KNT  BEFORE USING THEM.
+  nrep = 1;
+  if (cmn.energ_knt > 0) {
+    nrep = knt;
+  }
   if (numref <= 1) {
     goto statement_201;
   }
-  if (knt == 1) {
+  if (knt == 1 || nrep > 1) {
     indtv(ilorow) = 1;
   }
   j = 0;
@@ -41513,6 +41796,19 @@ statement_199:
     goto statement_198;
   }
 statement_200:
+  if (nrep > 1) {
+    nrep--;
+    FEM_DO_SAFE(j, 1, numref) {
+      if (indtv(j) == 0) {
+        indtv(j) = 1;
+      }
+    }
+    if (numref <= 1) {
+      goto statement_201;
+    }
+    j = 0;
+    goto statement_198;
+  }
   tstbeg = crit(klorow);
   if (itest > 0) {
     goto statement_203;
@@ -47951,6 +48247,7 @@ zincox(
   double gap = fem::double0;
   int k1 = fem::int0;
   int k2 = fem::int0;
+  int ilock = fem::int0;
   //C!DIMENSION FOLD( 1 )
   //C!DIMENSION KSING( 1 ), KINDEP( 1 )
   //C!EQUIVALENCE ( KSING(1), CCHAR(1) )
@@ -48029,6 +48326,10 @@ statement_3425:
   ndx1r = iofznr + 1;
   ndx1i = iofzni + 1;
   ndx7i = iofzni + n7;
+  ilock = 0;
+  //C     NO NEWTON SOLUTION OF THIS SUBNETWORK YET, S.N. 3522 COUNTS NONE
+  niter = 0;
+  d3 = 0.0f;
   //C     EXTRACT ZTHEVENIN FROM ZNONL, DETERMINE ELEMENTS CONNECTED TO     M37.5724
   //C     KNOWN VOLTAGE NODES********************************************   M37.5725
   ndx2 = ndx1i;
@@ -48076,6 +48377,20 @@ statement_3425:
     m5 = kknonl(m5);
     m += 2;
   }
+  //C     THE SAME ZTHEVENIN AS AT AN EARLIER STEP HAS THE SAME KSING, KINDEP
+  //C     AND INVERSE; THEY ARE TAKEN BACK (ZNO_NEWTON.H), NOT WITH
+  //C     --LEGACY-SOLVE.
+  if (iprsup <= 1 && cmn.solve_mode != SolveMode::legacy && cmn.zno.restore(ns, n7, &volti(1), &volt(1),
+      &cchar(ndx1i), &gslope(ndx1i), n17, n5)) {
+    ilock = 1;
+    ndx17r = iofznr + n17;
+    ndx17i = iofzni + n17;
+    if (kill > 0) {
+      goto statement_4567;
+    }
+    niter = 0;
+    goto statement_3693;
+  }
   if (iprsup > 1) {
     {
       write_loop wloop(cmn, lunit6, "(/,' ''KSING''  B4 COPY CHECKING.',20i5)");
@@ -48198,6 +48513,10 @@ statement_3674:
   }
   niter = 0;
   if (ier == 0) {
+    if (iprsup <= 1 && cmn.solve_mode != SolveMode::legacy) {
+      cmn.zno.store(ns, n7, &volt(1), &cchar(ndx1i), &gslope(ndx1i), n17, n5);
+      ilock = 1;
+    }
     goto statement_3693;
   }
   lstat(19) = 3471;
@@ -48270,6 +48589,11 @@ statement_3474:
   niter++;
   n11 = 1;
   move0(vchar, ndx1r, n17);
+  //C     THEVENIN CURRENTS OF ALL INDEPENDENT ARRESTERS AT ONCE; THE LOOP
+  //C     BELOW THEN ONLY ADDS THE ELEMENT CURRENTS.
+  if (ilock != 0) {
+    cmn.zno.thevenin(&voltk(1), &cchar(ndx1i), &vchar(ndx1r));
+  }
   ndx2 = iofzni;
   m2 = 0;
   FEM_DO_SAFE(L, 1, n7) {
@@ -48400,7 +48724,7 @@ statement_3474:
     volt(n10) = volt(n10) - azx * d11 / voltk(m2);
   statement_68:
     ndx4 = iofznr + n14;
-    if (cchar(ndx2) != 0) {
+    if (cchar(ndx2) != 0 || ilock != 0) {
       goto statement_75;
     }
     m22 = 0;
@@ -48555,6 +48879,9 @@ statement_92:
   window(cmn);
   goto statement_3691;
 statement_3522:
+  if (niter > 0) {
+    cmn.zno.count(niter, d3);
+  }
   ndx2 = iofzni;
   m2 = 0;
   FEM_DO_SAFE(L, 1, n7) {
@@ -48932,6 +49259,10 @@ statement_73577:
       }
     }
   }
+  cmn.refactor.invalidate();  // NEW (Y), FACTORS START OVER
+  cmn.factor_cache.clear();
+  cmn.zno.clear();
+  cmn.lines.invalidate();
   last14(cmn);
   //C     FOLLOWING 2 CARDS EXTRACTED FROM "LAST14" (NO OV16 USE):          M32.4485
   if (cmn.numsm > 0) {
@@ -50880,9 +51211,7 @@ statement_300:
       wloop, busum(i);
     }
 
-    cmn.out_stream.clear();
-    cmn.out_stream.seekp({});
-    cmn.out_stream << getCurrentDateTime() << '\n';
+    cmn.plot.start(getCurrentDateTime(), true);
   }
   if (iprsup >= 1) {
     write(lunit6, format_3207), nc, lsiz12, nsmout, ioutcs, ntot, numnvo,
@@ -50906,12 +51235,12 @@ statement_3103:
         wloop, ibsout(i);
       }
 
-      cmn.out_stream << "Time";
+      cmn.plot.column("Time");
       for (int i = 1; i <= numnvo; ++i) { // node voltage
-        cmn.out_stream << ',' << bus(ibsout(i))(1,6).std_str();
+        cmn.plot.column(bus(ibsout(i))(1,6).std_str());
       }
       if (nc == 0)
-        cmn.out_stream << '\n';
+        cmn.plot.end_header();
     }
   }
 statement_3104:
@@ -50924,29 +51253,39 @@ statement_3104:
       FEM_DO_SAFE(i, 1, nc) {
         wloop, jbrnch(i);
       }
-      if (numnvo == 0) cmn.out_stream << "Time";
+      if (numnvo == 0) cmn.plot.column("Time");
       for (int i = 1; i <= ncsave; ++i) { // branch 
         auto n1 = ibrnch(i);
         auto n2 = jbrnch(i);
-        cmn.out_stream << ',' << bus(n1)(1, 6).std_str() << "->" << bus(n2)(1, 6).std_str();
+        cmn.plot.column(bus(n1)(1, 6).std_str() + "->" + bus(n2)(1, 6).std_str());
       }
       for (int i = 1; i <= nsmout; ++i) { // dynamic sm 
         auto n1 = ismout(3*i - 1);
         auto n2 = ismout(3*i);
-        cmn.out_stream << ',' << texvec(n1)(1, 6).std_str() << "->" << texvec(n2)(1, 6).std_str();
+        cmn.plot.column(texvec(n1)(1, 6).std_str() + "->" + texvec(n2)(1, 6).std_str());
       }
       for (int i = 1; i <= ioutcs; ++i) { // tacs
         auto n2 = ivarb(kjout + 1);
         n2 = ivarb(klntab + n2);
-        cmn.out_stream << ',' << text1(1, 6).std_str() << "->" << texvec(n2)(1, 6).std_str();
+        cmn.plot.column(text1(1, 6).std_str() + "->" + texvec(n2)(1, 6).std_str());
       }
       for (int i = 1; i <= numout; ++i) { // universal machine
         auto n1 = ispum(n17 + i);
         auto n2 = ispum(n19 + i);
-        cmn.out_stream << ',' << busum(n1)(1, 6).std_str() << "->" << busum(n2)(1, 6).std_str();
+        cmn.plot.column(busum(n1)(1, 6).std_str() + "->" + busum(n2)(1, 6).std_str());
       }
       
-      cmn.out_stream << '\n';
+      cmn.plot.end_header();
+    }
+  }
+  //  VOLTI  GATHERS ONE STEP OF ALL OUTPUT CHANNELS FOR  "PLTFIL" .   ITS
+  //  DEFAULT SIZE IS NOT A LIMIT:  GROW IT WITH THE NUMBER OF CHANNELS
+  //  (THE FREQUENCY SCAN OF  "SUBTS3"  USES SIX CELLS PER NODE VOLTAGE).
+  {
+    auto& volti = static_cast<common_c0b123&>(cmn).volti;
+    auto const n = 6 * std::size_t(numnvo + nc + nsmout + ioutcs + numout + 1);
+    if (volti.size() < n) {
+      volti.resize(n);
     }
   }
 statement_3106:
@@ -52699,6 +53038,21 @@ statement_1302:
   statement_1303:;
   }
   ii = 1;
+  //C     COMPILED REPEAT SOLUTION (REPEAT_SOLUTION.H), ONCE PER NEW FACTORS
+  if (iprsup < 4 && cmn.solve_mode != SolveMode::legacy) {
+    auto& ysolve = cmn.ysolve;
+    if (!ysolve.current(cmn.factor_serial, iupper, kpartb, ntot)) {
+      ysolve.build(km, ykm, kk, kode, iupper, kpartb, ntot, cmn.factor_serial);
+    }
+    if (ysolve.built()) {
+      if (cmn.solve_mode == SolveMode::compiled) {
+        ysolve.solve(&e(1));
+        ysolve.count_solve();
+        goto statement_1550;
+      }
+      ysolve.bench_begin(&e(1), ntot);  // then timed FORTRAN loops
+    }
+  }
   if (iprsup < 4) {
     goto statement_1410;
   }
@@ -52789,6 +53143,9 @@ statement_5218:
   L = L - 1;
   goto statement_5211;
 statement_1550:
+  if (cmn.ysolve.bench_pending()) {
+    cmn.ysolve.bench_end(&e(1));
+  }
   if (inonl == cmn.num99) {
     goto statement_1570;
   }
@@ -57417,7 +57774,14 @@ void subts1(
   double& t = cmn.t;
   double& fltinf = cmn.fltinf;
   double& flzero = cmn.flzero;
-  auto& voltbc = cmn.voltbc;
+  //  VOLTBC HOLDS 50 COMPENSATED COLUMNS; MORE TAKE CELLS OF THEIR OWN
+  int const nvoltb = std::max(cmn.ncomp, int(cmn.voltbc.size_1d()));
+  if (int(cmn.voltbc_columns.size()) < nvoltb &&
+      nvoltb > int(cmn.voltbc.size_1d())) {
+    cmn.voltbc_columns.resize(nvoltb);
+  }
+  arr_ref<double> voltbc(nvoltb > int(cmn.voltbc.size_1d()) ?
+    cmn.voltbc_columns(1) : cmn.voltbc(1), dimension(nvoltb));
   const auto& moncar = cmn.moncar;
   auto& max99m = cmn.max99m;
   auto& lstat = cmn.lstat;
@@ -57651,6 +58015,8 @@ void subts1(
   double ai = fem::double0;
   int knode = fem::int0;
   int mnode = fem::int0;
+  auto tfac = std::chrono::steady_clock::now();
+  int nfirst = fem::int0;
   int nn15 = fem::int0;
   static const char* format_806 =
     "(51x,a6,' ''',a6,''' TO ''',a6,'''  ',a6,'G AFTER',e12.5,' SEC.')";
@@ -59017,9 +59383,25 @@ statement_3991:
     last14(cmn);
   }
   //C       &&&&&&&&&& ENTER RETRIANGULARIZATION OF COMPLETE (Y)            M32.5093
+  tfac = std::chrono::steady_clock::now();
   move0(kssfrq, ntot);
   ii = 0;
   L = 1;
+  //C     ROWS AHEAD OF THE FIRST ONE WHICH THE CHANGES OF (Y) AND OF THE
+  //C     SWITCH CHAINS REACH ARE KEPT (PARTIAL_FACTOR.H).
+  //C     A SWITCH CONFIGURATION MET BEFORE GETS ITS FACTORS BACK FROM THE
+  //C     CACHE (FACTOR_CACHE.H), WHEN (Y) IS THE SAME TOO.
+  if (cmn.factor_cache.enabled() && cmn.factor_cache.restore(km, ykm, kk, kks,
+      kode, ntot, kpartb, iupper, cmn.refactor)) {
+    cmn.factor_serial++;
+    goto statement_2295;
+  }
+  nfirst = 2;
+  if (cmn.partial_refactor) {
+    nfirst = cmn.refactor.first_row(km, ykm, kks, kode, ntot, kpartb);
+    L = nfirst - 1;
+    ii = cmn.refactor.end(L);
+  }
   goto statement_2290;
 statement_2205:
   L++;
@@ -59268,10 +59650,22 @@ statement_2285:
   lstat(19) = 2290;
   goto statement_9200;
 statement_2290:
+  cmn.refactor.row_end(L, ii);
   if (L < kpartb) {
     goto statement_2205;
   }
   iupper = ii;
+  cmn.factor_serial++;  // SUBTS3 recompiles its repeat solution
+  if (cmn.partial_refactor) {
+    cmn.refactor.snapshot(km, ykm, kks, kode, ntot, kpartb);
+  }
+  cmn.refactor.count(nfirst, kpartb, std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - tfac).count());
+  if (cmn.factor_cache.enabled() && nwarn >= 0) {
+    cmn.factor_cache.store(km, ykm, kk, kks, kode, ntot, kpartb, iupper,
+      cmn.refactor);
+  }
+statement_2295:
   if (nwarn < 0) {
     nwarn = 1;
   }
@@ -59381,6 +59775,23 @@ statement_2321:
       }
     }
   }
+  //C     ALL NCOMP COLUMNS IN ONE PASS OVER THE FACTORS (REPEAT_SOLUTION.H),
+  //C     WHEN THERE ARE ENOUGH OF THEM AND (Y) IS DENSE ENOUGH TO PAY.
+  if (iprsup < 2 && cmn.solve_mode != SolveMode::legacy) {
+    auto& ysolve = cmn.ysolve;
+    if (!ysolve.current(cmn.factor_serial, iupper, kpartb, ntot)) {
+      ysolve.build(km, ykm, kk, kode, iupper, kpartb, ntot, cmn.factor_serial);
+    }
+    if (ysolve.built()) {
+      if (cmn.solve_mode == SolveMode::bench) {
+        ysolve.bench_columns_begin(&znonl(1), ncomp, ntot);  // then the loops
+      }
+      else if (ysolve.columns_pay(ncomp)) {
+        ysolve.solve_columns(&znonl(1), ncomp, ntot);
+        goto statement_2550;
+      }
+    }
+  }
   ii = 1;
   n4 = -kpartb;
 statement_2410:
@@ -59428,7 +59839,10 @@ statement_2500:
   if (ii == 1) {
     goto statement_2550;
   }
-  move0(voltbc, ncomp);
+  //C     ALL NCOMP CELLS: MOVE0 STOPS SHORT OF THE LAST CELL OF ITS ARRAY
+  FEM_DO_SAFE(m, 1, ncomp) {
+    voltbc(m) = 0.0f;
+  }
 statement_2510:
   ii = ii - 1;
   k = km(ii);
@@ -59467,6 +59881,9 @@ statement_2528:
   goto statement_2528;
   //C             FIND DIFFERENCES OF COLUMNS OF INVERSE FOR NONLINEARITIES    13185
 statement_2550:
+  if (cmn.ysolve.bench_columns_pending()) {
+    cmn.ysolve.bench_columns_end(&znonl(1));
+  }
   if (inonl <= num99) {
     goto statement_2616;
   }
@@ -59954,6 +60371,7 @@ void subts2(
   double gus4 = fem::double0;
   double d1 = fem::double0;
   int ky = fem::int0;
+  int lg = fem::int0;
   int koff11 = fem::int0;
   int kq = fem::int0;
   int kqk0 = fem::int0;
@@ -60137,6 +60555,10 @@ void subts2(
   isfd = 0;
   ikf = 0;
   kaa = 0;
+  //C     CONSTANT-PARAMETER LINES TAKE THEIR HISTORY FROM RINGS BY TRAVEL
+  //C     TIME, ALL UPDATED HERE AT ONCE (LINE_HISTORY.H).
+  cmn.lines.begin(cmn.line_history && iprsup == 0 && modout == 0 && t <= tmax,
+    t, ipoint, lpast, unity, e, xk, xm);
   //C                                        ACCUMULATION OF NODE CURRENTS FM44.1702
   //C                                                          UPDATING LINEM44.1703
 statement_1100:
@@ -60884,9 +61306,30 @@ statement_119:
   //C  4340 IF ( KODSEM(K) .NE. 0  .AND.                                    M44.2251
   //C     1     IMODEL(K) .NE. -2 )  GO TO 11780    !if this is semlyen caseM44.2252
 statement_4340:
+  if (cmn.lines.active()) {
+    lg = cmn.lines.group(k);
+    if (lg >= 0) {
+      FEM_DO_SAFE(j, 1, cmn.lines.phases(lg)) {
+        n1 = cmn.lines.node_k(lg, j - 1);
+        n2 = cmn.lines.node_m(lg, j - 1);
+        f(n1) += cmn.lines.current_k(lg, j - 1);
+        f(n2) += cmn.lines.current_m(lg, j - 1);
+        k++;
+      }
+      ci1 = 0;
+      ck1 = 0.f;
+      it2 = 0;
+      goto statement_1200;
+    }
+  }
   if (kodsem(k) != 0 && imodel(k) >= 0) {
     goto statement_11780;
   }
+  if (cmn.lines.recording() && modout == 0) {
+    cmn.lines.record(k, it2 > 0 ? 1 : iabsz(it2),
+      length(k) > 0 ? length(k) : length(k + 1), kbus, mbus, imodel, nr,
+      litype, cik, ci, ck, qfd);
+  }
   if (it2 > 0) {
     it2 = 1;
   }
@@ -61110,6 +61553,23 @@ statement_10125:
   //C     UPDATE HISTORY VECTORS                                            M31.3233
   aikd = vkd * d23 - cnvhst(n11 + 13);
   aimd = vmd * d23 - cnvhst(n11 + 14);
+  //C     ALL POLES OF THE MODE AT ONCE (FD_CONVOLUTION.H)
+  if (cmn.fd_convolution) {
+    FdConvolution::zeros(&sconst(n31 + 1), &sconst(n31 + nrz + 1),
+      &sconst(n31 + nrz2 + 1), &sconst(n31 + n32 + 1),
+      &sconst(n31 + n32 + nrz + 1), aikd, cnvhst(n11 + 5), aimd,
+      cnvhst(n11 + 6), nrz);
+    FdConvolution::poles(&sconst(n10 + 1), &sconst(n10 + nra + 1),
+      &sconst(n10 + 2 * nra + 1), &sconst(n34 + 1), &sconst(n34 + nra + 1),
+      cnvhst(n11 + 8), cnvhst(n11 + 7), cnvhst(n11 + 10), cnvhst(n11 + 9),
+      nra);
+    //C     LAST CELLS OF THE HISTORY VECTORS, AS THE LOOPS BELOW LEAVE THEM
+    nn4 = n31 + n32 + nrz;
+    nn5 = nn4 + nrz;
+    nn9 = n34 + nra;
+    nn10 = nn9 + nra;
+    goto statement_81010;
+  }
   FEM_DO_SAFE(ii, 1, nrz) {
     nn1 = n31 + ii;
     nn2 = nn1 + nrz;
@@ -61145,6 +61605,7 @@ statement_10125:
     sconst(nn10) = sconst(nn6) * sconst(nn10) + sconst(nn7) * cnvhst(
       n11 + 10) + sconst(nn8) * cnvhst(n11 + 9);
   }
+statement_81010:
   cnvhst(n11 + 5) = aikd;
   cnvhst(n11 + 6) = aimd;
   nrf = ind + n1 - 1;
@@ -61209,6 +61670,11 @@ statement_10125:
 statement_81000:
   ekh = sconst(n3) * cnvhst(n11 + 5);
   emh = sconst(n3) * cnvhst(n11 + 6);
+  if (cmn.fd_convolution) {
+    FdConvolution::sums(ekh, emh, &sconst(n31 + 1), &sconst(n33 + 1),
+      &sconst(n33 + nrz + 1), nrz);
+    goto statement_81020;
+  }
   FEM_DO_SAFE(ii, 1, nrz) {
     n4 = n31 + ii;
     n5 = n33 + ii;
@@ -61218,6 +61684,7 @@ statement_81000:
     ekh += sconst(n4) * sconst(n5);
     emh += sconst(n4) * sconst(n6);
   }
+statement_81020:
   //C                                                                       M44.2286
   //C     INTERPOLATION PROCESS FOR LAST POINT OF FORWARD FUNCTIONS         M31.3296
   //C                                                                       M44.2287
@@ -61249,6 +61716,13 @@ statement_81000:
     3) * cnvhst(n11 + 7);
   cnvhst(n11 + 12) = sconst(n7 + 2) * cnvhst(n11 + 10) + sconst(n7 +
     3) * cnvhst(n11 + 9);
+  if (cmn.fd_convolution) {
+    FdConvolution::sums(cnvhst(n11 + 11), cnvhst(n11 + 12), &sconst(n10 + 1),
+      &sconst(n34 + 1), &sconst(n34 + nra + 1), nra);
+    //C     II AS LEFT BY THE LOOP
+    ii = nra + 1;
+    goto statement_81030;
+  }
   FEM_DO_SAFE(ii, 1, nra) {
     n8 = n10 + ii;
     n9 = n34 + ii;
@@ -61259,6 +61733,7 @@ statement_81000:
     cnvhst(n11 + 11) += sconst(n8) * sconst(n9);
     cnvhst(n11 + 12) += sconst(n8) * sconst(n9 + nra);
   }
+statement_81030:
   cnvhst(n11 + 13) = (ekh + cnvhst(n11 + 11)) * d23;
   cnvhst(n11 + 14) = (emh + cnvhst(n11 + 12)) * d23;
   h1 = cnvhst(n11 + 13);
@@ -62030,6 +62505,7 @@ statement_1200:
   if (k <= ibr) {
     goto statement_1100;
   }
+  cmn.lines.compile(ipoint, lpast, xk, xm);
   cmn.lastov = nchain;
   nchain = 18;
   if (iprsup >= 4) {
@@ -62201,6 +62677,346 @@ catch (...) {
   std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
 }
 
+// The saved locals of the subroutines of this file in a snapshot (see
+// snapshot_step), in the order of their definition.
+void snapshot_saves_2(
+  Snapshot& s,
+  common& cmn) try
+{
+  if (auto* v = s.saved<over1_save>(cmn.over1_sve, "over1")) {
+    s(v->ll1, v->ll11, v->ll20, v->ll24, v->ll25, v->ll30, v->ll40, v->ll6,
+      v->ll60, v->ll64, v->ll8, v->ll80, v->text1, v->text2, v->text3, v->text4,
+      v->text5, v->text6);
+  }
+  if (auto* v = s.saved<inlmfs_save>(cmn.inlmfs_sve, "inlmfs")) {
+    s(v->komlev);
+  }
+  if (auto* v = s.saved<over2_save>(cmn.over2_sve, "over2")) {
+    s(v->ibrnam, v->inonam, v->nfscan, v->text1, v->text10, v->text11,
+      v->text12, v->text13, v->text14, v->text16, v->text17, v->text2, v->text3,
+      v->text4, v->text5, v->text6, v->text7, v->text8, v->text9);
+  }
+  if (auto* v = s.saved<nonln2_save>(cmn.nonln2_sve, "nonln2")) {
+    s(v->text1, v->text2);
+  }
+  if (auto* v = s.saved<distr2_save>(cmn.distr2_sve, "distr2")) {
+    s(v->ipsem, v->text10, v->text11, v->text12, v->text13, v->text14, v->text2,
+      v->text3, v->text4, v->text5, v->text6, v->text7, v->text8, v->text9,
+      v->textmx);
+  }
+  if (auto* v = s.saved<over3_save>(cmn.over3_sve, "over3")) {
+    s(v->text1, v->text2, v->text3, v->text4);
+  }
+  if (auto* v = s.saved<umdatb_save>(cmn.umdatb_sve, "umdatb")) {
+    s(v->tesm1, v->tesm2, v->tesm3, v->tesm4, v->tesm5, v->tesm6, v->tesm7,
+      v->tesm8, v->tesm9, v->textm);
+  }
+  if (auto* v = s.saved<umdata_save>(cmn.umdata_sve, "umdata")) {
+    s(v->tesm1, v->tesm2, v->tesm3, v->tesm4, v->tesm5, v->tesm6, v->tesm7,
+      v->tesm8, v->tesm9, v->textm);
+  }
+  if (auto* v = s.saved<smdat_save>(cmn.smdat_sve, "smdat")) {
+    s(v->text1, v->text10, v->text11, v->text12, v->text16, v->text17,
+      v->text18, v->text19, v->text2, v->text20, v->text21, v->text3, v->text7,
+      v->text8);
+  }
+  if (auto* v = s.saved<over5a_save>(cmn.over5a_sve, "over5a")) {
+    s(v->text12);
+  }
+  if (auto* v = s.saved<over5_save>(cmn.over5_sve, "over5")) {
+    s(v->text1, v->text13, v->text14, v->text15, v->text16, v->text17, v->text2,
+      v->text5, v->text6, v->text7, v->text8);
+  }
+  if (auto* v = s.saved<over11_save>(cmn.over11_sve, "over11")) {
+    s(v->nfsout, v->text1, v->text2, v->text3, v->text4, v->text5, v->text6);
+  }
+  if (auto* v = s.saved<smint_save>(cmn.smint_sve, "smint")) {
+    s(v->text1);
+  }
+  if (auto* v = s.saved<pltfil_save>(cmn.pltfil_sve, "pltfil")) {
+    s(v->forbyt, v->n13, v->n17, v->n7);
+  }
+  if (auto* v = s.saved<sandnm_save>(cmn.sandnm_sve, "sandnm")) {
+    s(v->L);
+  }
+  if (auto* v = s.saved<randnm_save>(cmn.randnm_sve, "randnm")) {
+    s(v->seed, v->knt, v->ksw, v->key, v->ctr, v->bulk);
+  }
+  if (auto* v = s.saved<over13_save>(cmn.over13_sve, "over13")) {
+    s(v->text1, v->text2);
+  }
+  if (auto* v = s.saved<zincox_save>(cmn.zincox_sve, "zincox")) {
+    s(v->text1, v->text2, v->text3, v->text4);
+  }
+  if (auto* v = s.saved<smout_save>(cmn.smout_sve, "smout")) {
+    s(v->digit, v->text1, v->texta, v->textb);
+  }
+  if (auto* v = s.saved<over15_save>(cmn.over15_sve, "over15")) {
+    s(v->text1, v->text10, v->text11, v->text12, v->text4, v->text5, v->text6,
+      v->text7, v->text8, v->text9);
+  }
+  if (auto* v = s.saved<analyt_save>(cmn.analyt_sve, "analyt")) {
+    s(v->n16);
+  }
+  if (auto* v = s.saved<subts1_save>(cmn.subts1_sve, "subts1")) {
+    s(v->nwarn, v->text1, v->text10, v->text11, v->text12, v->text13, v->text2,
+      v->text3, v->text4, v->text5, v->text6, v->text8, v->text9);
+  }
+  if (auto* v = s.saved<yserlc_save>(cmn.yserlc_sve, "yserlc")) {
+    s(v->ccon, v->ixcopt, v->xcon);
+  }
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
+// A snapshot put into  cmn  (snapshot_step, sweep_next). The helpers of the
+// step (partial_factor.h, factor_cache.h, zno_newton.h, line_history.h,
+// repeat_solution.h) keep nothing which is not in the COMMON blocks too,
+// so they are only built again.
+static void snapshot_load(
+  Snapshot& s,
+  common& cmn)
+{
+  auto& plan = cmn.snapshots;
+  snapshot_common(s, cmn);
+  snapshot_saves_1(s, cmn);
+  snapshot_saves_2(s, cmn);
+  s.finish();
+  cmn.refactor.invalidate();  // NEW (Y), FACTORS START OVER
+  cmn.factor_cache.clear();
+  cmn.zno.clear();
+  cmn.lines.invalidate();
+  cmn.factor_serial++;  // SUBTS3 recompiles its repeat solution
+  cmn.bus_names.invalidate();
+  cmn.texvec_names.invalidate();
+  cmn.plot.resume(s.header().plot_steps);
+  plan.next = 0;
+  while (plan.next < plan.times.size()
+    && plan.times[plan.next] - cmn.deltat / 2 <= cmn.t) {
+    plan.next++;
+  }
+}
+
+// The state of  cmn  into a snapshot at the top of a time step.
+static void snapshot_save(
+  Snapshot& s,
+  common& cmn)
+{
+  snapshot_common(s, cmn);
+  snapshot_saves_1(s, cmn);
+  snapshot_saves_2(s, cmn);
+  s.finish();
+}
+
+static SnapshotHeader snapshot_header(
+  common& cmn)
+{
+  if (cmn.lines.active()) {  // the rings go into XK / XM
+    cmn.lines.store(cmn.lpast, cmn.xk, cmn.xm);
+  }
+  SnapshotHeader h;
+  h.scale = emtp::table_scale();
+  h.loop = cmn.snapshots.loops;
+  h.step = cmn.istep;
+  h.t = cmn.t;
+  h.deltat = cmn.deltat;
+  h.plot_steps = cmn.plot.steps();
+  h.deck_hash = cmn.inp_deck.hash();
+  h.deck = cmn.snapshots.deck;
+  return h;
+}
+
+// Snapshots of the time loop (snapshot.h), at the top of a time step of
+// OVER16. The state is written once T reaches the next time asked for; a
+// restart file is loaded at the first step of the same time loop of the
+// deck, over the state the deck has built up to there. A sweep (sweep.h)
+// keeps the state in memory at the first step of the first time loop, or
+// just after the restart file is loaded. The energizations of a
+// STATISTICS or SYSTEMATIC case are not snapshot.
+void snapshot_step(
+  common& cmn) try
+{
+  auto& plan = cmn.snapshots;
+  auto& sweep = cmn.sweep;
+  if (plan.times.empty() && plan.restart.empty() && sweep.variants.empty()) {
+    return;
+  }
+  if (cmn.nenerg != 0) {
+    return;
+  }
+  common_write write(cmn);
+  auto& lunit6 = cmn.lunit6;
+  auto& t = cmn.t;
+  auto const deltat = cmn.deltat;
+  bool restarted = false;
+  if (cmn.istep == 0) {
+    plan.loops++;
+    plan.next = 0;
+    if (!plan.restart.empty() && !plan.loaded) {
+      auto const t0 = std::chrono::steady_clock::now();
+      Snapshot s(plan.restart);
+      auto const& h = s.header();
+      if (h.loop != plan.loops) {
+        return;
+      }
+      if (h.deck_hash != cmn.inp_deck.hash()) {
+        throw std::runtime_error("snapshot '" + plan.restart
+          + "' is of another data deck (" + h.deck + ")");
+      }
+      snapshot_load(s, cmn);
+      plan.loaded = true;
+      restarted = true;
+      std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+      double const sec = std::max(dt.count(), 1.e-9);
+      write(lunit6,
+        "(/,' START AGAIN FROM SNAPSHOT ',a,' AT T =',e14.6,'   STEP',i9,"
+        "'   ROWS',i9)"),
+        plan.restart, t, cmn.istep, int(h.plot_steps);
+      write(lunit6,
+        "(5x,i10,' KBYTES READ IN',f10.6,' SEC.',f9.1,' MB/SEC.')"),
+        int(s.bytes() >> 10), sec, s.bytes() / sec / 1.e6;
+    }
+  }
+  if (!sweep.variants.empty() && !sweep.captured
+    && (plan.restart.empty() ? cmn.istep == 0 && plan.loops == 1 : restarted)) {
+    auto const t0 = std::chrono::steady_clock::now();
+    Snapshot s(sweep.state, snapshot_header(cmn));
+    snapshot_save(s, cmn);
+    sweep.captured = true;
+    std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+    write(lunit6,
+      "(/,' SWEEP OF',i5,' VARIANTS FROM T =',e14.6,'   STATE OF',i10,"
+      "' KBYTES KEPT IN',f10.6,' SEC.')"),
+      int(sweep.variants.size()), t, int(s.bytes() >> 10), dt.count();
+  }
+  if (restarted) {
+    return;
+  }
+  if (plan.next >= plan.times.size() || t < plan.times[plan.next] - deltat / 2
+    || t > cmn.tmax) {
+    return;
+  }
+  while (plan.next < plan.times.size()
+    && plan.times[plan.next] - deltat / 2 <= t) {
+    plan.next++;
+  }
+  auto const t0 = std::chrono::steady_clock::now();
+  SnapshotHeader const h = snapshot_header(cmn);
+  std::string const file = plan.base + ".snap" + std::to_string(++plan.written);
+  Snapshot s(file, h);
+  snapshot_save(s, cmn);
+  std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+  double const sec = std::max(dt.count(), 1.e-9);
+  write(lunit6,
+    "(/,' SNAPSHOT ',a,' AT T =',e14.6,'   STEP',i9,'   ROWS',i9)"),
+    file, t, cmn.istep, int(h.plot_steps);
+  write(lunit6,
+    "(5x,i10,' KBYTES WRITTEN IN',f10.6,' SEC.',f9.1,' MB/SEC.')"),
+    int(s.bytes() >> 10), sec, s.bytes() / sec / 1.e6;
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
+// End of a time loop in OVER20: the next variant of a sweep (sweep.h), if
+// any, from the state kept by snapshot_step, with its switch times; its
+// rows go to "<.out>.<tag>". Returns false when the sweep is done, with
+// the rows back in the .out of the deck.
+bool sweep_next(
+  common& cmn) try
+{
+  auto& sweep = cmn.sweep;
+  if (!sweep.captured) {
+    return false;
+  }
+  if (sweep.next >= sweep.variants.size()) {
+    if (sweep.out.is_open()) {
+      cmn.plot.home();
+      sweep.out.close();
+    }
+    return false;
+  }
+  common_write write(cmn);
+  auto& lunit6 = cmn.lunit6;
+  auto const& v = sweep.variants[sweep.next++];
+  auto const t0 = std::chrono::steady_clock::now();
+  Snapshot s(sweep.state);
+  snapshot_load(s, cmn);
+  std::chrono::duration<double> const dt = std::chrono::steady_clock::now() - t0;
+  auto name = [&](int n) {
+    return std::string(cmn.bus(fem::iabs(n))(1, 6));
+  };
+  std::vector<int> found;
+  for (auto const& sw : v.switches) {
+    //  THE NODES IN THE ORDER OF THE SWITCH CARD FIRST, SINCE A PAIR OF
+    //  NODES MAY HAVE TWO SWITCHES (A RESTRIKE), THEN EITHER WAY ROUND
+    int k = 0;
+    for (int pass = 0; pass < 2 && k == 0; pass++) {
+      for (int i = 1; i <= cmn.kswtch && k == 0; i++) {
+        std::string const b1 = name(cmn.kmswit(i));
+        std::string const b2 = name(cmn.kmswit(cmn.lswtch + i));
+        if ((b1 == sw.bus1 && b2 == sw.bus2)
+          || (pass == 1 && b1 == sw.bus2 && b2 == sw.bus1)) {
+          k = i;
+        }
+      }
+    }
+    if (k == 0) {
+      throw std::runtime_error("sweep variant '" + v.tag + "': no switch from '"
+        + sw.bus1 + "' to '" + sw.bus2 + "'");
+    }
+    if ((sw.close && sw.tclose < cmn.t) || (sw.open && sw.topen < cmn.t)) {
+      throw std::runtime_error("sweep variant '" + v.tag + "': switch '"
+        + sw.bus1 + "' to '" + sw.bus2 + "' changes before the state it starts from");
+    }
+    //  A TIME OF THE DECK ALREADY REACHED IS IN THE STATE AND CANNOT BE
+    //  MOVED: TCLOSE OR TOPEN <= T, OR KPOS SAYS THE SWITCH HAS CLOSED
+    //  (1-3: E.G. TCLOSE = -1, CLOSED IN THE STEADY STATE, WHERE TCLOSE IS
+    //  REUSED) OR HAS OPENED FOR GOOD (5)
+    int const pos = fem::iabs(cmn.kpos(k));
+    bool const closed = sw.close && ((pos >= 1 && pos <= 3) || cmn.tclose(k) <= cmn.t);
+    bool const opened = (sw.close || sw.open) && pos == 5;
+    if (closed || opened || (sw.open && cmn.topen(k) <= cmn.t)) {
+      throw std::runtime_error("sweep variant '" + v.tag + "': switch '"
+        + sw.bus1 + "' to '" + sw.bus2 + "' has already "
+        + (closed ? "closed" : "opened") + " in the state it starts from");
+    }
+    if (sw.close) {
+      cmn.tclose(k) = sw.tclose;
+    }
+    if (sw.open) {
+      cmn.topen(k) = sw.topen;
+    }
+    found.push_back(k);
+  }
+  std::string const file = cmn.snapshots.base + "." + v.tag;
+  if (sweep.out.is_open()) {
+    cmn.plot.home();
+    sweep.out.close();
+  }
+  sweep.out.open(file);
+  if (!sweep.out.is_open()) {
+    throw std::runtime_error("Cannot open '" + file + "' !");
+  }
+  cmn.plot.branch(sweep.out, file + ".bin");
+  write(lunit6,
+    "(/,' SWEEP VARIANT',i5,'  ',a,'  FROM T =',e14.6,'   ROWS TO ',a)"),
+    int(sweep.next), v.tag, cmn.t, file;
+  for (int k : found) {
+    write(lunit6,
+      "(5x,'SWITCH ',a6,' TO ',a6,'   TCLOSE =',e14.6,'   TOPEN =',e14.6)"),
+      name(cmn.kmswit(k)), name(cmn.kmswit(cmn.lswtch + k)), cmn.tclose(k),
+      cmn.topen(k);
+  }
+  write(lunit6, "(5x,i10,' KBYTES OF STATE READ IN',f10.6,' SEC.')"),
+    int(s.bytes() >> 10), dt.count();
+  return true;
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
 // 16.  FIRST QUARTER OF TIME-STEP LOOP (CHECKING FOR CHANGES OF     
 //      SWITCHES AND PSEUDO-NONLINEAR ELEMENTS, RETRIANGULARIZATION  
 //      OF YBB  AND CALCULATION OF THEVENIN IMPEDANCE VECTORS).     
@@ -62264,6 +63080,9 @@ statement_2468:
   if (cmn.m4plot == 1) {
     emtspy(cmn);
   }
+  if (nchain == 16) {
+    snapshot_step(cmn);
+  }
   n1 = nchain - 15;
   iprsup = iprsov(nchain);
   if (n1 > 4) {
@@ -62427,6 +63246,7 @@ void over20(
   auto& flstat = cmn.flstat;
   double& angle = cmn.angle;
   //auto& moncar = cmn.moncar;
+  auto& lunit3 = cmn.lunit3;
   auto& lunit7 = cmn.lunit7;
   int& max99m = cmn.max99m;
   const auto& ipntv = cmn.ipntv;
@@ -62821,6 +63641,13 @@ statement_4020:
   //C     CODE BELOW IS JUST FOR  'STATISTICS'  OR  'SYSTEMATIC'  RUNS. ----M22.5409
 statement_605:
   nstat = k;
+  if (cmn.energ_knt > 0) {
+    //  WORKER CONTEXT:  THE MASTER MERGES THE EXTREMA IN  KNT  ORDER.
+    cmn.energ_plan->capture(cmn);
+    lastov = nchain;
+    nchain = 55;
+    goto statement_99999;
+  }
   FEM_DO_SAFE(L, 1, nstat) {
     ndx1 = 2 * lsiz12 + L;
     if (-xmax(ndx1) <= xmax(L)) {
@@ -62940,6 +63767,28 @@ statement_627:
   if (knt > fem::iabs(nenerg)) {
     goto statement_610;
   }
+  if (cmn.energ_plan != nullptr && cmn.energ_plan->pending()) {
+    //  NEXT ENERGIZATION, AS SIMULATED BY A WORKER CONTEXT.  ITS SWITCH
+    //  TIMES GO ON  LUNIT3  AS S.N. 300 OF  "OVER12"  WRITES THEM.
+    cmn.energ_plan->restore(cmn, knt);
+    {
+      auto const& times = cmn.energ_times;
+      write_loop wloop(cmn, lunit3, fem::unformatted);
+      wloop, times[0];
+      for (int i = 1; i <= kswtch; ++i) {
+        wloop, times[i];
+      }
+    }
+    {
+      auto const& times = cmn.energ_times;
+      write_loop wloop(cmn, lunit3, fem::unformatted);
+      wloop, times[0];
+      for (int i = 1; i <= kswtch; ++i) {
+        wloop, times[kswtch + i];
+      }
+    }
+    goto statement_605;
+  }
   lastov = nchain;
   nchain = 12;
   if (iprsup >= 1) {
@@ -62947,10 +63796,15 @@ statement_627:
   }
   goto statement_99999;
 statement_610:
+  if (cmn.energ_plan != nullptr) {
+    cmn.energ_plan->finish();
+  }
   write(lunit6, "(/,/,1x)");
   //? cmn.lunit5 = mtape;
   //C     RESET NUMDCD COUNTER IF IT IS NOT A OMIT BASE CASE                M36.1668
-  if (lstat(15) != cmn.intinf) {
+  //  (THE CARDS WHICH S.N. 702 OF  "OVER12"  SKIPS AGAIN FOR EACH KNT;
+  //  NOT READ WHEN THE WORKER CONTEXTS SIMULATED THE ENERGIZATIONS)
+  if (lstat(15) != cmn.intinf && cmn.energ_plan == nullptr) {
     numdcd = numdcd - ipntv(11);
   }
   write(lunit6, format_659);
@@ -63017,6 +63871,20 @@ statement_7314:
   }
   goto statement_99999;
 statement_9800:
+  if (cmn.energ_plan != nullptr && cmn.energ_plan->pending()) {
+    //  BASE CASE DONE.  "OVER12" ZEROED  NENERG  FOR IT, WHILE THE WORKER
+    //  CONTEXTS SIMULATED ALL OF THE ENERGIZATIONS.
+    nenerg = cmn.energ_plan->nenerg();
+    knt = 1;
+    k = lstat(32);
+    goto statement_627;
+  }
+  if (sweep_next(cmn)) {
+    //  NEXT VARIANT OF A SWEEP, FROM THE STATE AT THE START OF THE LOOP
+    lastov = nchain;
+    nchain = 16;
+    goto statement_99999;
+  }
   if (m4plot != 1) {
     goto statement_9810;
   }
@@ -34,7 +34,9 @@ SOFTWARE.
 #include <fstream>
 #include <cstdlib>
 #include <cmath>
+#include <cstdint>
 #include <string>
+#include <sstream>
 #include <iomanip>
 #include <filesystem>
 #include <vector>
@@ -43,9 +45,33 @@ SOFTWARE.
 #include <random>
 #include <cassert>
 #include <unordered_map>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <exception>
 //#include <span>
 #pragma warning (disable: 4267 4297)
 #include <fem.hpp> // Fortran EMulation library of fable module
+#include "plot_file.h"
+#include "deck_reader.h"
+#include "repeat_solution.h"
+#include "node_order.h"
+#include "partial_factor.h"
+#include "factor_cache.h"
+#include "zno_newton.h"
+#include "line_history.h"
+#include "fd_convolution.h"
+#include "step_pipeline.h"
+#include "snapshot.h"
+#include "sweep.h"
+#include "node_names.h"
+#include "line_constants.h"
+#include "cable_constants.h"
+#include "tacs_bytecode.h"
 
 
 
@@ -180,9 +206,39 @@ namespace emtp {
     std::string str("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz");
     std::mt19937 generator(std::random_device{}());
     std::shuffle(str.begin(), str.end(), generator);
-    return str.substr(0, length);    // assumes 32 < number of characters in str         
+    return str.substr(0, length);    // assumes 32 < number of characters in str
   }
 
+  // Counter-based (SplitMix64) generator: draw n of the stream keyed by
+  // (seed, knt, ksw) is a pure function of those values, so any context
+  // reproduces it, in any order, without shared state.
+  struct CounterRng
+  {
+    static constexpr std::uint64_t golden = 0x9e3779b97f4a7c15ull;
+    static constexpr std::uint64_t mix(std::uint64_t z) {
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      return z ^ (z >> 31);
+    }
+    static constexpr std::uint64_t key(std::uint64_t seed, std::uint64_t knt, std::uint64_t ksw) {
+      return mix(mix(mix(seed + golden) ^ knt) + golden * ksw);
+    }
+    // uniform over the open interval (0, 1): never exactly 0 nor 1
+    static double uniform(std::uint64_t key, std::uint64_t n) {
+      return (double(mix(key + golden * (n + 1)) >> 11) + 0.5) * 0x1p-53;
+    }
+    // bulk mode: the first draw of streams ksw = 1..nsw for energizations
+    // knt = knt1..knt1+nknt-1, row-major by knt.  No loop-carried state.
+    static void fill(double* out, std::uint64_t seed, int knt1, int nknt, int nsw) {
+      for (int i = 0; i < nknt; ++i) {
+        auto const k = mix(mix(seed + golden) ^ std::uint64_t(knt1 + i));
+        for (int j = 0; j < nsw; ++j)
+          out[std::size_t(i) * nsw + j] =
+            (double(mix(mix(k + golden * std::uint64_t(j + 1)) + golden) >> 11) + 0.5) * 0x1p-53;
+      }
+    }
+  };
+
   inline std::string_view trim_left(const std::string_view strv) {
     return strv.substr(std::min(strv.find_first_not_of(' '), strv.size()));
   }
@@ -451,6 +507,18 @@ namespace emtp {
       "Missing function implementation: ustart");
   }
 
+  // Capacity multiplier of the variable-dimensioned EMTP lists (DIMENS)
+  // and of the COMMON arrays behind them; 1 gives the stock BPA sizes.
+  // It is read on the simulation thread while a  common  is constructed
+  // and while DIMENS runs (see Simulation::table_scale).
+  inline int& table_scale() {
+    static thread_local int scale = 1;
+    return scale;
+  }
+  inline int tabsiz(int n) {
+    return n * table_scale();
+  }
+
 /* Dependency cycles: 1
      emtspy spying spyink cimage frefld freone tacs1 tacs1a
  */
@@ -942,7 +1010,7 @@ struct common_c29b01
   arr<int> karray;
   ArraySpan<double> farray;
   common_c29b01() :
-    karray(dimension(1992869), fem::fill0)
+    karray(dimension(tabsiz(1992869)), fem::fill0)
     , farray(reinterpret_cast<double*>(karray.begin()), karray.size() / 2)
   {}
 };
@@ -952,7 +1020,7 @@ struct common_c0b001
   arr<double> x;
 
   common_c0b001() :
-    x(dimension(10000), fem::fill0)
+    x(dimension(tabsiz(10000)), fem::fill0)
   {}
 };
 
@@ -961,7 +1029,7 @@ struct common_c0b002
   arr<double> ykm;
 
   common_c0b002() :
-    ykm(dimension(20000), fem::fill0)
+    ykm(dimension(tabsiz(20000)), fem::fill0)
   {}
 };
 
@@ -970,7 +1038,7 @@ struct common_c0b003
   arr<int> km;
 
   common_c0b003() :
-    km(dimension(20000), fem::fill0)
+    km(dimension(tabsiz(20000)), fem::fill0)
   {}
 };
 
@@ -979,7 +1047,7 @@ struct common_c0b004
   arr<double> xk;
 
   common_c0b004() :
-    xk(dimension(121080), fem::fill0)
+    xk(dimension(tabsiz(121080)), fem::fill0)
   {}
 };
 
@@ -988,7 +1056,7 @@ struct common_c0b005
   arr<double> xm;
 
   common_c0b005() :
-    xm(dimension(121080), fem::fill0)
+    xm(dimension(tabsiz(121080)), fem::fill0)
   {}
 };
 
@@ -997,7 +1065,7 @@ struct common_c0b006
   arr<double> weight;
 
   common_c0b006() :
-    weight(dimension(460), fem::fill0)
+    weight(dimension(tabsiz(460)), fem::fill0)
   {}
 };
 
@@ -1060,7 +1128,7 @@ struct common_c0b013
   arr<double> stailm;
 
   common_c0b013() :
-    stailm(dimension(90), fem::fill0)
+    stailm(dimension(tabsiz(90)), fem::fill0)
   {}
 };
 
@@ -1069,7 +1137,7 @@ struct common_c0b014
   arr<double> stailk;
 
   common_c0b014() :
-    stailk(dimension(90), fem::fill0)
+    stailk(dimension(tabsiz(90)), fem::fill0)
   {}
 };
 
@@ -1078,7 +1146,7 @@ struct common_c0b015
   arr<double> xmax;
 
   common_c0b015() :
-    xmax(dimension(3600), fem::fill0)
+    xmax(dimension(tabsiz(3600)), fem::fill0)
   {}
 };
 
@@ -1087,7 +1155,7 @@ struct common_c0b016
   arr<int> koutvp;
 
   common_c0b016() :
-    koutvp(dimension(508), fem::fill0)
+    koutvp(dimension(tabsiz(508)), fem::fill0)
   {}
 };
 
@@ -1096,7 +1164,7 @@ struct common_c0b017
   arr<double> bnrg;
 
   common_c0b017() :
-    bnrg(dimension(254), fem::fill0)
+    bnrg(dimension(tabsiz(254)), fem::fill0)
   {}
 };
 
@@ -1105,7 +1173,7 @@ struct common_c0b018
   arr<double> sconst;
 
   common_c0b018() :
-    sconst(dimension(100000), fem::fill0)
+    sconst(dimension(tabsiz(100000)), fem::fill0)
   {}
 };
 
@@ -1114,7 +1182,7 @@ struct common_c0b019
   arr<double> cnvhst;
 
   common_c0b019() :
-    cnvhst(dimension(53000), fem::fill0)
+    cnvhst(dimension(tabsiz(53000)), fem::fill0)
   {}
 };
 
@@ -1123,7 +1191,7 @@ struct common_c0b020
   arr<double> sfd;
 
   common_c0b020() :
-    sfd(dimension(6000), fem::fill0)
+    sfd(dimension(tabsiz(6000)), fem::fill0)
   {}
 };
 
@@ -1132,7 +1200,7 @@ struct common_c0b021
   arr<double> qfd;
 
   common_c0b021() :
-    qfd(dimension(6000), fem::fill0)
+    qfd(dimension(tabsiz(6000)), fem::fill0)
   {}
 };
 
@@ -1141,7 +1209,7 @@ struct common_c0b022
   arr<double> semaux;
 
   common_c0b022() :
-    semaux(dimension(50000), fem::fill0)
+    semaux(dimension(tabsiz(50000)), fem::fill0)
   {}
 };
 
@@ -1150,7 +1218,7 @@ struct common_c0b023
   arr<int> ibsout;
 
   common_c0b023() :
-    ibsout(dimension(900), fem::fill0)
+    ibsout(dimension(tabsiz(900)), fem::fill0)
   {}
 };
 
@@ -1159,7 +1227,7 @@ struct common_c0b024
   arr<double> bvalue;
 
   common_c0b024() :
-    bvalue(dimension(900), fem::fill0)
+    bvalue(dimension(tabsiz(900)), fem::fill0)
   {}
 };
 
@@ -1168,7 +1236,7 @@ struct common_c0b025
   arr<double> sptacs;
   ArraySpan<int> isptacs;
   common_c0b025() :
-    sptacs(dimension(90000), fem::fill0)
+    sptacs(dimension(tabsiz(90000)), fem::fill0)
     , isptacs(reinterpret_cast<int*>(sptacs.begin()), sptacs.size() * 2)
   {}
 };
@@ -1178,7 +1246,7 @@ struct common_c0b026
   arr<int> kswtyp;
 
   common_c0b026() :
-    kswtyp(dimension(1200), fem::fill0)
+    kswtyp(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1187,7 +1255,7 @@ struct common_c0b027
   arr<int> modswt;
 
   common_c0b027() :
-    modswt(dimension(1200), fem::fill0)
+    modswt(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1196,7 +1264,7 @@ struct common_c0b028
   arr<int> kbegsw;
 
   common_c0b028() :
-    kbegsw(dimension(1200), fem::fill0)
+    kbegsw(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1205,7 +1273,7 @@ struct common_c0b029
   arr<int> lastsw;
 
   common_c0b029() :
-    lastsw(dimension(1200), fem::fill0)
+    lastsw(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1214,7 +1282,7 @@ struct common_c0b030
   arr<int> kentnb;
 
   common_c0b030() :
-    kentnb(dimension(1200), fem::fill0)
+    kentnb(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1223,7 +1291,7 @@ struct common_c0b031
   arr<int> nbhdsw;
 
   common_c0b031() :
-    nbhdsw(dimension(3600), fem::fill0)
+    nbhdsw(dimension(tabsiz(3600)), fem::fill0)
   {}
 };
 
@@ -1232,7 +1300,7 @@ struct common_c0b032
   arr<double> topen;
 
   common_c0b032() :
-    topen(dimension(3600), fem::fill0)
+    topen(dimension(tabsiz(3600)), fem::fill0)
   {}
 };
 
@@ -1241,7 +1309,7 @@ struct common_c0b033
   arr<double> crit;
 
   common_c0b033() :
-    crit(dimension(1200), fem::fill0)
+    crit(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1250,7 +1318,7 @@ struct common_c0b034
   arr<int> kdepsw;
 
   common_c0b034() :
-    kdepsw(dimension(3600), fem::fill0)
+    kdepsw(dimension(tabsiz(3600)), fem::fill0)
   {}
 };
 
@@ -1259,7 +1327,7 @@ struct common_c0b035
   arr<double> tdns;
 
   common_c0b035() :
-    tdns(dimension(1200), fem::fill0)
+    tdns(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1268,7 +1336,7 @@ struct common_c0b036
   arr<int> isourc;
 
   common_c0b036() :
-    isourc(dimension(1200), fem::fill0)
+    isourc(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1277,7 +1345,7 @@ struct common_c0b037
   arr<double> energy;
 
   common_c0b037() :
-    energy(dimension(1200), fem::fill0)
+    energy(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1286,7 +1354,7 @@ struct common_c0b038
   arr<int> iardub;
 
   common_c0b038() :
-    iardub(dimension(3600), fem::fill0)
+    iardub(dimension(tabsiz(3600)), fem::fill0)
   {}
 };
 
@@ -1295,7 +1363,7 @@ struct common_c0b039
   arr<double> ardube;
 
   common_c0b039() :
-    ardube(dimension(4800), fem::fill0)
+    ardube(dimension(tabsiz(4800)), fem::fill0)
   {}
 };
 
@@ -1304,7 +1372,7 @@ struct common_c0b040
   arr<int> nonlad;
 
   common_c0b040() :
-    nonlad(dimension(300), fem::fill0)
+    nonlad(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1313,7 +1381,7 @@ struct common_c0b041
   arr<int> nonle;
 
   common_c0b041() :
-    nonle(dimension(300), fem::fill0)
+    nonle(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1322,7 +1390,7 @@ struct common_c0b042
   arr<double> vnonl;
 
   common_c0b042() :
-    vnonl(dimension(300), fem::fill0)
+    vnonl(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1331,7 +1399,7 @@ struct common_c0b043
   arr<double> curr;
 
   common_c0b043() :
-    curr(dimension(300), fem::fill0)
+    curr(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1340,7 +1408,7 @@ struct common_c0b044
   arr<double> anonl;
 
   common_c0b044() :
-    anonl(dimension(300), fem::fill0)
+    anonl(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1349,7 +1417,7 @@ struct common_c0b045
   arr<double> vecnl1;
 
   common_c0b045() :
-    vecnl1(dimension(300), fem::fill0)
+    vecnl1(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1358,7 +1426,7 @@ struct common_c0b046
   arr<double> vecnl2;
 
   common_c0b046() :
-    vecnl2(dimension(300), fem::fill0)
+    vecnl2(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1367,7 +1435,7 @@ struct common_c0b047
   arr<int> namenl;
 
   common_c0b047() :
-    namenl(dimension(300), fem::fill0)
+    namenl(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1376,7 +1444,7 @@ struct common_c0b048
   arr<double> vzer5;
 
   common_c0b048() :
-    vzer5(dimension(300), fem::fill0)
+    vzer5(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1385,7 +1453,7 @@ struct common_c0b049
   arr<int> ilast;
 
   common_c0b049() :
-    ilast(dimension(300), fem::fill0)
+    ilast(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1394,7 +1462,7 @@ struct common_c0b050
   arr<int> nltype;
 
   common_c0b050() :
-    nltype(dimension(300), fem::fill0)
+    nltype(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1403,7 +1471,7 @@ struct common_c0b051
   arr<int> kupl;
 
   common_c0b051() :
-    kupl(dimension(300), fem::fill0)
+    kupl(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1412,7 +1480,7 @@ struct common_c0b052
   arr<int> nlsub;
 
   common_c0b052() :
-    nlsub(dimension(300), fem::fill0)
+    nlsub(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1421,7 +1489,7 @@ struct common_c0b053
   arr<double> xoptbr;
 
   common_c0b053() :
-    xoptbr(dimension(3000), fem::fill0)
+    xoptbr(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1430,7 +1498,7 @@ struct common_c0b054
   arr<double> coptbr;
 
   common_c0b054() :
-    coptbr(dimension(3000), fem::fill0)
+    coptbr(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1439,7 +1507,7 @@ struct common_c0b055
   arr<double> cursub;
 
   common_c0b055() :
-    cursub(dimension(312), fem::fill0)
+    cursub(dimension(tabsiz(312)), fem::fill0)
   {}
 };
 
@@ -1448,7 +1516,7 @@ struct common_c0b056
   arr<double> cchar;
 
   common_c0b056() :
-    cchar(dimension(900), fem::fill0)
+    cchar(dimension(tabsiz(900)), fem::fill0)
   {}
 };
 
@@ -1457,7 +1525,7 @@ struct common_c0b057
   arr<double> vchar;
 
   common_c0b057() :
-    vchar(dimension(900), fem::fill0)
+    vchar(dimension(tabsiz(900)), fem::fill0)
   {}
 };
 
@@ -1466,7 +1534,7 @@ struct common_c0b058
   arr<double> gslope;
 
   common_c0b058() :
-    gslope(dimension(900), fem::fill0)
+    gslope(dimension(tabsiz(900)), fem::fill0)
   {}
 };
 
@@ -1475,7 +1543,7 @@ struct common_c0b059
   arr<int> ktrans;
 
   common_c0b059() :
-    ktrans(dimension(3002), fem::fill0)
+    ktrans(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -1484,7 +1552,7 @@ struct common_c0b060
   arr<int> kk;
 
   common_c0b060() :
-    kk(dimension(3002), fem::fill0)
+    kk(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -1493,7 +1561,7 @@ struct common_c0b061
   arr<double> c;
 
   common_c0b061() :
-    c(dimension(10000), fem::fill0)
+    c(dimension(tabsiz(10000)), fem::fill0)
   {}
 };
 
@@ -1502,7 +1570,7 @@ struct common_c0b062
   arr<double> tr;
 
   common_c0b062() :
-    tr(dimension(20000), fem::fill0)
+    tr(dimension(tabsiz(20000)), fem::fill0)
   {}
 };
 
@@ -1511,7 +1579,7 @@ struct common_c0b063
   arr<double> tx;
 
   common_c0b063() :
-    tx(dimension(20000), fem::fill0)
+    tx(dimension(tabsiz(20000)), fem::fill0)
   {}
 };
 
@@ -1520,7 +1588,7 @@ struct common_c0b064
   arr<double> r;
 
   common_c0b064() :
-    r(dimension(10000), fem::fill0)
+    r(dimension(tabsiz(10000)), fem::fill0)
   {}
 };
 
@@ -1529,7 +1597,7 @@ struct common_c0b065
   arr<int> nr;
 
   common_c0b065() :
-    nr(dimension(3000), fem::fill0)
+    nr(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1538,7 +1606,7 @@ struct common_c0b066
   arr<int> length;
 
   common_c0b066() :
-    length(dimension(3000), fem::fill0)
+    length(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1547,7 +1615,7 @@ struct common_c0b067
   arr<double> cik;
 
   common_c0b067() :
-    cik(dimension(3000), fem::fill0)
+    cik(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1556,7 +1624,7 @@ struct common_c0b068
   arr<double> ci;
 
   common_c0b068() :
-    ci(dimension(3000), fem::fill0)
+    ci(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1565,7 +1633,7 @@ struct common_c0b069
   arr<double> ck;
 
   common_c0b069() :
-    ck(dimension(3000), fem::fill0)
+    ck(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1574,7 +1642,7 @@ struct common_c0b070
   arr<int> ismout;
 
   common_c0b070() :
-    ismout(dimension(1052), fem::fill0)
+    ismout(dimension(tabsiz(1052)), fem::fill0)
   {}
 };
 
@@ -1583,7 +1651,7 @@ struct common_c0b071
   arr<double> elp;
 
   common_c0b071() :
-    elp(dimension(404), fem::fill0)
+    elp(dimension(tabsiz(404)), fem::fill0)
   {}
 };
 
@@ -1592,7 +1660,7 @@ struct common_c0b072
   arr<double> cu;
 
   common_c0b072() :
-    cu(dimension(96), fem::fill0)
+    cu(dimension(tabsiz(96)), fem::fill0)
   {}
 };
 
@@ -1601,7 +1669,7 @@ struct common_c0b073
   arr<double> shp;
 
   common_c0b073() :
-    shp(dimension(1008), fem::fill0)
+    shp(dimension(tabsiz(1008)), fem::fill0)
   {}
 };
 
@@ -1610,7 +1678,7 @@ struct common_c0b074
   arr<double> histq;
 
   common_c0b074() :
-    histq(dimension(504), fem::fill0)
+    histq(dimension(tabsiz(504)), fem::fill0)
   {}
 };
 
@@ -1619,7 +1687,7 @@ struct common_c0b075
   arr<int> ismdat;
 
   common_c0b075() :
-    ismdat(dimension(120), fem::fill0)
+    ismdat(dimension(tabsiz(120)), fem::fill0)
   {}
 };
 
@@ -1628,7 +1696,7 @@ struct common_c0b076
   arr<fem::str<8> > texvec;
 
   common_c0b076() :
-    texvec(dimension(4000), fem::fill0)
+    texvec(dimension(tabsiz(4000)), fem::fill0)
   {}
 };
 
@@ -1637,7 +1705,7 @@ struct common_c0b077
   arr<int> ibrnch;
 
   common_c0b077() :
-    ibrnch(dimension(900), fem::fill0)
+    ibrnch(dimension(tabsiz(900)), fem::fill0)
   {}
 };
 
@@ -1646,7 +1714,7 @@ struct common_c0b078
   arr<int> jbrnch;
 
   common_c0b078() :
-    jbrnch(dimension(900), fem::fill0)
+    jbrnch(dimension(tabsiz(900)), fem::fill0)
   {}
 };
 
@@ -1655,7 +1723,7 @@ struct common_c0b079
   arr<double> tstop;
 
   common_c0b079() :
-    tstop(dimension(100), fem::fill0)
+    tstop(dimension(tabsiz(100)), fem::fill0)
   {}
 };
 
@@ -1664,7 +1732,7 @@ struct common_c0b080
   arr<int> nonlk;
 
   common_c0b080() :
-    nonlk(dimension(300), fem::fill0)
+    nonlk(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1673,7 +1741,7 @@ struct common_c0b081
   arr<int> nonlm;
 
   common_c0b081() :
-    nonlm(dimension(300), fem::fill0)
+    nonlm(dimension(tabsiz(300)), fem::fill0)
   {}
 };
 
@@ -1682,7 +1750,7 @@ struct common_c0b082
   arr<double> spum;
   ArraySpan<int> ispum;
   common_c0b082() :
-    spum(dimension(30000), fem::fill0)
+    spum(dimension(tabsiz(30000)), fem::fill0)
     , ispum(reinterpret_cast<int*>(spum.begin()), spum.size() * 2)
   {}
 };
@@ -1692,7 +1760,7 @@ struct common_c0b083
   arr<int> kks;
 
   common_c0b083() :
-    kks(dimension(3002), fem::fill0)
+    kks(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -1701,7 +1769,7 @@ struct common_c0b084
   arr<int> kknonl;
 
   common_c0b084() :
-    kknonl(dimension(72048), fem::fill0)
+    kknonl(dimension(tabsiz(72048)), fem::fill0)
   {}
 };
 
@@ -1710,7 +1778,7 @@ struct common_c0b085
   arr<double> znonl;
 
   common_c0b085() :
-    znonl(dimension(72048), fem::fill0)
+    znonl(dimension(tabsiz(72048)), fem::fill0)
   {}
 };
 
@@ -1719,7 +1787,7 @@ struct common_c0b086
   arr<double> znonlb;
 
   common_c0b086() :
-    znonlb(dimension(3002), fem::fill0)
+    znonlb(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -1728,7 +1796,7 @@ struct common_c0b087
   arr<double> znonlc;
 
   common_c0b087() :
-    znonlc(dimension(3002), fem::fill0)
+    znonlc(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -1737,7 +1805,7 @@ struct common_c0b088
   arr<double> finit;
 
   common_c0b088() :
-    finit(dimension(3002), fem::fill0)
+    finit(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -1746,7 +1814,7 @@ struct common_c0b089
   arr<int> ksub;
 
   common_c0b089() :
-    ksub(dimension(312), fem::fill0)
+    ksub(dimension(tabsiz(312)), fem::fill0)
   {}
 };
 
@@ -1755,7 +1823,7 @@ struct common_c0b090
   arr<int> msub;
 
   common_c0b090() :
-    msub(dimension(312), fem::fill0)
+    msub(dimension(tabsiz(312)), fem::fill0)
   {}
 };
 
@@ -1764,7 +1832,7 @@ struct common_c0b091
   arr<int> isubeg;
 
   common_c0b091() :
-    isubeg(dimension(304), fem::fill0)
+    isubeg(dimension(tabsiz(304)), fem::fill0)
   {}
 };
 
@@ -1773,7 +1841,7 @@ struct common_c0b092
   arr<int> litype;
 
   common_c0b092() :
-    litype(dimension(3000), fem::fill0)
+    litype(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1782,7 +1850,7 @@ struct common_c0b093
   arr<int> imodel;
 
   common_c0b093() :
-    imodel(dimension(3000), fem::fill0)
+    imodel(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1791,7 +1859,7 @@ struct common_c0b094
   arr<int> kbus;
 
   common_c0b094() :
-    kbus(dimension(3000), fem::fill0)
+    kbus(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1800,7 +1868,7 @@ struct common_c0b095
   arr<int> mbus;
 
   common_c0b095() :
-    mbus(dimension(3000), fem::fill0)
+    mbus(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1809,7 +1877,7 @@ struct common_c0b096
   arr<int> kodebr;
 
   common_c0b096() :
-    kodebr(dimension(3000), fem::fill0)
+    kodebr(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1818,7 +1886,7 @@ struct common_c0b097
   arr<double> cki;
 
   common_c0b097() :
-    cki(dimension(3000), fem::fill0)
+    cki(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1827,7 +1895,7 @@ struct common_c0b098
   arr<double> ckkjm;
 
   common_c0b098() :
-    ckkjm(dimension(3000), fem::fill0)
+    ckkjm(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1836,7 +1904,7 @@ struct common_c0b099
   arr<int> indhst;
 
   common_c0b099() :
-    indhst(dimension(3000), fem::fill0)
+    indhst(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1845,7 +1913,7 @@ struct common_c0b100
   arr<int> kodsem;
 
   common_c0b100() :
-    kodsem(dimension(3000), fem::fill0)
+    kodsem(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -1854,7 +1922,7 @@ struct common_c0b101
   arr<int> namebr;
 
   common_c0b101() :
-    namebr(dimension(18000), fem::fill0)
+    namebr(dimension(tabsiz(18000)), fem::fill0)
   {}
 };
 
@@ -1863,7 +1931,7 @@ struct common_c0b102
   arr<int> iform;
 
   common_c0b102() :
-    iform(dimension(100), fem::fill0)
+    iform(dimension(tabsiz(100)), fem::fill0)
   {}
 };
 
@@ -1872,7 +1940,7 @@ struct common_c0b103
   arr<int> node;
 
   common_c0b103() :
-    node(dimension(100), fem::fill0)
+    node(dimension(tabsiz(100)), fem::fill0)
   {}
 };
 
@@ -1881,7 +1949,7 @@ struct common_c0b104
   arr<double> crest;
 
   common_c0b104() :
-    crest(dimension(100), fem::fill0)
+    crest(dimension(tabsiz(100)), fem::fill0)
   {}
 };
 
@@ -1890,7 +1958,7 @@ struct common_c0b105
   arr<double> time1;
 
   common_c0b105() :
-    time1(dimension(100), fem::fill0)
+    time1(dimension(tabsiz(100)), fem::fill0)
   {}
 };
 
@@ -1899,7 +1967,7 @@ struct common_c0b106
   arr<double> time2;
 
   common_c0b106() :
-    time2(dimension(100), fem::fill0)
+    time2(dimension(tabsiz(100)), fem::fill0)
   {}
 };
 
@@ -1908,7 +1976,7 @@ struct common_c0b107
   arr<double> tstart;
 
   common_c0b107() :
-    tstart(dimension(100), fem::fill0)
+    tstart(dimension(tabsiz(100)), fem::fill0)
   {}
 };
 
@@ -1917,7 +1985,7 @@ struct common_c0b108
   arr<double> sfreq;
 
   common_c0b108() :
-    sfreq(dimension(100), fem::fill0)
+    sfreq(dimension(tabsiz(100)), fem::fill0)
   {}
 };
 
@@ -1926,7 +1994,7 @@ struct common_c0b109
   arr<int> kmswit;
 
   common_c0b109() :
-    kmswit(dimension(3600), fem::fill0)
+    kmswit(dimension(tabsiz(3600)), fem::fill0)
   {}
 };
 
@@ -1935,7 +2003,7 @@ struct common_c0b110
   arr<int> nextsw;
 
   common_c0b110() :
-    nextsw(dimension(1200), fem::fill0)
+    nextsw(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1962,7 +2030,7 @@ struct common_c0b113
   arr<int> imfd;
 
   common_c0b113() :
-    imfd(dimension(600), fem::fill0)
+    imfd(dimension(tabsiz(600)), fem::fill0)
   {}
 };
 
@@ -1971,7 +2039,7 @@ struct common_c0b114
   arr<double> tclose;
 
   common_c0b114() :
-    tclose(dimension(1200), fem::fill0)
+    tclose(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1980,7 +2048,7 @@ struct common_c0b115
   arr<double> adelay;
 
   common_c0b115() :
-    adelay(dimension(3600), fem::fill0)
+    adelay(dimension(tabsiz(3600)), fem::fill0)
   {}
 };
 
@@ -1989,7 +2057,7 @@ struct common_c0b116
   arr<int> kpos;
 
   common_c0b116() :
-    kpos(dimension(1200), fem::fill0)
+    kpos(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -1998,7 +2066,7 @@ struct common_c0b117
   arr<int> namesw;
 
   common_c0b117() :
-    namesw(dimension(1200), fem::fill0)
+    namesw(dimension(tabsiz(1200)), fem::fill0)
   {}
 };
 
@@ -2007,7 +2075,7 @@ struct common_c0b118
   arr<double> e;
 
   common_c0b118() :
-    e(dimension(3002), fem::fill0)
+    e(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2016,7 +2084,7 @@ struct common_c0b119
   arr<double> f;
 
   common_c0b119() :
-    f(dimension(3002), fem::fill0)
+    f(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2025,7 +2093,7 @@ struct common_c0b120
   arr<int> kssfrq;
 
   common_c0b120() :
-    kssfrq(dimension(3002), fem::fill0)
+    kssfrq(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2034,7 +2102,7 @@ struct common_c0b121
   arr<int> kode;
 
   common_c0b121() :
-    kode(dimension(3002), fem::fill0)
+    kode(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2043,7 +2111,7 @@ struct common_c0b122
   arr<int> kpsour;
 
   common_c0b122() :
-    kpsour(dimension(3002), fem::fill0)
+    kpsour(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2052,7 +2120,7 @@ struct common_c0b123
   vectorEx<double> volti;
 
   common_c0b123() :
-    volti((6000), fem::fill0)
+    volti((tabsiz(6000)), fem::fill0)
   {}
 };
 
@@ -2061,7 +2129,7 @@ struct common_c0b124
   arr<double> voltk;
 
   common_c0b124() :
-    voltk(dimension(3000), fem::fill0)
+    voltk(dimension(tabsiz(3000)), fem::fill0)
   {}
 };
 
@@ -2070,7 +2138,7 @@ struct common_c0b125
   vectorEx<double> volt;
 
   common_c0b125() :
-    volt((6000), fem::fill0)
+    volt((tabsiz(6000)), fem::fill0)
   {}
 };
 
@@ -2079,7 +2147,7 @@ struct common_c0b126
   arr<fem::str<8> > bus;
 
   common_c0b126() :
-    bus(dimension(3002), fem::fill0)
+    bus(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2134,7 +2202,7 @@ struct common_smach
   int msmout;
 
   common_smach() :
-    z(dimension(100), fem::fill0),
+    z(dimension(tabsiz(100)), fem::fill0),
     x1(dimension(36), fem::fill0),
     smoutv(dimension(15), fem::fill0),
     sqrt3(fem::double0),
@@ -2411,8 +2479,8 @@ struct common_spykom
 
   common_spykom() :
     indxrp(dimension(20), fem::fill0),
-    ivec(dimension(1000), fem::fill0),
-    iascii(dimension(1000), fem::fill0),
+    ivec(dimension(tabsiz(1000)), fem::fill0),
+    iascii(dimension(tabsiz(1000)), fem::fill0),
     numsym(fem::int0),
     jjroll(fem::int0),
     itexp(fem::int0),
@@ -2450,8 +2518,8 @@ struct common_spykom
     iprspy(fem::int0),
     monitr(fem::int0),
     monits(fem::int0),
-    locate(dimension(1000), fem::fill0),
-    nline(dimension(1000), fem::fill0),
+    locate(dimension(tabsiz(1000)), fem::fill0),
+    nline(dimension(tabsiz(1000)), fem::fill0),
     kbreak(fem::int0),
     limbuf(fem::int0),
     kolout(fem::int0),
@@ -2515,7 +2583,7 @@ struct common_spyf77
 
   common_spyf77() :
     filext(dimension(10), fem::fill0),
-    symb(dimension(1000), fem::fill0),
+    symb(dimension(tabsiz(1000)), fem::fill0),
     col(dimension(25), fem::fill0),
     bytfnd(fem::char0),
     char1(fem::char0),
@@ -2525,7 +2593,7 @@ struct common_spyf77
     bytbuf(fem::char0),
     buff77(fem::char0),
     file6b(dimension(20), fem::fill0),
-    file6(dimension(30000), fem::fill0),
+    file6(dimension(tabsiz(30000)), fem::fill0),
     blan80(fem::char0),
     prom80(fem::char0),
     digit(dimension(10), fem::fill0),
@@ -2541,7 +2609,7 @@ struct common_spyf77
     outlin(fem::char0),
     outsav(fem::char0),
     heding(fem::char0),
-    texspy(dimension(1250), fem::fill0)
+    texspy(dimension(tabsiz(1250)), fem::fill0)
   {}
 };
 
@@ -2635,7 +2703,7 @@ struct common_cblock
   common_cblock() :
     datepl(dimension(2), fem::fill0),
     tclopl(dimension(2), fem::fill0),
-    bbus(dimension(300), fem::fill0),
+    bbus(dimension(tabsiz(300)), fem::fill0),
     tmult(fem::double0),
     dy(fem::double0),
     dx(fem::double0),
@@ -2643,7 +2711,7 @@ struct common_cblock
     tstep(fem::double0),
     gxmin(fem::double0),
     gxmax(fem::double0),
-    ew(dimension(15000), fem::fill0),
+    ew(dimension(tabsiz(15000)), fem::fill0),
     finfin(fem::double0),
     fill(fem::double0),
     fvcom(dimension(50), fem::fill0),
@@ -2661,8 +2729,8 @@ struct common_cblock
     fxref(dimension(25), fem::fill0),
     fyref(dimension(25), fem::fill0),
     evnbyt(fem::double0),
-    ev(dimension(15000), fem::fill0),
-    bx(dimension(150), fem::fill0),
+    ev(dimension(tabsiz(15000)), fem::fill0),
+    bx(dimension(tabsiz(150)), fem::fill0),
     vminr(fem::double0),
     vmaxr(fem::double0),
     mmm(dimension(20), fem::fill0),
@@ -2775,8 +2843,8 @@ struct common_ekcom1
     ekbuf(dimension(15, 9), fem::fill0),
     ektemp(dimension(45, 5), fem::fill0),
     errchk(fem::double0),
-    solrsv(dimension(2500), fem::fill0),
-    solisv(dimension(2500), fem::fill0),
+    solrsv(dimension(tabsiz(2500)), fem::fill0),
+    solisv(dimension(tabsiz(2500)), fem::fill0),
     nitera(fem::int0),
     nekreq(fem::int0),
     nekcod(dimension(15), fem::fill0)
@@ -2893,7 +2961,7 @@ struct common_spac01
   arr<double> tp;
 
   common_spac01() :
-    tp(dimension(30000), fem::fill0)
+    tp(dimension(tabsiz(30000)), fem::fill0)
   {}
 };
 
@@ -2902,7 +2970,7 @@ struct common_spac02
   arr<int> norder;
 
   common_spac02() :
-    norder(dimension(3002), fem::fill0)
+    norder(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2911,7 +2979,7 @@ struct common_spac03
   arr<int> index;
 
   common_spac03() :
-    index(dimension(3002), fem::fill0)
+    index(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2920,7 +2988,7 @@ struct common_spac04
   arr<double> diag;
 
   common_spac04() :
-    diag(dimension(3002), fem::fill0)
+    diag(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2929,7 +2997,7 @@ struct common_spac05
   arr<double> diab;
 
   common_spac05() :
-    diab(dimension(3002), fem::fill0)
+    diab(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2938,7 +3006,7 @@ struct common_spac06
   arr<double> solr;
 
   common_spac06() :
-    solr(dimension(3002), fem::fill0)
+    solr(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2947,7 +3015,7 @@ struct common_spac07
   arr<double> soli;
 
   common_spac07() :
-    soli(dimension(3002), fem::fill0)
+    soli(dimension(tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2956,7 +3024,7 @@ struct common_spac08
   vectorEx<int> ich1;
 
   common_spac08() :
-    ich1((3002), fem::fill0)
+    ich1((tabsiz(3002)), fem::fill0)
   {}
 };
 
@@ -2966,7 +3034,7 @@ struct common_spac09
   arr<double> bnd;
 
   common_spac09() :
-    bnd(dimension(sizeBND), fem::fill0)
+    bnd(dimension(tabsiz(sizeBND)), fem::fill0)
   {}
 };
 
@@ -2975,7 +3043,7 @@ struct common_spac10
   arr<int> iloc;
 
   common_spac10() :
-    iloc(dimension(30000), fem::fill0)
+    iloc(dimension(tabsiz(30000)), fem::fill0)
   {}
 };
 
@@ -2984,7 +3052,7 @@ struct common_spac11
   arr<double> gnd;
 
   common_spac11() :
-    gnd(dimension(30000), fem::fill0)
+    gnd(dimension(tabsiz(30000)), fem::fill0)
   {}
 };
 
@@ -3227,7 +3295,7 @@ struct common_a8sw
   arr<double> a8sw;
 
   common_a8sw() :
-    a8sw(dimension(400), fem::fill0)
+    a8sw(dimension(tabsiz(400)), fem::fill0)
   {}
 };
 
@@ -3650,21 +3718,21 @@ struct common_com39
     tii(dimension(18, 18), fem::fill0),
     tdum(dimension(18, 18), fem::fill0),
     modskp(dimension(2, 18), fem::fill0),
-    alinvc(dimension(90), fem::fill0),
-    akfrac(dimension(100), fem::fill0),
-    alphaf(dimension(100), fem::fill0),
-    fczr(dimension(100), fem::fill0),
-    fcpr(dimension(100), fem::fill0),
-    fcz(dimension(100), fem::fill0),
-    fcp(dimension(100), fem::fill0),
-    indxv(dimension(100), fem::fill0),
-    xauxd(dimension(200), fem::fill0),
-    zoprau(dimension(400), fem::fill0),
-    zoprao(dimension(400), fem::fill0),
-    azepo(dimension(400), fem::fill0),
-    xchkra(dimension(255), fem::fill0),
-    xknee(dimension(100), fem::fill0),
-    noprao(dimension(100), fem::fill0),
+    alinvc(dimension(tabsiz(90)), fem::fill0),
+    akfrac(dimension(tabsiz(100)), fem::fill0),
+    alphaf(dimension(tabsiz(100)), fem::fill0),
+    fczr(dimension(tabsiz(100)), fem::fill0),
+    fcpr(dimension(tabsiz(100)), fem::fill0),
+    fcz(dimension(tabsiz(100)), fem::fill0),
+    fcp(dimension(tabsiz(100)), fem::fill0),
+    indxv(dimension(tabsiz(100)), fem::fill0),
+    xauxd(dimension(tabsiz(200)), fem::fill0),
+    zoprau(dimension(tabsiz(400)), fem::fill0),
+    zoprao(dimension(tabsiz(400)), fem::fill0),
+    azepo(dimension(tabsiz(400)), fem::fill0),
+    xchkra(dimension(tabsiz(255)), fem::fill0),
+    xknee(dimension(tabsiz(100)), fem::fill0),
+    noprao(dimension(tabsiz(100)), fem::fill0),
     hreflg(fem::double0),
     aptdec(fem::double0),
     gmode(fem::double0),
@@ -3704,7 +3772,7 @@ struct common_c39b01
   arr<double> xdat;
 
   common_c39b01() :
-    xdat(dimension(10000), fem::fill0)
+    xdat(dimension(tabsiz(10000)), fem::fill0)
   {}
 };
 
@@ -3713,7 +3781,7 @@ struct common_c39b02
   arr<double> ydat;
 
   common_c39b02() :
-    ydat(dimension(10000), fem::fill0)
+    ydat(dimension(tabsiz(10000)), fem::fill0)
   {}
 };
 
@@ -3722,7 +3790,7 @@ struct common_c39b03
   arr<double> aphdat;
 
   common_c39b03() :
-    aphdat(dimension(10000), fem::fill0)
+    aphdat(dimension(tabsiz(10000)), fem::fill0)
   {}
 };
 
@@ -3731,7 +3799,7 @@ struct common_c44b02
   arr<double> p;
 
   common_c44b02() :
-    p(dimension(77815), fem::fill0)
+    p(dimension(tabsiz(77815)), fem::fill0)
   {}
 };
 
@@ -3740,7 +3808,7 @@ struct common_c44b03
   arr<double> z;
 
   common_c44b03() :
-    z(dimension(77815), fem::fill0)
+    z(dimension(tabsiz(77815)), fem::fill0)
   {}
 };
 
@@ -3749,7 +3817,7 @@ struct common_c44b04
   arr<int> ic;
 
   common_c44b04() :
-    ic(dimension(394), fem::fill0)
+    ic(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3758,7 +3826,7 @@ struct common_c44b05
   arr<double> r;
 
   common_c44b05() :
-    r(dimension(394), fem::fill0)
+    r(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3767,7 +3835,7 @@ struct common_c44b06
   arr<double> dz;
 
   common_c44b06() :
-    dz(dimension(394), fem::fill0)
+    dz(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3776,7 +3844,7 @@ struct common_c44b07
   arr<double> gmd;
 
   common_c44b07() :
-    gmd(dimension(394), fem::fill0)
+    gmd(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3785,7 +3853,7 @@ struct common_c44b08
   arr<double> x;
 
   common_c44b08() :
-    x(dimension(394), fem::fill0)
+    x(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3794,7 +3862,7 @@ struct common_c44b09
   arr<double> y;
 
   common_c44b09() :
-    y(dimension(394), fem::fill0)
+    y(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3803,7 +3871,7 @@ struct common_c44b10
   arr<double> tb2;
 
   common_c44b10() :
-    tb2(dimension(394), fem::fill0)
+    tb2(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3812,7 +3880,7 @@ struct common_c44b11
   arr<int> itb3;
 
   common_c44b11() :
-    itb3(dimension(394), fem::fill0)
+    itb3(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3821,7 +3889,7 @@ struct common_c44b12
   arr<double> workr1;
 
   common_c44b12() :
-    workr1(dimension(394), fem::fill0)
+    workr1(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3830,7 +3898,7 @@ struct common_c44b13
   arr<double> workr2;
 
   common_c44b13() :
-    workr2(dimension(394), fem::fill0)
+    workr2(dimension(tabsiz(394)), fem::fill0)
   {}
 };
 
@@ -3839,7 +3907,7 @@ struct common_c44b14
   arr<fem::str<8> > text;
 
   common_c44b14() :
-    text(dimension(788), fem::fill0)
+    text(dimension(tabsiz(788)), fem::fill0)
   {}
 };
 
@@ -3848,7 +3916,7 @@ struct common_c44b15
   arr<double> gd;
 
   common_c44b15() :
-    gd(dimension(19503), fem::fill0)
+    gd(dimension(tabsiz(19503)), fem::fill0)
   {}
 };
 
@@ -3857,7 +3925,7 @@ struct common_c44b16
   arr<double> bd;
 
   common_c44b16() :
-    bd(dimension(19503), fem::fill0)
+    bd(dimension(tabsiz(19503)), fem::fill0)
   {}
 };
 
@@ -3866,7 +3934,7 @@ struct common_c44b17
   arr<double> yd;
 
   common_c44b17() :
-    yd(dimension(19503), fem::fill0)
+    yd(dimension(tabsiz(19503)), fem::fill0)
   {}
 };
 
@@ -3875,7 +3943,7 @@ struct common_c44b18
   arr<int> itbic;
 
   common_c44b18() :
-    itbic(dimension(395), fem::fill0)
+    itbic(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -3884,7 +3952,7 @@ struct common_c44b19
   arr<double> tbr;
 
   common_c44b19() :
-    tbr(dimension(395), fem::fill0)
+    tbr(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -3893,7 +3961,7 @@ struct common_c44b20
   arr<double> tbd;
 
   common_c44b20() :
-    tbd(dimension(395), fem::fill0)
+    tbd(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -3902,7 +3970,7 @@ struct common_c44b21
   arr<double> tbg;
 
   common_c44b21() :
-    tbg(dimension(395), fem::fill0)
+    tbg(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -3911,7 +3979,7 @@ struct common_c44b22
   arr<double> tbx;
 
   common_c44b22() :
-    tbx(dimension(395), fem::fill0)
+    tbx(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -3920,7 +3988,7 @@ struct common_c44b23
   arr<double> tby;
 
   common_c44b23() :
-    tby(dimension(395), fem::fill0)
+    tby(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -3929,7 +3997,7 @@ struct common_c44b24
   arr<double> tbtb2;
 
   common_c44b24() :
-    tbtb2(dimension(395), fem::fill0)
+    tbtb2(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -3938,7 +4006,7 @@ struct common_c44b25
   arr<int> itbtb3;
 
   common_c44b25() :
-    itbtb3(dimension(395), fem::fill0)
+    itbtb3(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -3947,7 +4015,7 @@ struct common_c44b26
   arr<fem::str<8> > tbtext;
 
   common_c44b26() :
-    tbtext(dimension(395), fem::fill0)
+    tbtext(dimension(tabsiz(395)), fem::fill0)
   {}
 };
 
@@ -4003,7 +4071,7 @@ struct common_com45
   int kreqab;
 
   common_com45() :
-    pl(dimension(91), fem::fill0),
+    pl(dimension(tabsiz(91)), fem::fill0),
     f(fem::double0),
     w(fem::double0),
     cold(fem::double0),
@@ -4205,8 +4273,8 @@ struct common_zprint
   arr<double> zoutx;
 
   common_zprint() :
-    zoutr(dimension(120), fem::fill0),
-    zoutx(dimension(120), fem::fill0)
+    zoutr(dimension(tabsiz(120)), fem::fill0),
+    zoutx(dimension(tabsiz(120)), fem::fill0)
   {}
 };
 
@@ -4322,6 +4390,41 @@ private:
   }
 };
 
+// The COMMON blocks of the routines of GUTS44 after the Z matrix of a
+// frequency (REDU44, CXRED2, SYMM, OUTPUT, MODAL, DCEIGN, COMINV, ...), for
+// one step thread to run a frequency of a LINE CONSTANTS sweep while the
+// others run theirs. What they write on LUNIT6, LUNIT7 and unit 6 is kept
+// in  log ,  punch  and  screen  for GUTS44 to write out in frequency
+// order; the cards of the case which MODAL or GUTS44 copy from LUNIT2 to
+// the punch are copied there by GUTS44 itself (see LINE_FREQUENCY44).
+struct LineCommon :
+  fem::common,
+  common_cmn,
+  common_com44,
+  common_c44b02,
+  common_c44b03,
+  common_c44b12,
+  common_c44b13,
+  common_linemodel
+{
+  fem::cmn_sve output_sve;
+  fem::cmn_sve modal_sve;
+  std::ostringstream out2_stream;
+  std::string log, punch, screen;
+  std::size_t cards_at = 0;  // where in  punch  the cards go
+  int cards = -1;            // N5 cards, 0: up to a blank card, -1: none
+  std::vector<double> stg;   // the arrays of MODAL (XWC, XWY, YZR, ...)
+
+  // on the thread of GUTS44, for the list sizes of its  common
+  LineCommon() {
+    io.capture(lunit6, &log);
+    io.capture(lunit7, &punch);
+    io.capture(6, &screen);
+  }
+};
+
+class EnergizationPlan;
+
 struct common :
   fem::common,
   common_cmn,
@@ -4560,6 +4663,7 @@ struct common :
   fem::cmn_sve tacs1b_sve;
   fem::cmn_sve tacs1_sve;
   fem::cmn_sve sandnm_sve;
+  fem::cmn_sve randnm_sve;
   fem::cmn_sve spyout_sve;
   fem::cmn_sve spyink_sve;
   fem::cmn_sve setrtm_sve;
@@ -4625,15 +4729,74 @@ struct common :
   fem::cmn_sve subr55_sve;
   fem::cmn_sve program_main_sve;
 
-  std::ifstream inp_stream;
+  DeckReader inp_deck;       // input data deck, card by card
   std::ofstream out_stream;
   std::ofstream out2_stream; // steady state result if apply
+  PlotWriter plot;           // time-series rows of PLTFIL
+  PlotFormat plot_format = PlotFormat::csv;
   //std::ofstream log_stream;
 
   common_umlocal umd1;
   common_umlocl  umd2;
   common_tacsar tacsar;
 
+  // STATISTICS / SYSTEMATIC energizations run on worker contexts
+  EnergizationPlan* energ_plan = nullptr;
+  int energ_knt = 0;   // > 0: worker context which runs only this energization
+  int energ_case = 0;  // statistics cases met so far in the data deck
+  // RANOFF, TCLOSE(1..KSWTCH), TOPEN(1..KSWTCH) of energization ENERG_KNT,
+  // the LUNIT3 records of OVER12 that the master writes for GUTS29
+  std::vector<double> energ_times;
+  int list_overflow = 0;  // EMTP list whose storage was exceeded (SUBR51)
+  // repeat solution of SUBTS3 over the factors of (Y) of SUBTS1
+  SolveMode solve_mode = SolveMode::compiled;
+  bool network_partitions = true;  // one table per independent subnetwork
+  std::int64_t factor_serial = 0;  // triangularizations of (Y) so far
+  RepeatSolution ysolve;
+  // fill-reducing node ordering of OVER7 (NODORD) and the size of the
+  // transient factors it gives
+  int node_ordering = 0;
+  std::int64_t factor_terms = 0;
+  std::int64_t factor_fill = 0;
+  double order_seconds = 0.0;
+  // retriangularizations of (Y) in SUBTS1 from the first changed row
+  bool partial_refactor = true;
+  PartialFactor refactor;
+  // factors of (Y) by switch configuration, for SUBTS1 to reuse
+  FactorCache factor_cache;
+  // inverses of the ZnO Thevenin matrices of ZINCOX and its Newton counts
+  ZnoNewton zno;
+  // history of the constant-parameter lines of SUBTS2 in rings by travel
+  // time (false: the XK / XM code of SUBTS2)
+  bool line_history = true;
+  LineHistory lines;
+  // recursive convolutions of the JMarti branches by FdConvolution (false:
+  // the FORTRAN loops of SUBTS2)
+  bool fd_convolution = true;
+  // threads of the time steps: chunks of the line histories of SUBTS2
+  StepPool step_pool;
+  // snapshot files of the time loop, written and loaded by OVER16
+  SnapshotPlan snapshots;
+  // variants of the switch times run from the state at the start of the
+  // time loop, by OVER16 and OVER20
+  SweepPlan sweep;
+  // indexes of the names of BUS and TEXVEC for the input overlays
+  NameIndex bus_names;
+  NameIndex texvec_names;
+  // Z matrices of the frequencies of a LINE CONSTANTS sweep, evaluated
+  // ahead on the step threads for GUTS44
+  LineSweep line_sweep;
+  std::vector<std::unique_ptr<LineCommon>> line_commons;  // one a thread
+  // terms of the CABLE CONSTANTS geometry that do not depend on the
+  // frequency, and the parts of the Z matrices of a sweep evaluated ahead
+  // on the step threads for ZYMX
+  CableTerms cable_terms;
+  CableSweep cable_sweep;
+  // code of the TACS supplemental variables, translated by CSUP
+  TacsCodes tacs_code;
+  // VOLTBC of SUBTS1 when more than its 50 columns are compensated
+  vectorEx<double> voltbc_columns;
+
   common(
     int argc,
     char const* argv[])
@@ -4648,6 +4811,188 @@ struct common :
     const std::string& logFile,
     const std::string& outFile
     ); // int argc, char const* argv[]);
+  void program_main(
+    common& cmn,
+    const std::string& inpFile,
+    const std::string& logFile,
+    const std::string& outFile);
+
+  // One EMTP run context. It owns its COMMON blocks and *_sve save blocks,
+  // so a worker can run case after case, and several instances can run
+  // side by side on different threads.
+  class Simulation {
+    std::unique_ptr<common> cmn_;
+    bool used_ = false;
+    int nthreads_ = 0;
+    int scale_ = 0;      // requested list scale; 0: from the size of the deck
+    int run_scale_ = 1;  // list scale of  cmn_
+    PlotFormat plot_format_ = PlotFormat::csv;
+    std::vector<std::pair<std::string, int>> plot_decimation_;
+    SolveMode solve_mode_ = SolveMode::compiled;
+    bool network_partitions_ = true;
+    bool partial_refactor_ = true;
+    int factor_cache_mb_ = 64;
+    bool line_history_ = true;
+    bool fd_convolution_ = true;
+    bool tacs_bytecode_ = true;
+    bool tacs_timed_ = false;
+    bool solve_timed_ = false;
+    int step_threads_ = 1;
+    std::vector<double> snapshot_times_;
+    std::string restart_file_;
+    std::string sweep_file_;
+  public:
+    Simulation();
+    ~Simulation();
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // discard all state of the previous case (cheap: the large arrays
+    // are demand-zero, only pages touched by the next case get committed)
+    void reset();
+    void run(
+      const std::string& inpFile,
+      const std::string& logFile,
+      const std::string& outFile);
+    common& cmn() { return *cmn_; }
+    // worker threads for the energizations of STATISTICS / SYSTEMATIC
+    // cases; 0 (default) takes one per hardware thread, and no case gets
+    // more than its energizations or the hardware threads. Any number
+    // draws the same switch times, so 1 simulates the same energizations
+    // on a single worker
+    void energization_threads(int n) { nthreads_ = n; }
+    // time-series rows as CSV in the .out file (default), or as float64 /
+    // float32 columns in "<out>.bin" (see plot_file.h)
+    void plot_format(PlotFormat f) { plot_format_ = f; }
+    // keep one step in  every  of output channel  name  ("*": all channels)
+    void plot_decimation(std::string name, int every) {
+      plot_decimation_.emplace_back(std::move(name), every);
+    }
+    // EMTP list sizes as a multiple of the stock DIMENS table (see
+    // tabsiz): 0 (default) picks one from the number of data cards. A case
+    // which still exceeds a list is run again with the lists doubled, up
+    // to  max_table_scale  times the stock size.
+    void table_scale(int scale) { scale_ = scale; }
+    int table_scale() const { return run_scale_; }
+    static constexpr int max_table_scale = 64;
+    static int deck_table_scale(const std::string& inpFile);
+    // forward / back substitution of the time steps (see repeat_solution.h);
+    // SolveMode::bench prints the timing of both kernels after each run
+    void solve_mode(SolveMode mode) { solve_mode_ = mode; }
+    // the compiled solution split into the subnetworks between distributed
+    // lines, solved side by side on the step threads (default), or whole
+    void network_partitions(bool on) { network_partitions_ = on; }
+    // after a switch event SUBTS1 eliminates (Y) again from the first row
+    // the change reaches (default), or all of it (see partial_factor.h)
+    void partial_refactor(bool on) { partial_refactor_ = on; }
+    // megabytes of factors of (Y) kept for switch configurations which
+    // recur (see factor_cache.h); 0 turns the cache off
+    void factor_cache(int mb) { factor_cache_mb_ = mb; }
+    // history of the constant-parameter lines in rings by travel time
+    // (default), or in XK / XM by the FORTRAN code (see line_history.h)
+    void line_history(bool on) { line_history_ = on; }
+    // JMarti pole states advanced by the kernels of fd_convolution.h
+    // (default), or one pole at a time by the FORTRAN loops
+    void fd_convolution(bool on) { fd_convolution_ = on; }
+    // TACS supplemental variables run as the code of tacs_bytecode.h
+    // (default), or interpreted by CSUP at each step
+    void tacs_bytecode(bool on) { tacs_bytecode_ = on; }
+    // the time of each CSUP call, listed with the case statistics (off by
+    // default: two clock reads a time step)
+    void tacs_timed(bool on) { tacs_timed_ = on; }
+    // the time of each chunk of the compiled network solution, listed with
+    // the case statistics (off by default: two clock reads a chunk a step)
+    void solve_timed(bool on) { solve_timed_ = on; }
+    // threads of each time step, the caller included (see step_pipeline.h):
+    // chunks of the line histories and of the network partitions, a writer of the time-series rows
+    // behind the steps, the frequencies of a LINE CONSTANTS sweep; 1 (default) runs the steps as the FORTRAN code
+    // does, 0 takes one per hardware thread
+    void step_threads(int n) { step_threads_ = n; }
+    // write the state of the time loop to "<out>.snap1", ... at time  t
+    // (see snapshot.h); each call adds one time
+    void snapshot_at(double t) { snapshot_times_.push_back(t); }
+    // go on from a snapshot file: the deck runs up to its time loop, then
+    // the state of the file takes over; the lists take the scale of the file
+    void restart_from(std::string file) { restart_file_ = std::move(file); }
+    // after the time loop, run it again for each variant of the switch
+    // times in  file  (see sweep.h), from the state at its start
+    void sweep(std::string file) { sweep_file_ = std::move(file); }
+  private:
+    void reset(int scale);
+    void run_once(
+      const std::string& inpFile,
+      const std::string& logFile,
+      const std::string& outFile);
+  };
+
+  // Extrema of one energization, as left in "XMAX" by the time loop, and
+  // its switch times.
+  struct EnergizationRecord {
+    std::vector<double> xmax;  // (XMAX, TMAX, XMIN, TMIN), each LSIZ12 long
+    double angle = 0.0;
+    double angtpe = 0.0;
+    int nswtpe = 0;
+    std::vector<double> times;  // ENERG_TIMES
+  };
+
+  // Runs the energizations of a STATISTICS / SYSTEMATIC case on a pool of
+  // worker contexts. The COMMON blocks cannot be copied (spans, TACS
+  // references, open units), so every worker re-reads the data deck up to
+  // the case in question and then simulates just its own energization KNT,
+  // drawing random closing times from a stream seeded by (SEED, KNT). The
+  // master context takes the records back in KNT order and passes each one
+  // through the usual code of "OVER20", so the LUNIT9 file read by "OVER29"
+  // and the printout do not depend on the number of threads.
+  class EnergizationPlan {
+  public:
+    EnergizationPlan(std::string inpFile, int nthreads, int scale = 1);
+    ~EnergizationPlan();
+    EnergizationPlan(const EnergizationPlan&) = delete;
+    EnergizationPlan& operator=(const EnergizationPlan&) = delete;
+
+    // master: simulate energizations  first, ..., |nenerg|  of statistics
+    // case number  ncase  of the deck
+    void start(int ncase, int first, int nenerg, double seed);
+    // master: wait for energization  knt  and copy it into  cmn
+    void restore(common& cmn, int knt);
+    // master: all records were merged, stop the workers
+    void finish();
+    bool pending() const { return pending_; }
+    int ncase() const { return ncase_; }
+    int nenerg() const { return nenerg_; }
+    double seed() const { return seed_; }
+    // worker: hand over the extrema of energization  cmn.energ_knt
+    void capture(const common& cmn);
+
+  private:
+    struct Slot {
+      EnergizationRecord rec;
+      std::exception_ptr error;
+      bool done = false;
+    };
+    struct Queue {
+      std::mutex mtx;
+      std::deque<int> knts;
+    };
+    void work(int id);
+    bool next(int id, int& knt);
+    void deliver(int knt, EnergizationRecord&& rec, std::exception_ptr error);
+
+    std::string inpFile_;
+    int nthreads_;
+    int scale_;  // EMTP list scale of the master context
+    int ncase_ = 0;
+    int first_ = 0;
+    int nenerg_ = 0;
+    double seed_ = 0.0;
+    bool pending_ = false;
+    std::atomic<bool> abort_{ false };
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex mtx_;
+    std::condition_variable ready_;
+    std::vector<Slot> slots_;  // index  knt - first
+  };
   void main10(common& cmn); // in emtp_2.cpp called from emtp_2.cpp
 
   void stoptp(common& cmn);
@@ -4732,6 +5077,11 @@ struct common :
   void emtspy(common&);
   void spying(common&);
   void tables(common& cmn);
+  void snapshot_common(Snapshot& s, common& cmn);
+  void snapshot_saves_1(Snapshot& s, common& cmn);
+  void snapshot_saves_2(Snapshot& s, common& cmn);
+  void snapshot_step(common& cmn);
+  bool sweep_next(common& cmn);
   void namea6(
       common& cmn,
       str_cref text1,
@@ -4806,8 +5156,9 @@ struct common :
   double seedy(
       common& cmn,
       str_arr_cref<> atim);
+  template <typename Cmn>
   void cominv(
-      common& cmn,
+      Cmn& cmn,
       arr_cref<double> a,
       arr_ref<double> b,
       int const& m,
@@ -4833,6 +5184,12 @@ struct common :
   double randnm(
       common& cmn,
       double const& x);
+  void ranstr(
+      common& cmn,
+      int const& ksw);
+  void ranblk(
+      common& cmn,
+      int const& kswtch);
   void top15(
       common& cmn);
   void frefix(
@@ -0,0 +1,1262 @@
+// EMTP C++
+// Dr. Alan W. Zhang <alan92127@gmail.com>
+// Copyright (c) 2020~, all rights reserved.
+//
+// The COMMON blocks in a snapshot file (snapshot.h): one block for each
+// COMMON of  struct common , in the order of its bases, each member in the
+// order of its declaration. References, spans and constants are left out;
+// they are set up again by the data deck. A member added to a COMMON has
+// to be added here too, or the snapshot goes on without it.
+//
+#include "emtp_cmn.h"
+
+namespace emtp {
+
+using namespace fem::major_types;
+
+void snapshot_common(
+  Snapshot& s,
+  common& cmn) try
+{
+  {
+    auto& c = static_cast<common_cmn&>(cmn);
+    s.block("cmn");
+    s(c.bus1, c.bus2, c.bus3, c.bus4, c.bus5, c.bus6, c.trash, c.blank, c.terra,
+      c.userid, c.branch, c.copy, c.csepar, c.chcont, c.texcol, c.texta6,
+      c.date1, c.tclock, c.vstacs, c.abuff, c.ci1, c.ck1, c.deltat, c.delta2,
+      c.freqcs, c.epsiln, c.xunits, c.aincr, c.xmaxmx, c.znolim, c.epszno,
+      c.epwarn, c.epstop, c.t, c.tolmat, c.tmax, c.omega, c.copt, c.xopt,
+      c.szplt, c.szbed, c.sglfir, c.sigmax, c.epsuba, c.epdgel, c.epomeg,
+      c.fminfs, c.delffs, c.fmaxfs, c.tenerg, c.begmax, c.tenm3, c.tenm6,
+      c.unity, c.onehaf, c.peaknd, c.fltinf, c.flzero, c.degmin, c.degmax,
+      c.statfr, c.voltbc, c.flstat, c.angle, c.pu, c.dltinv, c.speedl, c.moncar,
+      c.nright, c.nfrfld, c.kolbeg, c.max99m, c.kprchg, c.multpr, c.ipntv,
+      c.indtv, c.lstat, c.nbyte, c.lunsav, c.iprsov, c.icheck, c.iline, c.inonl,
+      c.iout, c.ipunch, c.iread, c.kol132, c.istep, c.kwtspy, c.itype, c.it1,
+      c.it2, c.izero, c.kcount, c.istead, c.ldata, c.lbrnch, c.lexct, c.lbus,
+      c.lymat, c.lswtch, c.lnonl, c.lchar, c.m4plot, c.lpast, c.lsize7, c.iplot,
+      c.ncomp, c.nv, c.lcomp, c.numsm, c.ifdep, c.ltails, c.lfdep, c.lwt,
+      c.last, c.npower, c.maxpe, c.lsiz12, c.lsmout, c.limass, c.iv, c.ktrlsw,
+      c.num99, c.kpartb, c.llbuff, c.kanal, c.nsmth, c.ntcsex, c.nstacs,
+      c.maxbus, c.lastov, c.ltacst, c.lhist, c.ifx, c.isubc1, c.inecho,
+      c.noutpr, c.ktab, c.jflsos, c.numdcd, c.numum, c.lspcum, c.nphcas,
+      c.ialter, c.ichar, c.ktref, c.memsav, c.lisoff, c.kburro, c.iaverg,
+      c.lsiz23, c.lsiz26, c.numout, c.moldat, c.lsiz27, c.lsiz28, c.ltlabl,
+      c.iwt, c.ifdep2, c.idoubl, c.ioutin, c.ipun, c.jst, c.jst1, c.muntsv,
+      c.numsub, c.maxzno, c.ifsem, c.lfsem, c.iadd, c.lfd, c.nexout, c.iofgnd,
+      c.iofbnd, c.modout, c.lint, c.iftail, c.ncurr, c.ioffd, c.isplot,
+      c.isprin, c.maxout, c.kill, c.ivolt, c.nchain, c.iprsup, c.intinf,
+      c.kconst, c.kswtch, c.it, c.ntot, c.ibr, c.lsyn, c.kssout, c.loopss,
+      c.numref, c.nword1, c.nword2, c.iloaep, c.lnpin, c.ntot1, c.limstp,
+      c.indstp, c.nc, c.icat, c.numnvo, c.nenerg);
+  }
+  {
+    auto& c = static_cast<common_comthl&>(cmn);
+    s.block("comthl");
+    s(c.angtpe, c.nswtpe);
+  }
+  {
+    auto& c = static_cast<common_comld&>(cmn);
+    s.block("comld");
+    s(c.newtac);
+  }
+  {
+    auto& c = static_cast<common_c29b01&>(cmn);
+    s.block("c29b01");
+    s(c.karray);
+  }
+  {
+    auto& c = static_cast<common_c0b001&>(cmn);
+    s.block("c0b001");
+    s(c.x);
+  }
+  {
+    auto& c = static_cast<common_c0b002&>(cmn);
+    s.block("c0b002");
+    s(c.ykm);
+  }
+  {
+    auto& c = static_cast<common_c0b003&>(cmn);
+    s.block("c0b003");
+    s(c.km);
+  }
+  {
+    auto& c = static_cast<common_c0b004&>(cmn);
+    s.block("c0b004");
+    s(c.xk);
+  }
+  {
+    auto& c = static_cast<common_c0b005&>(cmn);
+    s.block("c0b005");
+    s(c.xm);
+  }
+  {
+    auto& c = static_cast<common_c0b006&>(cmn);
+    s.block("c0b006");
+    s(c.weight);
+  }
+  {
+    auto& c = static_cast<common_c0b007&>(cmn);
+    s.block("c0b007");
+    s(c.iwtent);
+  }
+  {
+    auto& c = static_cast<common_c0b008&>(cmn);
+    s.block("c0b008");
+    s(c.con1);
+  }
+  {
+    auto& c = static_cast<common_c0b009&>(cmn);
+    s.block("c0b009");
+    s(c.iskip);
+  }
+  {
+    auto& c = static_cast<common_c0b010&>(cmn);
+    s.block("c0b010");
+    s(c.zinf);
+  }
+  {
+    auto& c = static_cast<common_c0b011&>(cmn);
+    s.block("c0b011");
+    s(c.eta);
+  }
+  {
+    auto& c = static_cast<common_c0b012&>(cmn);
+    s.block("c0b012");
+    s(c.nhist);
+  }
+  {
+    auto& c = static_cast<common_c0b013&>(cmn);
+    s.block("c0b013");
+    s(c.stailm);
+  }
+  {
+    auto& c = static_cast<common_c0b014&>(cmn);
+    s.block("c0b014");
+    s(c.stailk);
+  }
+  {
+    auto& c = static_cast<common_c0b015&>(cmn);
+    s.block("c0b015");
+    s(c.xmax);
+  }
+  {
+    auto& c = static_cast<common_c0b016&>(cmn);
+    s.block("c0b016");
+    s(c.koutvp);
+  }
+  {
+    auto& c = static_cast<common_c0b017&>(cmn);
+    s.block("c0b017");
+    s(c.bnrg);
+  }
+  {
+    auto& c = static_cast<common_c0b018&>(cmn);
+    s.block("c0b018");
+    s(c.sconst);
+  }
+  {
+    auto& c = static_cast<common_c0b019&>(cmn);
+    s.block("c0b019");
+    s(c.cnvhst);
+  }
+  {
+    auto& c = static_cast<common_c0b020&>(cmn);
+    s.block("c0b020");
+    s(c.sfd);
+  }
+  {
+    auto& c = static_cast<common_c0b021&>(cmn);
+    s.block("c0b021");
+    s(c.qfd);
+  }
+  {
+    auto& c = static_cast<common_c0b022&>(cmn);
+    s.block("c0b022");
+    s(c.semaux);
+  }
+  {
+    auto& c = static_cast<common_c0b023&>(cmn);
+    s.block("c0b023");
+    s(c.ibsout);
+  }
+  {
+    auto& c = static_cast<common_c0b024&>(cmn);
+    s.block("c0b024");
+    s(c.bvalue);
+  }
+  {
+    auto& c = static_cast<common_c0b025&>(cmn);
+    s.block("c0b025");
+    s(c.sptacs);
+  }
+  {
+    auto& c = static_cast<common_c0b026&>(cmn);
+    s.block("c0b026");
+    s(c.kswtyp);
+  }
+  {
+    auto& c = static_cast<common_c0b027&>(cmn);
+    s.block("c0b027");
+    s(c.modswt);
+  }
+  {
+    auto& c = static_cast<common_c0b028&>(cmn);
+    s.block("c0b028");
+    s(c.kbegsw);
+  }
+  {
+    auto& c = static_cast<common_c0b029&>(cmn);
+    s.block("c0b029");
+    s(c.lastsw);
+  }
+  {
+    auto& c = static_cast<common_c0b030&>(cmn);
+    s.block("c0b030");
+    s(c.kentnb);
+  }
+  {
+    auto& c = static_cast<common_c0b031&>(cmn);
+    s.block("c0b031");
+    s(c.nbhdsw);
+  }
+  {
+    auto& c = static_cast<common_c0b032&>(cmn);
+    s.block("c0b032");
+    s(c.topen);
+  }
+  {
+    auto& c = static_cast<common_c0b033&>(cmn);
+    s.block("c0b033");
+    s(c.crit);
+  }
+  {
+    auto& c = static_cast<common_c0b034&>(cmn);
+    s.block("c0b034");
+    s(c.kdepsw);
+  }
+  {
+    auto& c = static_cast<common_c0b035&>(cmn);
+    s.block("c0b035");
+    s(c.tdns);
+  }
+  {
+    auto& c = static_cast<common_c0b036&>(cmn);
+    s.block("c0b036");
+    s(c.isourc);
+  }
+  {
+    auto& c = static_cast<common_c0b037&>(cmn);
+    s.block("c0b037");
+    s(c.energy);
+  }
+  {
+    auto& c = static_cast<common_c0b038&>(cmn);
+    s.block("c0b038");
+    s(c.iardub);
+  }
+  {
+    auto& c = static_cast<common_c0b039&>(cmn);
+    s.block("c0b039");
+    s(c.ardube);
+  }
+  {
+    auto& c = static_cast<common_c0b040&>(cmn);
+    s.block("c0b040");
+    s(c.nonlad);
+  }
+  {
+    auto& c = static_cast<common_c0b041&>(cmn);
+    s.block("c0b041");
+    s(c.nonle);
+  }
+  {
+    auto& c = static_cast<common_c0b042&>(cmn);
+    s.block("c0b042");
+    s(c.vnonl);
+  }
+  {
+    auto& c = static_cast<common_c0b043&>(cmn);
+    s.block("c0b043");
+    s(c.curr);
+  }
+  {
+    auto& c = static_cast<common_c0b044&>(cmn);
+    s.block("c0b044");
+    s(c.anonl);
+  }
+  {
+    auto& c = static_cast<common_c0b045&>(cmn);
+    s.block("c0b045");
+    s(c.vecnl1);
+  }
+  {
+    auto& c = static_cast<common_c0b046&>(cmn);
+    s.block("c0b046");
+    s(c.vecnl2);
+  }
+  {
+    auto& c = static_cast<common_c0b047&>(cmn);
+    s.block("c0b047");
+    s(c.namenl);
+  }
+  {
+    auto& c = static_cast<common_c0b048&>(cmn);
+    s.block("c0b048");
+    s(c.vzer5);
+  }
+  {
+    auto& c = static_cast<common_c0b049&>(cmn);
+    s.block("c0b049");
+    s(c.ilast);
+  }
+  {
+    auto& c = static_cast<common_c0b050&>(cmn);
+    s.block("c0b050");
+    s(c.nltype);
+  }
+  {
+    auto& c = static_cast<common_c0b051&>(cmn);
+    s.block("c0b051");
+    s(c.kupl);
+  }
+  {
+    auto& c = static_cast<common_c0b052&>(cmn);
+    s.block("c0b052");
+    s(c.nlsub);
+  }
+  {
+    auto& c = static_cast<common_c0b053&>(cmn);
+    s.block("c0b053");
+    s(c.xoptbr);
+  }
+  {
+    auto& c = static_cast<common_c0b054&>(cmn);
+    s.block("c0b054");
+    s(c.coptbr);
+  }
+  {
+    auto& c = static_cast<common_c0b055&>(cmn);
+    s.block("c0b055");
+    s(c.cursub);
+  }
+  {
+    auto& c = static_cast<common_c0b056&>(cmn);
+    s.block("c0b056");
+    s(c.cchar);
+  }
+  {
+    auto& c = static_cast<common_c0b057&>(cmn);
+    s.block("c0b057");
+    s(c.vchar);
+  }
+  {
+    auto& c = static_cast<common_c0b058&>(cmn);
+    s.block("c0b058");
+    s(c.gslope);
+  }
+  {
+    auto& c = static_cast<common_c0b059&>(cmn);
+    s.block("c0b059");
+    s(c.ktrans);
+  }
+  {
+    auto& c = static_cast<common_c0b060&>(cmn);
+    s.block("c0b060");
+    s(c.kk);
+  }
+  {
+    auto& c = static_cast<common_c0b061&>(cmn);
+    s.block("c0b061");
+    s(c.c);
+  }
+  {
+    auto& c = static_cast<common_c0b062&>(cmn);
+    s.block("c0b062");
+    s(c.tr);
+  }
+  {
+    auto& c = static_cast<common_c0b063&>(cmn);
+    s.block("c0b063");
+    s(c.tx);
+  }
+  {
+    auto& c = static_cast<common_c0b064&>(cmn);
+    s.block("c0b064");
+    s(c.r);
+  }
+  {
+    auto& c = static_cast<common_c0b065&>(cmn);
+    s.block("c0b065");
+    s(c.nr);
+  }
+  {
+    auto& c = static_cast<common_c0b066&>(cmn);
+    s.block("c0b066");
+    s(c.length);
+  }
+  {
+    auto& c = static_cast<common_c0b067&>(cmn);
+    s.block("c0b067");
+    s(c.cik);
+  }
+  {
+    auto& c = static_cast<common_c0b068&>(cmn);
+    s.block("c0b068");
+    s(c.ci);
+  }
+  {
+    auto& c = static_cast<common_c0b069&>(cmn);
+    s.block("c0b069");
+    s(c.ck);
+  }
+  {
+    auto& c = static_cast<common_c0b070&>(cmn);
+    s.block("c0b070");
+    s(c.ismout);
+  }
+  {
+    auto& c = static_cast<common_c0b071&>(cmn);
+    s.block("c0b071");
+    s(c.elp);
+  }
+  {
+    auto& c = static_cast<common_c0b072&>(cmn);
+    s.block("c0b072");
+    s(c.cu);
+  }
+  {
+    auto& c = static_cast<common_c0b073&>(cmn);
+    s.block("c0b073");
+    s(c.shp);
+  }
+  {
+    auto& c = static_cast<common_c0b074&>(cmn);
+    s.block("c0b074");
+    s(c.histq);
+  }
+  {
+    auto& c = static_cast<common_c0b075&>(cmn);
+    s.block("c0b075");
+    s(c.ismdat);
+  }
+  {
+    auto& c = static_cast<common_c0b076&>(cmn);
+    s.block("c0b076");
+    s(c.texvec);
+  }
+  {
+    auto& c = static_cast<common_c0b077&>(cmn);
+    s.block("c0b077");
+    s(c.ibrnch);
+  }
+  {
+    auto& c = static_cast<common_c0b078&>(cmn);
+    s.block("c0b078");
+    s(c.jbrnch);
+  }
+  {
+    auto& c = static_cast<common_c0b079&>(cmn);
+    s.block("c0b079");
+    s(c.tstop);
+  }
+  {
+    auto& c = static_cast<common_c0b080&>(cmn);
+    s.block("c0b080");
+    s(c.nonlk);
+  }
+  {
+    auto& c = static_cast<common_c0b081&>(cmn);
+    s.block("c0b081");
+    s(c.nonlm);
+  }
+  {
+    auto& c = static_cast<common_c0b082&>(cmn);
+    s.block("c0b082");
+    s(c.spum);
+  }
+  {
+    auto& c = static_cast<common_c0b083&>(cmn);
+    s.block("c0b083");
+    s(c.kks);
+  }
+  {
+    auto& c = static_cast<common_c0b084&>(cmn);
+    s.block("c0b084");
+    s(c.kknonl);
+  }
+  {
+    auto& c = static_cast<common_c0b085&>(cmn);
+    s.block("c0b085");
+    s(c.znonl);
+  }
+  {
+    auto& c = static_cast<common_c0b086&>(cmn);
+    s.block("c0b086");
+    s(c.znonlb);
+  }
+  {
+    auto& c = static_cast<common_c0b087&>(cmn);
+    s.block("c0b087");
+    s(c.znonlc);
+  }
+  {
+    auto& c = static_cast<common_c0b088&>(cmn);
+    s.block("c0b088");
+    s(c.finit);
+  }
+  {
+    auto& c = static_cast<common_c0b089&>(cmn);
+    s.block("c0b089");
+    s(c.ksub);
+  }
+  {
+    auto& c = static_cast<common_c0b090&>(cmn);
+    s.block("c0b090");
+    s(c.msub);
+  }
+  {
+    auto& c = static_cast<common_c0b091&>(cmn);
+    s.block("c0b091");
+    s(c.isubeg);
+  }
+  {
+    auto& c = static_cast<common_c0b092&>(cmn);
+    s.block("c0b092");
+    s(c.litype);
+  }
+  {
+    auto& c = static_cast<common_c0b093&>(cmn);
+    s.block("c0b093");
+    s(c.imodel);
+  }
+  {
+    auto& c = static_cast<common_c0b094&>(cmn);
+    s.block("c0b094");
+    s(c.kbus);
+  }
+  {
+    auto& c = static_cast<common_c0b095&>(cmn);
+    s.block("c0b095");
+    s(c.mbus);
+  }
+  {
+    auto& c = static_cast<common_c0b096&>(cmn);
+    s.block("c0b096");
+    s(c.kodebr);
+  }
+  {
+    auto& c = static_cast<common_c0b097&>(cmn);
+    s.block("c0b097");
+    s(c.cki);
+  }
+  {
+    auto& c = static_cast<common_c0b098&>(cmn);
+    s.block("c0b098");
+    s(c.ckkjm);
+  }
+  {
+    auto& c = static_cast<common_c0b099&>(cmn);
+    s.block("c0b099");
+    s(c.indhst);
+  }
+  {
+    auto& c = static_cast<common_c0b100&>(cmn);
+    s.block("c0b100");
+    s(c.kodsem);
+  }
+  {
+    auto& c = static_cast<common_c0b101&>(cmn);
+    s.block("c0b101");
+    s(c.namebr);
+  }
+  {
+    auto& c = static_cast<common_c0b102&>(cmn);
+    s.block("c0b102");
+    s(c.iform);
+  }
+  {
+    auto& c = static_cast<common_c0b103&>(cmn);
+    s.block("c0b103");
+    s(c.node);
+  }
+  {
+    auto& c = static_cast<common_c0b104&>(cmn);
+    s.block("c0b104");
+    s(c.crest);
+  }
+  {
+    auto& c = static_cast<common_c0b105&>(cmn);
+    s.block("c0b105");
+    s(c.time1);
+  }
+  {
+    auto& c = static_cast<common_c0b106&>(cmn);
+    s.block("c0b106");
+    s(c.time2);
+  }
+  {
+    auto& c = static_cast<common_c0b107&>(cmn);
+    s.block("c0b107");
+    s(c.tstart);
+  }
+  {
+    auto& c = static_cast<common_c0b108&>(cmn);
+    s.block("c0b108");
+    s(c.sfreq);
+  }
+  {
+    auto& c = static_cast<common_c0b109&>(cmn);
+    s.block("c0b109");
+    s(c.kmswit);
+  }
+  {
+    auto& c = static_cast<common_c0b110&>(cmn);
+    s.block("c0b110");
+    s(c.nextsw);
+  }
+  {
+    auto& c = static_cast<common_c0b111&>(cmn);
+    s.block("c0b111");
+    s(c.rmfd);
+  }
+  {
+    auto& c = static_cast<common_c0b112&>(cmn);
+    s.block("c0b112");
+    s(c.cikfd);
+  }
+  {
+    auto& c = static_cast<common_c0b113&>(cmn);
+    s.block("c0b113");
+    s(c.imfd);
+  }
+  {
+    auto& c = static_cast<common_c0b114&>(cmn);
+    s.block("c0b114");
+    s(c.tclose);
+  }
+  {
+    auto& c = static_cast<common_c0b115&>(cmn);
+    s.block("c0b115");
+    s(c.adelay);
+  }
+  {
+    auto& c = static_cast<common_c0b116&>(cmn);
+    s.block("c0b116");
+    s(c.kpos);
+  }
+  {
+    auto& c = static_cast<common_c0b117&>(cmn);
+    s.block("c0b117");
+    s(c.namesw);
+  }
+  {
+    auto& c = static_cast<common_c0b118&>(cmn);
+    s.block("c0b118");
+    s(c.e);
+  }
+  {
+    auto& c = static_cast<common_c0b119&>(cmn);
+    s.block("c0b119");
+    s(c.f);
+  }
+  {
+    auto& c = static_cast<common_c0b120&>(cmn);
+    s.block("c0b120");
+    s(c.kssfrq);
+  }
+  {
+    auto& c = static_cast<common_c0b121&>(cmn);
+    s.block("c0b121");
+    s(c.kode);
+  }
+  {
+    auto& c = static_cast<common_c0b122&>(cmn);
+    s.block("c0b122");
+    s(c.kpsour);
+  }
+  {
+    auto& c = static_cast<common_c0b123&>(cmn);
+    s.block("c0b123");
+    s(c.volti);
+  }
+  {
+    auto& c = static_cast<common_c0b124&>(cmn);
+    s.block("c0b124");
+    s(c.voltk);
+  }
+  {
+    auto& c = static_cast<common_c0b125&>(cmn);
+    s.block("c0b125");
+    s(c.volt);
+  }
+  {
+    auto& c = static_cast<common_c0b126&>(cmn);
+    s.block("c0b126");
+    s(c.bus);
+  }
+  {
+    auto& c = static_cast<common_smtacs&>(cmn);
+    s.block("smtacs");
+    s(c.etac, c.ismtac, c.ntotac, c.lbstac);
+  }
+  {
+    auto& c = static_cast<common_comlock&>(cmn);
+    s.block("comlock");
+    s(c.locker);
+  }
+  {
+    auto& c = static_cast<common_smach&>(cmn);
+    s.block("smach");
+    s(c.z, c.x1, c.smoutv, c.sqrt3, c.asqrt3, c.sqrt32, c.thtw, c.athtw,
+      c.radeg, c.omdt, c.factom, c.damrat, c.delta6, c.om2, c.bin2, c.bdam,
+      c.bin_sm, c.mfirst, c.nst, c.itold, c.ibrold, c.nsmout, c.msmout);
+  }
+  {
+    auto& c = static_cast<common_umcom&>(cmn);
+    s.block("umcom");
+    s(c.busum, c.ptheta, c.zthevr, c.vinp, c.zthevs, c.umcur, c.con, c.dumvec,
+      c.dummat, c.date, c.clock, c.sroot2, c.sroot3, c.omegrf, c.inpu, c.numbus,
+      c.ncltot, c.ndum, c.initum, c.iureac, c.iugpar, c.iufpar, c.iuhist,
+      c.iuumrp, c.iunod1, c.iunod2, c.iujclt, c.iujclo, c.iujtyp, c.iunodo,
+      c.iujtmt, c.iuhism, c.iuomgm, c.iuomld, c.iutham, c.iuredu, c.iureds,
+      c.iuflds, c.iufldr, c.iurequ, c.iuflqs, c.iuflqr, c.iujcds, c.iujcqs,
+      c.iuflxd, c.iuflxq, c.iunppa, c.iurotm, c.iuncld, c.iunclq, c.iujtqo,
+      c.iujomo, c.iujtho, c.iureqs, c.iuepso, c.iudcoe, c.iukcoi, c.iuvolt,
+      c.iuangl, c.iunodf, c.iunodm, c.iukumo, c.iujumo, c.iuumou, c.nclfix,
+      c.numfix, c.iotfix, c.ibsfix, c.ksubum, c.nsmach, c.istart);
+  }
+  {
+    auto& c = static_cast<common_spycom&>(cmn);
+    s.block("spycom");
+    s(c.rampcn, c.rampsl, c.kyramp, c.fendrp, c.tminrp, c.tmaxrp, c.tbegrp,
+      c.tendrp, c.fbegrp, c.tbreak, c.epskon);
+  }
+  {
+    auto& c = static_cast<common_spykom&>(cmn);
+    s.block("spykom");
+    s(c.indxrp, c.ivec, c.iascii, c.numsym, c.jjroll, c.itexp, c.labels,
+      c.maxarg, c.kilper, c.kfile5, c.kverfy, c.jword, c.ibegcl, c.iendcl,
+      c.lidnt1, c.lidnt2, c.nbreak, c.linnow, c.linspn, c.numcrd, c.munit5,
+      c.numkey, c.indbuf, c.indbeg, c.mflush, c.newvec, c.maxflg, c.kspsav,
+      c.memkar, c.noback, c.ksmspy, c.lserlc, c.kserlc, c.kbrser, c.lockbr,
+      c.kerase, c.komadd, c.iprspy, c.monitr, c.monits, c.locate, c.nline,
+      c.kbreak, c.limbuf, c.kolout, c.limarr, c.imin, c.imax, c.numex, c.locout,
+      c.intout, c.nexmod, c.nextsn, c.inchlp, c.ksymbl, c.kopyit, c.kslowr,
+      c.limcrd, c.looprp, c.n10rmp, c.memrmp, c.kontac, c.konadd, c.kbegtx,
+      c.kar1, c.kar2, c.numrmp, c.luntsp, c.logvar);
+  }
+  {
+    auto& c = static_cast<common_spyf77&>(cmn);
+    s.block("spyf77");
+    s(c.filext, c.symb, c.col, c.bytfnd, c.char1, c.symbrp, c.abufsv, c.junker,
+      c.bytbuf, c.buff77, c.file6b, c.file6, c.blan80, c.prom80, c.digit,
+      c.texpar, c.spykwd, c.ansi8, c.ansi16, c.ansi32, c.spycd2, c.answ80,
+      c.brobus, c.munit6, c.outlin, c.outsav, c.heding, c.texspy);
+  }
+  {
+    auto& c = static_cast<common_comkwt&>(cmn);
+    s.block("comkwt");
+    s(c.kwtvax);
+  }
+  {
+    auto& c = static_cast<common_cblock&>(cmn);
+    s.block("cblock");
+    s(c.datepl, c.tclopl, c.bbus, c.tmult, c.dy, c.dx, c.hpi, c.tstep, c.gxmin,
+      c.gxmax, c.ew, c.finfin, c.fill, c.fvcom, c.yymin, c.yymax, c.ttmin,
+      c.ttmax, c.ylevel, c.ttlev, c.dyold, c.mlevel, c.aaa, c.bbb, c.kp,
+      c.fxref, c.fyref, c.evnbyt, c.ev, c.bx, c.vminr, c.vmaxr, c.mmm, c.mstart,
+      c.numpts, c.killpl, c.kstart, c.mplot, c.jhmsp, c.jchan, c.labrtm, c.jplt,
+      c.icp, c.icurse, c.mxypl, c.indexp, c.ind1, c.numflt, c.ncut, c.numtek,
+      c.newfil, c.mu6sav, c.mcurve, c.namvar, c.mfake, c.numraw, c.nchsup,
+      c.nchver, c.maxev, c.kptplt, c.numnvz, c.nvz, c.ncz, c.numbrn, c.numouz,
+      c.jplt1, c.jbegbv, c.jbegbc, c.limfix, c.nt2, c.maxew, c.maxip, c.msymbt,
+      c.l4plot, c.ivcom);
+  }
+  {
+    auto& c = static_cast<common_pltans&>(cmn);
+    s.block("pltans");
+    s(c.abuf77, c.ansi, c.ibuff, c.texfnt, c.sext, c.headl, c.vertl, c.buffin,
+      c.slot1, c.horzl, c.date, c.time, c.textd1, c.textd2, c.curren, c.voltag,
+      c.brclas, c.filnam, c.alpha, c.xytitl, c.anplt);
+  }
+  {
+    auto& c = static_cast<common_ekcom1&>(cmn);
+    s.block("ekcom1");
+    s(c.ekbuf, c.ektemp, c.errchk, c.solrsv, c.solisv, c.nitera, c.nekreq,
+      c.nekcod);
+  }
+  {
+    auto& c = static_cast<common_linemodel&>(cmn);
+    s.block("linemodel");
+    s(c.kexact, c.nsolve, c.fminsv, c.numrun, c.nphlmt, c.char80, c.chlmfs);
+  }
+  {
+    auto& c = static_cast<common_systematic&>(cmn);
+    s.block("systematic");
+    s(c.linsys);
+  }
+  {
+    auto& c = static_cast<common_komthl&>(cmn);
+    s.block("komthl");
+    s(c.pekexp);
+  }
+  {
+    auto& c = static_cast<common_com2&>(cmn);
+    s.block("com2");
+    s(c.n1, c.n2, c.n3, c.n4, c.lcount, c.model, c.l27dep, c.ibr1, c.nrecur,
+      c.kgroup, c.nc4, c.nc5, c.ifq, c.n13, c.ida, c.ifkc, c.idy, c.idm, c.idq,
+      c.idu, c.idt, c.iq, c.nc6, c.nc3);
+  }
+  {
+    auto& c = static_cast<common_veccom&>(cmn);
+    s.block("veccom");
+    s(c.kntvec, c.kofvec);
+  }
+  {
+    auto& c = static_cast<common_spac01&>(cmn);
+    s.block("spac01");
+    s(c.tp);
+  }
+  {
+    auto& c = static_cast<common_spac02&>(cmn);
+    s.block("spac02");
+    s(c.norder);
+  }
+  {
+    auto& c = static_cast<common_spac03&>(cmn);
+    s.block("spac03");
+    s(c.index);
+  }
+  {
+    auto& c = static_cast<common_spac04&>(cmn);
+    s.block("spac04");
+    s(c.diag);
+  }
+  {
+    auto& c = static_cast<common_spac05&>(cmn);
+    s.block("spac05");
+    s(c.diab);
+  }
+  {
+    auto& c = static_cast<common_spac06&>(cmn);
+    s.block("spac06");
+    s(c.solr);
+  }
+  {
+    auto& c = static_cast<common_spac07&>(cmn);
+    s.block("spac07");
+    s(c.soli);
+  }
+  {
+    auto& c = static_cast<common_spac08&>(cmn);
+    s.block("spac08");
+    s(c.ich1);
+  }
+  {
+    auto& c = static_cast<common_spac09&>(cmn);
+    s.block("spac09");
+    s(c.bnd);
+  }
+  {
+    auto& c = static_cast<common_spac10&>(cmn);
+    s.block("spac10");
+    s(c.iloc);
+  }
+  {
+    auto& c = static_cast<common_spac11&>(cmn);
+    s.block("spac11");
+    s(c.gnd);
+  }
+  {
+    auto& c = static_cast<common_c10b01&>(cmn);
+    s.block("c10b01");
+    s(c.jndex);
+  }
+  {
+    auto& c = static_cast<common_c10b02&>(cmn);
+    s.block("c10b02");
+    s(c.diagg);
+  }
+  {
+    auto& c = static_cast<common_c10b03&>(cmn);
+    s.block("c10b03");
+    s(c.diabb);
+  }
+  {
+    auto& c = static_cast<common_c10b04&>(cmn);
+    s.block("c10b04");
+    s(c.solrsv);
+  }
+  {
+    auto& c = static_cast<common_c10b05&>(cmn);
+    s.block("c10b05");
+    s(c.solisv);
+  }
+  {
+    auto& c = static_cast<common_c10b06&>(cmn);
+    s.block("c10b06");
+    s(c.gndd);
+  }
+  {
+    auto& c = static_cast<common_c10b07&>(cmn);
+    s.block("c10b07");
+    s(c.bndd);
+  }
+  {
+    auto& c = static_cast<common_c10b08&>(cmn);
+    s.block("c10b08");
+    s(c.nekfix);
+  }
+  {
+    auto& c = static_cast<common_c10b09&>(cmn);
+    s.block("c10b09");
+    s(c.fxtem1);
+  }
+  {
+    auto& c = static_cast<common_c10b10&>(cmn);
+    s.block("c10b10");
+    s(c.fxtem2);
+  }
+  {
+    auto& c = static_cast<common_c10b11&>(cmn);
+    s.block("c10b11");
+    s(c.fxtem3);
+  }
+  {
+    auto& c = static_cast<common_c10b12&>(cmn);
+    s.block("c10b12");
+    s(c.fxtem4);
+  }
+  {
+    auto& c = static_cast<common_c10b13&>(cmn);
+    s.block("c10b13");
+    s(c.fxtem5);
+  }
+  {
+    auto& c = static_cast<common_c10b14&>(cmn);
+    s.block("c10b14");
+    s(c.fxtem6);
+  }
+  {
+    auto& c = static_cast<common_c10b15&>(cmn);
+    s.block("c10b15");
+    s(c.fixbu1);
+  }
+  {
+    auto& c = static_cast<common_c10b16&>(cmn);
+    s.block("c10b16");
+    s(c.fixbu2);
+  }
+  {
+    auto& c = static_cast<common_c10b17&>(cmn);
+    s.block("c10b17");
+    s(c.fixbu3);
+  }
+  {
+    auto& c = static_cast<common_c10b18&>(cmn);
+    s.block("c10b18");
+    s(c.fixbu4);
+  }
+  {
+    auto& c = static_cast<common_c10b19&>(cmn);
+    s.block("c10b19");
+    s(c.fixbu5);
+  }
+  {
+    auto& c = static_cast<common_c10b20&>(cmn);
+    s.block("c10b20");
+    s(c.fixbu6);
+  }
+  {
+    auto& c = static_cast<common_c10b21&>(cmn);
+    s.block("c10b21");
+    s(c.fixbu7);
+  }
+  {
+    auto& c = static_cast<common_c10b22&>(cmn);
+    s.block("c10b22");
+    s(c.fixbu8);
+  }
+  {
+    auto& c = static_cast<common_c10b23&>(cmn);
+    s.block("c10b23");
+    s(c.fixbu9);
+  }
+  {
+    auto& c = static_cast<common_c10b24&>(cmn);
+    s.block("c10b24");
+    s(c.fixb10);
+  }
+  {
+    auto& c = static_cast<common_c10b25&>(cmn);
+    s.block("c10b25");
+    s(c.fixb11);
+  }
+  {
+    auto& c = static_cast<common_c10b26&>(cmn);
+    s.block("c10b26");
+    s(c.kndex);
+  }
+  {
+    auto& c = static_cast<common_a8sw&>(cmn);
+    s.block("a8sw");
+    s(c.a8sw);
+  }
+  {
+    auto& c = static_cast<common_fdqlcl&>(cmn);
+    s.block("fdqlcl");
+    s(c.koff1, c.koff2, c.koff3, c.koff4, c.koff5, c.koff6, c.koff7, c.koff8,
+      c.koff9, c.koff10, c.koff13, c.koff14, c.koff15, c.koff16, c.koff17,
+      c.koff18, c.koff19, c.koff20, c.koff21, c.koff22, c.koff23, c.koff24,
+      c.koff25, c.inoff1, c.inoff2, c.inoff3, c.inoff4, c.inoff5, c.nqtt,
+      c.lcbl, c.lmode, c.nqtw);
+  }
+  {
+    auto& c = static_cast<common_com44&>(cmn);
+    s.block("com44");
+    s(c.bcars, c.ccars, c.dcars, c.fbe, c.brname, c.fbed, c.fke, c.fked,
+      c.picon, c.sqrt2, c.valu1, c.valu2, c.valu3, c.valu4, c.valu5, c.valu6,
+      c.valu7, c.valu8, c.valu9, c.valu10, c.valu11, c.valu12, c.valu13,
+      c.corchk, c.aaa1, c.aaa2, c.ll0, c.ll1, c.ll2, c.ll3, c.ll5, c.ll6, c.ll7,
+      c.ll8, c.ll9, c.ll10, c.lphase, c.lphpl1, c.lphd2, c.lgdbd, c.jpralt,
+      c.nfreq);
+  }
+  {
+    auto& c = static_cast<common_com29&>(cmn);
+    s.block("com29");
+    s(c.per, c.xmean1, c.xvar1, c.stdev1, c.vmax, c.liminc, c.iofarr, c.nvar,
+      c.key, c.maxo29);
+  }
+  {
+    auto& c = static_cast<common_ldec31&>(cmn);
+    s.block("ldec31");
+    s(c.kalcom);
+  }
+  {
+    auto& c = static_cast<common_com39&>(cmn);
+    s.block("com39");
+    s(c.tir, c.tii, c.tdum, c.modskp, c.alinvc, c.akfrac, c.alphaf, c.fczr,
+      c.fcpr, c.fcz, c.fcp, c.indxv, c.xauxd, c.zoprau, c.zoprao, c.azepo,
+      c.xchkra, c.xknee, c.noprao, c.hreflg, c.aptdec, c.gmode, c.amina1,
+      c.onehav, c.oneqtr, c.hrflgr, c.epstol, c.refa, c.refb, c.idebug,
+      c.iftype, c.lout, c.ndata, c.ntotra, c.nzone, c.izone, c.nrange, c.modify,
+      c.nexmis, c.normax, c.ifwta, c.koutpr, c.inelim, c.ifplot, c.ifdat,
+      c.iecode, c.nzeror, c.npoler, c.modesk, c.metrik);
+  }
+  {
+    auto& c = static_cast<common_c39b01&>(cmn);
+    s.block("c39b01");
+    s(c.xdat);
+  }
+  {
+    auto& c = static_cast<common_c39b02&>(cmn);
+    s.block("c39b02");
+    s(c.ydat);
+  }
+  {
+    auto& c = static_cast<common_c39b03&>(cmn);
+    s.block("c39b03");
+    s(c.aphdat);
+  }
+  {
+    auto& c = static_cast<common_c44b02&>(cmn);
+    s.block("c44b02");
+    s(c.p);
+  }
+  {
+    auto& c = static_cast<common_c44b03&>(cmn);
+    s.block("c44b03");
+    s(c.z);
+  }
+  {
+    auto& c = static_cast<common_c44b04&>(cmn);
+    s.block("c44b04");
+    s(c.ic);
+  }
+  {
+    auto& c = static_cast<common_c44b05&>(cmn);
+    s.block("c44b05");
+    s(c.r);
+  }
+  {
+    auto& c = static_cast<common_c44b06&>(cmn);
+    s.block("c44b06");
+    s(c.dz);
+  }
+  {
+    auto& c = static_cast<common_c44b07&>(cmn);
+    s.block("c44b07");
+    s(c.gmd);
+  }
+  {
+    auto& c = static_cast<common_c44b08&>(cmn);
+    s.block("c44b08");
+    s(c.x);
+  }
+  {
+    auto& c = static_cast<common_c44b09&>(cmn);
+    s.block("c44b09");
+    s(c.y);
+  }
+  {
+    auto& c = static_cast<common_c44b10&>(cmn);
+    s.block("c44b10");
+    s(c.tb2);
+  }
+  {
+    auto& c = static_cast<common_c44b11&>(cmn);
+    s.block("c44b11");
+    s(c.itb3);
+  }
+  {
+    auto& c = static_cast<common_c44b12&>(cmn);
+    s.block("c44b12");
+    s(c.workr1);
+  }
+  {
+    auto& c = static_cast<common_c44b13&>(cmn);
+    s.block("c44b13");
+    s(c.workr2);
+  }
+  {
+    auto& c = static_cast<common_c44b14&>(cmn);
+    s.block("c44b14");
+    s(c.text);
+  }
+  {
+    auto& c = static_cast<common_c44b15&>(cmn);
+    s.block("c44b15");
+    s(c.gd);
+  }
+  {
+    auto& c = static_cast<common_c44b16&>(cmn);
+    s.block("c44b16");
+    s(c.bd);
+  }
+  {
+    auto& c = static_cast<common_c44b17&>(cmn);
+    s.block("c44b17");
+    s(c.yd);
+  }
+  {
+    auto& c = static_cast<common_c44b18&>(cmn);
+    s.block("c44b18");
+    s(c.itbic);
+  }
+  {
+    auto& c = static_cast<common_c44b19&>(cmn);
+    s.block("c44b19");
+    s(c.tbr);
+  }
+  {
+    auto& c = static_cast<common_c44b20&>(cmn);
+    s.block("c44b20");
+    s(c.tbd);
+  }
+  {
+    auto& c = static_cast<common_c44b21&>(cmn);
+    s.block("c44b21");
+    s(c.tbg);
+  }
+  {
+    auto& c = static_cast<common_c44b22&>(cmn);
+    s.block("c44b22");
+    s(c.tbx);
+  }
+  {
+    auto& c = static_cast<common_c44b23&>(cmn);
+    s.block("c44b23");
+    s(c.tby);
+  }
+  {
+    auto& c = static_cast<common_c44b24&>(cmn);
+    s.block("c44b24");
+    s(c.tbtb2);
+  }
+  {
+    auto& c = static_cast<common_c44b25&>(cmn);
+    s.block("c44b25");
+    s(c.itbtb3);
+  }
+  {
+    auto& c = static_cast<common_c44b26&>(cmn);
+    s.block("c44b26");
+    s(c.tbtext);
+  }
+  {
+    auto& c = static_cast<common_volpri&>(cmn);
+    s.block("volpri");
+    s(c.volti_50, c.voltk_50, c.vim);
+  }
+  {
+    auto& c = static_cast<common_com45&>(cmn);
+    s.block("com45");
+    s(c.pl, c.f, c.w, c.cold, c.xpan, c.conv5, c.ratio, c.pi2, c.sll, c.spdlt,
+      c.tt, c.tstrt, c.tretrd, c.tstep, c.ffin, c.shiftr, c.shifti, c.d, c.x,
+      c.dplu, c.dmin, c.ictrl, c.i1, c.iwork, c.nph, c.nph2, c.nphpi2, c.n22,
+      c.nphsq, c.ntri, c.iss, c.nfr, c.nfr1, c.ix, c.kreqab);
+  }
+  {
+    auto& c = static_cast<common_com47&>(cmn);
+    s.block("com47");
+    s(c.bin, c.bkn, c.cimag1, c.creal1, c.czero, c.ypo, c.alf1, c.alf2, c.dep1,
+      c.dep2, c.e0, c.e2p, c.radp, c.alpi, c.bp1, c.bp2, c.es1, c.es2, c.rop,
+      c.usp, c.hyud2, c.hyud3, c.hyud4, c.htoj2, c.htoj3, c.fzero, c.htoj4,
+      c.pai, c.roe, c.spdlgt, c.u0, c.u2p, c.value1, c.value2, c.value3,
+      c.value4, c.value5, c.valu14, c.iearth, c.itypec, c.ncct, c.ncc, c.npc,
+      c.izflag, c.iyflag, c.npc2, c.np2, c.logsix, c.kmode, c.iprs47, c.npais,
+      c.ncros, c.numaki, c.npp, c.iprint);
+  }
+  {
+    auto& c = static_cast<common_newt1&>(cmn);
+    s.block("newt1");
+    s(c.rwin, c.zhl, c.zht, c.zlt, c.k, c.m, c.idelt, c.logsix);
+  }
+  {
+    auto& c = static_cast<common_zprint&>(cmn);
+    s.block("zprint");
+    s(c.zoutr, c.zoutx);
+  }
+  s.block("umd1");
+    s(cmn.umd1.texta, cmn.umd1.d1, cmn.umd1.d2, cmn.umd1.d3, cmn.umd1.d17,
+      cmn.umd1.stat59, cmn.umd1.fmum, cmn.umd1.rmvaum, cmn.umd1.rkvum,
+      cmn.umd1.s1um, cmn.umd1.s2um, cmn.umd1.zlsbum, cmn.umd1.s1qum,
+      cmn.umd1.s2qum, cmn.umd1.aglqum, cmn.umd1.raum, cmn.umd1.xdum,
+      cmn.umd1.squm, cmn.umd1.xdpum, cmn.umd1.xqpum, cmn.umd1.xdppum,
+      cmn.umd1.xqppum, cmn.umd1.tdpum, cmn.umd1.tdppum, cmn.umd1.x0um,
+      cmn.umd1.rnum, cmn.umd1.xnum, cmn.umd1.xfum, cmn.umd1.xdfum,
+      cmn.umd1.xdkdum, cmn.umd1.xkdum, cmn.umd1.xkqum, cmn.umd1.xqkqum,
+      cmn.umd1.xgkqum, cmn.umd1.xqum, cmn.umd1.xqgum, cmn.umd1.xgum,
+      cmn.umd1.distrf, cmn.umd1.hjum, cmn.umd1.dsynum, cmn.umd1.dmutum,
+      cmn.umd1.spring, cmn.umd1.dabsum, cmn.umd1.tqppum, cmn.umd1.agldum,
+      cmn.umd1.xlum, cmn.umd1.nz1, cmn.umd1.nz2, cmn.umd1.nz3, cmn.umd1.nz4,
+      cmn.umd1.n5, cmn.umd1.n6, cmn.umd1.n7, cmn.umd1.n8, cmn.umd1.n9,
+      cmn.umd1.n10, cmn.umd1.n11, cmn.umd1.n12, cmn.umd1.n14, cmn.umd1.n15,
+      cmn.umd1.n16, cmn.umd1.n17, cmn.umd1.n18, cmn.umd1.n19, cmn.umd1.n20,
+      cmn.umd1.jr, cmn.umd1.jf, cmn.umd1.nexc, cmn.umd1.kconex, cmn.umd1.ibrexc,
+      cmn.umd1.nstan, cmn.umd1.numasu, cmn.umd1.nmgen, cmn.umd1.nmexc,
+      cmn.umd1.ntypsm, cmn.umd1.netrun, cmn.umd1.netrum, cmn.umd1.nsmtpr,
+      cmn.umd1.nsmtac, cmn.umd1.nrsyn, cmn.umd1.ntorq, cmn.umd1.mlum,
+      cmn.umd1.nparum, cmn.umd1.ngroup, cmn.umd1.nall, cmn.umd1.nangre,
+      cmn.umd1.nexcsw, cmn.umd1.limasu, cmn.umd1.lopss2, cmn.umd1.lopss1,
+      cmn.umd1.lopss8, cmn.umd1.lopss9, cmn.umd1.lopss10, cmn.umd1.lopss4,
+      cmn.umd1.nshare);
+  s.block("umd2");
+    s(cmn.umd2.n1, cmn.umd2.n2, cmn.umd2.n3, cmn.umd2.n4, cmn.umd2.n5,
+      cmn.umd2.n6, cmn.umd2.n7, cmn.umd2.n8, cmn.umd2.n9, cmn.umd2.n10,
+      cmn.umd2.n11, cmn.umd2.n12, cmn.umd2.n17, cmn.umd2.n18, cmn.umd2.n19,
+      cmn.umd2.n20, cmn.umd2.d1, cmn.umd2.d2, cmn.umd2.d3, cmn.umd2.d4,
+      cmn.umd2.d5, cmn.umd2.d6, cmn.umd2.d7, cmn.umd2.d8, cmn.umd2.d9,
+      cmn.umd2.d10, cmn.umd2.d11, cmn.umd2.d12, cmn.umd2.d13, cmn.umd2.d14,
+      cmn.umd2.d15, cmn.umd2.d16, cmn.umd2.d17, cmn.umd2.d18, cmn.umd2.lfim3,
+      cmn.umd2.lfim4i, cmn.umd2.ncomcl, cmn.umd2.ncomum, cmn.umd2.kcld1,
+      cmn.umd2.kclq1, cmn.umd2.kclf, cmn.umd2.nminum, cmn.umd2.lopsz1,
+      cmn.umd2.lopsz2, cmn.umd2.lopsz4, cmn.umd2.lopsz8, cmn.umd2.lopsz9,
+      cmn.umd2.lopsz10, cmn.umd2.slip);
+}
+catch (...) {
+  std::throw_with_nested(std::runtime_error(__func__ + std::string("()")));
+}
+
+} // namespace emtp
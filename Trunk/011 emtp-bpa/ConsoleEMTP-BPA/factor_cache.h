@@ -0,0 +1,190 @@
+/***********************************
+EMTP C++
+Cache of the triangularized (Y) of SUBTS1 by switch configuration: a
+recurring set of closed switches gets its factors back without elimination.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "partial_factor.h"
+
+namespace emtp {
+
+  // The factors of (Y) follow from the rows of (Y) and the KODE chains,
+  // which tie together the nodes of closed switches. An entry keeps both,
+  // with the factor rows KM / YKM (1 : IUPPER) and the row ends KK they
+  // gave. It is found by a hash of the chains, i.e. of which switches are
+  // closed, and used only if the chains, KKS and (Y) are the same to the
+  // bit, so a hit restores exactly what the elimination would give. The
+  // least recently used entries go when the budget of bytes is exceeded.
+  class FactorCache {
+  public:
+    void budget(std::size_t bytes) {
+      budget_ = bytes;
+      trim();
+    }
+    std::size_t budget() const { return budget_; }
+    bool enabled() const { return budget_ > 0; }
+    void clear() {
+      lru_.clear();
+      index_.clear();
+      bytes_ = 0;
+    }
+
+    // factors of the present (Y) and chains into KM / YKM / KK and
+    // iupper ; the partial retriangularization then starts from them
+    template<typename K, typename Y, typename KK, typename S, typename C>
+    bool restore(K& km, Y& ykm, KK& kk, const S& kks, const C& kode,
+      int ntot, int kpartb, int& iupper, PartialFactor& partial) {
+      std::uint64_t const key = hash(kode, ntot);
+      auto const it = index_.find(key);
+      if (it == index_.end() || !same(*it->second, km, ykm, kks, kode, ntot, kpartb)) {
+        ++misses_;
+        return false;
+      }
+      lru_.splice(lru_.begin(), lru_, it->second);
+      Entry const& e = lru_.front();
+      iupper = e.iupper;
+      for (int i = 1; i <= iupper; ++i) {
+        km(i) = e.fkm[i - 1];
+        ykm(i) = e.fykm[i - 1];
+      }
+      for (int L = 1; L <= kpartb; ++L)
+        kk(L) = e.kk[L];
+      partial.snapshot(km, ykm, kks, kode, ntot, kpartb);
+      partial.set_ends(e.ends);
+      ++hits_;
+      return true;
+    }
+
+    // factors just computed for the present (Y) and chains
+    template<typename K, typename Y, typename KK, typename S, typename C>
+    void store(const K& km, const Y& ykm, const KK& kk, const S& kks, const C& kode,
+      int ntot, int kpartb, int iupper, const PartialFactor& partial) {
+      std::uint64_t const key = hash(kode, ntot);
+      if (auto const it = index_.find(key); it != index_.end()) {
+        bytes_ -= it->second->bytes();
+        lru_.erase(it->second);
+        index_.erase(it);
+      }
+      Entry e;
+      e.key = key;
+      e.ntot = ntot;
+      e.kpartb = kpartb;
+      e.iupper = iupper;
+      e.kode.resize(ntot + 1);
+      for (int i = 1; i <= ntot; ++i)
+        e.kode[i] = kode(i);
+      e.kks.resize(kpartb + 1);
+      e.kk.resize(kpartb + 1);
+      int hi = 0;
+      for (int L = 1; L <= kpartb; ++L) {
+        e.kks[L] = kks(L);
+        e.kk[L] = kk(L);
+        if (L >= 2 && kks(L) - 1 > hi)
+          hi = kks(L) - 1;
+      }
+      e.lo = kks(1);
+      e.ykm_y.reserve(std::size_t(std::max(hi - e.lo + 1, 0)));
+      e.km_y.reserve(e.ykm_y.capacity());
+      for (int j = e.lo; j <= hi; ++j) {
+        e.ykm_y.push_back(ykm(j));
+        e.km_y.push_back(km(j));
+      }
+      e.fkm.resize(iupper);
+      e.fykm.resize(iupper);
+      for (int i = 1; i <= iupper; ++i) {
+        e.fkm[i - 1] = km(i);
+        e.fykm[i - 1] = ykm(i);
+      }
+      e.ends = partial.ends();
+      if (e.bytes() > budget_)
+        return;
+      bytes_ += e.bytes();
+      lru_.push_front(std::move(e));
+      index_[key] = lru_.begin();
+      trim();
+    }
+
+    std::int64_t hits() const { return hits_; }
+    std::int64_t misses() const { return misses_; }
+    std::size_t entries() const { return lru_.size(); }
+    std::size_t bytes() const { return bytes_; }
+
+  private:
+    struct Entry {
+      std::uint64_t key = 0;
+      int ntot = 0;
+      int kpartb = 0;
+      int iupper = 0;
+      int lo = 0;
+      std::vector<int> kode, kks, kk, km_y, fkm, ends;
+      std::vector<double> ykm_y, fykm;
+      std::size_t bytes() const {
+        return sizeof(Entry) + sizeof(int) * (kode.size() + kks.size() + kk.size()
+          + km_y.size() + fkm.size() + ends.size())
+          + sizeof(double) * (ykm_y.size() + fykm.size());
+      }
+    };
+
+    // FNV-1a over the chains
+    template<typename C>
+    static std::uint64_t hash(const C& kode, int ntot) {
+      std::uint64_t h = 14695981039346656037ull;
+      for (int i = 1; i <= ntot; ++i) {
+        std::uint32_t const v = std::uint32_t(kode(i));
+        for (int b = 0; b < 4; ++b) {
+          h ^= (v >> (8 * b)) & 0xffu;
+          h *= 1099511628211ull;
+        }
+      }
+      return h;
+    }
+    template<typename K, typename Y, typename S, typename C>
+    static bool same(const Entry& e, const K& km, const Y& ykm, const S& kks,
+      const C& kode, int ntot, int kpartb) {
+      if (e.ntot != ntot || e.kpartb != kpartb)
+        return false;
+      for (int i = 1; i <= ntot; ++i) {
+        if (kode(i) != e.kode[i])
+          return false;
+      }
+      for (int L = 1; L <= kpartb; ++L) {
+        if (kks(L) != e.kks[L])
+          return false;
+      }
+      for (std::size_t k = 0; k < e.km_y.size(); ++k) {
+        int const j = e.lo + int(k);
+        double const y = ykm(j);
+        if (km(j) != e.km_y[k] || std::memcmp(&y, &e.ykm_y[k], sizeof(y)) != 0)
+          return false;
+      }
+      return true;
+    }
+    void trim() {
+      while (bytes_ > budget_ && !lru_.empty()) {
+        bytes_ -= lru_.back().bytes();
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+      }
+    }
+
+    std::size_t budget_ = 0;
+    std::size_t bytes_ = 0;
+    std::list<Entry> lru_;
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index_;
+    std::int64_t hits_ = 0;
+    std::int64_t misses_ = 0;
+  };
+
+}
@@ -0,0 +1,100 @@
+/***********************************
+EMTP C++
+Recursive convolutions of the frequency-dependent (JMarti) branches of
+SUBTS2: the pole states of one mode advanced four poles per SIMD step.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <cstddef>
+
+// GCC / Clang on x86-64 Linux build zeros() and poles() for AVX-512, AVX2
+// and the base instruction set and pick one by CPUID when the program is
+// loaded (ifunc). MSVC has no such dispatch: there the kernels take the
+// instruction set of the project (/arch), SSE2 unless set otherwise.
+// No clone may fuse a multiply and an add (FMA), or the bits would change.
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__)
+#if defined(__clang__)
+#define EMTP_FD_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#define EMTP_FD_NO_FMA _Pragma("clang fp contract(off)")
+#else
+#define EMTP_FD_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default"), \
+  optimize("fp-contract=off")))
+#define EMTP_FD_NO_FMA
+#endif
+#else
+#define EMTP_FD_DISPATCH
+#define EMTP_FD_NO_FMA
+#endif
+
+namespace emtp {
+
+  // A JMarti mode keeps its fitted Zc (NRZ zeros) and A1 (NRA poles) in
+  // SCONST as columns: the coefficients M, P, Q of every term one after
+  // another, then the states of the K and M ends. Each step advances
+  // every state by one exponential recursion,
+  //   S(i) = M(i) * S(i) + P(i) * U + Q(i) * V ,
+  // independent of the other terms, and then sums C(i) * S(i) in order.
+  // The FORTRAN loops do that one term at a time through the SCONST
+  // subscripts; here the columns are taken as they lie, four terms per
+  // SIMD step, with the sums left in the order of the FORTRAN loops so
+  // that the results are the same to the bit.
+  struct FdConvolution {
+    // characteristic impedance (loop on NRZ):
+    //   SK(i) = P(i) * UK + Q(i) * VK + M(i) * SK(i), and SM(i) alike
+    EMTP_FD_DISPATCH static void zeros(const double* __restrict m, const double* __restrict p,
+      const double* __restrict q, double* __restrict sk, double* __restrict sm,
+      double uk, double vk, double um, double vm, std::size_t n) {
+      EMTP_FD_NO_FMA
+      std::size_t const nl = n - n % lanes;
+      std::size_t j = 0;
+      for (; j < nl; j += lanes) {
+        for (std::size_t l = j; l < j + lanes; ++l) {
+          sk[l] = p[l] * uk + q[l] * vk + m[l] * sk[l];
+          sm[l] = p[l] * um + q[l] * vm + m[l] * sm[l];
+        }
+      }
+      for (; j < n; ++j) {
+        sk[j] = p[j] * uk + q[j] * vk + m[j] * sk[j];
+        sm[j] = p[j] * um + q[j] * vm + m[j] * sm[j];
+      }
+    }
+    // propagation function (loop on NRA):
+    //   SK(i) = M(i) * SK(i) + A(i) * UK + B(i) * VK, and SM(i) alike
+    EMTP_FD_DISPATCH static void poles(const double* __restrict m, const double* __restrict a,
+      const double* __restrict b, double* __restrict sk, double* __restrict sm,
+      double uk, double vk, double um, double vm, std::size_t n) {
+      EMTP_FD_NO_FMA
+      std::size_t const nl = n - n % lanes;
+      std::size_t j = 0;
+      for (; j < nl; j += lanes) {
+        for (std::size_t l = j; l < j + lanes; ++l) {
+          sk[l] = m[l] * sk[l] + a[l] * uk + b[l] * vk;
+          sm[l] = m[l] * sm[l] + a[l] * um + b[l] * vm;
+        }
+      }
+      for (; j < n; ++j) {
+        sk[j] = m[j] * sk[j] + a[j] * uk + b[j] * vk;
+        sm[j] = m[j] * sm[j] + a[j] * um + b[j] * vm;
+      }
+    }
+    // yk += SUM C(i) * SK(i), ym += SUM C(i) * SM(i), i in increasing order
+    static void sums(double& yk, double& ym, const double* __restrict c,
+      const double* __restrict sk, const double* __restrict sm, std::size_t n) {
+      double k = yk;
+      double m = ym;
+      for (std::size_t j = 0; j < n; ++j) {
+        k += c[j] * sk[j];
+        m += c[j] * sm[j];
+      }
+      yk = k;
+      ym = m;
+    }
+
+  private:
+    static constexpr std::size_t lanes = 4;
+  };
+
+}
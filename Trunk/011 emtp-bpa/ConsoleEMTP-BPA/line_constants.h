@@ -0,0 +1,695 @@
+/***********************************
+EMTP C++
+Series impedance matrix of LINE CONSTANTS (GUTS44) at one frequency, as a
+function of the line geometry alone, and the frequencies of a logarithmic
+sweep evaluated ahead on the step threads.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+#include "step_pipeline.h"
+
+namespace emtp {
+
+  // Constants of the Carson series and of the Kelvin functions of the skin
+  // effect, as GUTS44 sets them up (BCARS, ..., FKED and the VALU's).
+  struct CarsonTables {
+    double unity = 0.0, onehaf = 0.0, twopi = 0.0, tenm6 = 0.0, sqrt2 = 0.0;
+    double corchk = 0.0;
+    double valu2 = 0.0, valu3 = 0.0, valu4 = 0.0, valu8 = 0.0, valu9 = 0.0;
+    double valu10 = 0.0, valu11 = 0.0, valu12 = 0.0, valu13 = 0.0;
+    double aaa1 = 0.0, aaa2 = 0.0;
+    std::array<double, 30> bcars{}, ccars{}, dcars{};
+    std::array<double, 20> fbe{}, fbed{}, fke{}, fked{};
+  };
+
+  // One row of the Z matrix: the conductor of GUTS44 (X, Y, R, TB2, GMD,
+  // DZ, ITB3), and whether it is an earth wire of a segmented case, which
+  // has no mutual coupling (IZERO = 0).
+  struct LineConductor {
+    double x = 0.0;
+    double y = 0.0;
+    double r = 0.0;
+    double tb2 = 0.0;
+    double gmd = 0.0;
+    double dz = 0.0;
+    int itb3 = 0;
+    bool segmented = false;
+  };
+
+  // All the Z matrix of a frequency depends on: the conductors in the
+  // order of its rows, the logarithms of the image distances of the P
+  // matrix (lower triangle by rows as on LUNT13, 0 on the diagonal), earth
+  // resistivity and Carson accuracy.
+  struct LineGeometry {
+    std::vector<LineConductor> rows;
+    std::vector<double> logp;
+    double rearth = 0.0;
+    double corr = 0.0;
+    CarsonTables tables;
+
+    bool operator==(const LineGeometry& o) const {
+      if (rows.size() != o.rows.size() || logp != o.logp || rearth != o.rearth
+          || corr != o.corr || std::memcmp(&tables, &o.tables, sizeof(tables)) != 0)
+        return false;
+      for (std::size_t k = 0; k < rows.size(); ++k) {
+        const LineConductor& a = rows[k];
+        const LineConductor& b = o.rows[k];
+        if (a.x != b.x || a.y != b.y || a.r != b.r || a.tb2 != b.tb2 || a.gmd != b.gmd
+            || a.dz != b.dz || a.itb3 != b.itb3 || a.segmented != b.segmented)
+          return false;
+      }
+      return true;
+    }
+    bool operator!=(const LineGeometry& o) const { return !(*this == o); }
+  };
+
+  // What SKIN would have printed for a row: the warning of an unreliable
+  // result, and the Kelvin-function terms of IPRSUP >= 1.
+  struct SkinTrace {
+    bool unreliable = false;
+    double q2 = 0.0, r2 = 0.0;
+    bool kelvin = false;
+    double e = 0.0, f = 0.0, e2f2 = 0.0, s2 = 0.0;
+  };
+
+  // Z at one frequency: R and X (P and Z of GUTS44, lower triangle by
+  // rows), the last term of the Carson series at each entry (I5, -1 if no
+  // series was summed there), and the skin effect of each row.
+  struct LineZ {
+    double freq = 0.0;
+    std::vector<double> r, x;
+    std::vector<int> terms;
+    std::vector<SkinTrace> skin;
+  };
+
+  namespace line_constants {
+
+    // Kelvin functions of  x  (X2 = X**2 / 64) for SKIN, by the series
+    // for arguments up to 8 and the asymptotic one beyond; IBACK = 2 for
+    // the outer radius of a tubular conductor
+    struct Kelvin {
+      double ber = 0.0, bei = 0.0, berd = 0.0, beid = 0.0;
+      double ger = 0.0, gei = 0.0, gerd = 0.0, geid = 0.0;
+    };
+    inline Kelvin kelvin(const CarsonTables& t, double s, double x, double x2,
+      int iback, double qremb) {
+      Kelvin k;
+      double z = 0.0;
+      double xl = 0.0;
+      if (x2 <= t.unity) {
+        z = x2;
+        k.ber = t.unity;
+        k.bei = 0.0f;
+        k.berd = 0.0f;
+        k.beid = t.onehaf;
+        k.gerd = 0.0f;
+        k.geid = t.valu9;
+        k.ger = -t.valu10;
+        k.gei = 0.0f;
+        int ialt = 1;
+        for (int i = 1; i <= 14; ++i) {
+          if (ialt == 1) {
+            k.bei += t.fbe[i - 1] * z;
+            k.berd += t.fbed[i - 1] * z;
+            if (!(s < t.tenm6)) {
+              k.gerd += t.fked[i - 1] * z;
+              if (iback != 2)
+                k.gei += t.fke[i - 1] * z;
+            }
+          }
+          else {
+            k.ber += t.fbe[i - 1] * z;
+            k.beid += t.fbed[i - 1] * z;
+            if (!(s < t.tenm6)) {
+              k.geid += t.fked[i - 1] * z;
+              if (iback != 2)
+                k.ger += t.fke[i - 1] * z;
+            }
+          }
+          z = z * x2;
+          ialt = -ialt;
+        }
+        k.beid = k.beid * x;
+        k.berd = k.berd * x;
+        if (!(s < t.tenm6)) {
+          xl = std::log(x * t.onehaf);
+          k.gerd = -xl * k.berd - k.ber / x + k.beid * t.aaa1 + x * k.gerd;
+          k.geid = -xl * k.beid - k.bei / x - k.berd * t.aaa1 + x * k.geid;
+          if (iback != 2) {
+            k.ger += -xl * k.ber + k.bei * t.aaa1;
+            k.gei += -xl * k.bei - k.ber * t.aaa1;
+          }
+        }
+        return k;
+      }
+      x2 = 8.0f / x;
+      z = x2;
+      k.ber = 0.0f;
+      k.bei = -t.valu11;
+      k.berd = k.ber;
+      k.beid = k.bei;
+      k.ger = t.unity / t.sqrt2;
+      k.gei = k.ger;
+      k.gerd = k.ger;
+      k.geid = k.gei;
+      int ialt = 1;
+      double thetar = 0.0, thetai = 0.0, phir = 0.0, phii = 0.0;
+      for (int i = 1; i <= 6; ++i) {
+        thetar = t.fbe[i + 13] * z;
+        thetai = t.fbed[i + 13] * z;
+        phir = t.fke[i + 13] * z;
+        phii = t.fked[i + 13] * z;
+        k.ber += thetar;
+        k.bei += thetai;
+        k.ger += phir;
+        k.gei += phii;
+        if (ialt == 1) {
+          k.berd = k.berd - thetar;
+          k.beid = k.beid - thetai;
+          k.gerd = k.gerd - phir;
+          k.geid = k.geid - phii;
+        }
+        else {
+          k.berd += thetar;
+          k.beid += thetai;
+          k.gerd += phir;
+          k.geid += phii;
+        }
+        ialt = -ialt;
+        z = z * x2;
+      }
+      xl = x * t.sqrt2;
+      if (!(qremb < 1.0f))
+        xl = xl - qremb;
+      thetar = -xl + k.berd;
+      thetai = -xl + k.beid;
+      z = std::sqrt(x);
+      x2 = t.valu12 / z;
+      z = t.valu13 / z * std::exp(thetar);
+      double const fr = z * std::cos(thetai);
+      double const fi = z * std::sin(thetai);
+      x2 = x2 * std::exp(k.ber);
+      thetar = x2 * std::cos(k.bei);
+      thetai = x2 * std::sin(k.bei);
+      z = -fr * k.gerd + fi * k.geid;
+      k.geid = -fr * k.geid - fi * k.gerd;
+      k.gerd = z;
+      z = t.aaa2 * std::exp(-qremb);
+      double const gr = z * std::sin(qremb);
+      double const gi = z * std::cos(qremb);
+      k.berd = thetar * k.ger - thetai * k.gei + k.gerd * gr - k.geid * gi;
+      k.beid = thetar * k.gei + thetai * k.ger + k.gerd * gi + k.geid * gr;
+      k.ger = fr;
+      k.gei = fi;
+      k.ber = thetar + k.ger * gr - k.gei * gi;
+      k.bei = thetai + k.ger * gi + k.gei * gr;
+      return k;
+    }
+
+    // SKIN: resistance  rf  and internal reactance  xf  at  freq  of a
+    // tubular conductor of T/D ratio (1 - s) / 2 and d.c. resistance  r
+    inline void skin(const CarsonTables& t, double s, double r, double freq,
+      double& rf, double& xf, SkinTrace& trace) {
+      double s2 = s * s;
+      double const s3 = (t.unity - s2) * r;
+      double const r2 = freq * t.valu8 / s3;
+      rf = r;
+      xf = 0.f;
+      if (r2 == 0.f)
+        return;
+      double qremb = 0.0f;
+      double a = 0.0, b = 0.0, aremb = 0.0, bremb = 0.0;
+      double x = 0.0, x2 = 0.0;
+      if (!(s < t.tenm6)) {
+        double const q2 = r2 * s2;
+        if (!(s2 < 0.8f) && q2 <= 64.0f && r2 > 64.0f) {
+          trace.unreliable = true;
+          trace.q2 = q2;
+          trace.r2 = r2;
+        }
+        if (q2 > 64.0f)
+          qremb = std::sqrt(q2) * t.sqrt2;
+        x = std::sqrt(q2);
+        x2 = x * x / 64.0f;
+        Kelvin const k = kelvin(t, s, x, x2, 2, qremb);
+        a = -k.berd;
+        b = -k.beid;
+        aremb = k.gerd;
+        bremb = k.geid;
+      }
+      x = std::sqrt(r2);
+      x2 = x * x / 64.0f;
+      Kelvin const k = kelvin(t, s, x, x2, 1, qremb);
+      double g = k.ber;
+      double h = k.bei;
+      double e = k.berd;
+      double f = k.beid;
+      if (!(s < t.tenm6)) {
+        g = a * k.ger - b * k.gei + aremb * k.ber - bremb * k.bei;
+        h = a * k.gei + b * k.ger + aremb * k.bei + bremb * k.ber;
+        e = a * k.gerd - b * k.geid + aremb * k.berd - bremb * k.beid;
+        f = a * k.geid + b * k.gerd + aremb * k.beid + bremb * k.berd;
+      }
+      double const e2f2 = e * e + f * f;
+      s2 = x * s3 * t.onehaf / e2f2;
+      trace.kelvin = true;
+      trace.e = e;
+      trace.f = f;
+      trace.e2f2 = e2f2;
+      trace.s2 = s2;
+      rf = (-h * e + g * f) * s2;
+      xf = (g * e + h * f) * s2;
+    }
+
+    // Carson correction of a mutual impedance, Z = S * F1 up to 5; the
+    // image is DX across and H2 below
+    inline void carson_mutual(const CarsonTables& t, int imax, double corr,
+      double z1, double s, double dx, double h2, double& rm, double& xm, int& i5) {
+      if (z1 > 5.0f) {
+        s = s * z1;
+        double sn = dx / s;
+        double cs = h2 / s;
+        double const s2 = sn * cs * 2.0f;
+        double const c2 = cs * cs - sn * sn;
+        rm = -c2;
+        for (i5 = 1; i5 <= 7; i5 += 2) {
+          rm += t.ccars[i5 - 1] * cs;
+          xm += t.dcars[i5 - 1] * cs;
+          double const h1 = cs * s2 + sn * c2;
+          cs = cs * c2 - sn * s2;
+          sn = h1;
+        }
+        return;
+      }
+      rm = t.twopi / 16.f;
+      double const zl = std::log(z1);
+      xm += (t.valu4 - zl) * t.onehaf;
+      if (imax == 0)
+        return;
+      double const s1 = dx / s;
+      double const c1 = h2 / s;
+      double cs = c1 * z1;
+      double sn = s1 * z1;
+      double phi = 0.0;
+      if (imax > 1)
+        phi = std::asin(s1);
+      double error = 0.f;
+      for (int m5 = 0; ; ++m5) {
+        i5 = m5 * 4;
+        for (int k5 = 1; k5 <= 4; ++k5) {
+          ++i5;
+          double deltap, deltaq;
+          if (k5 == 1 || k5 == 3) {
+            deltaq = t.bcars[i5 - 1] * cs;
+            deltap = deltaq;
+            if (k5 == 1)
+              deltap = -deltap;
+          }
+          else {
+            deltap = ((t.ccars[i5 - 1] - zl) * cs + phi * sn) * t.bcars[i5 - 1];
+            double const h1 = -t.dcars[i5 - 1] * cs;
+            if (k5 == 4) {
+              deltaq = -deltap;
+              deltap = h1;
+            }
+            else
+              deltaq = h1;
+          }
+          rm += deltap;
+          xm += deltaq;
+          if (i5 == imax)
+            return;
+          if (!(corr > t.corchk)) {
+            if (std::abs(deltap) < corr && std::abs(deltaq) < corr) {
+              if (error > t.onehaf)
+                return;
+              error = t.unity;
+            }
+            else
+              error = 0.f;
+          }
+          double const h1 = sn * c1 + cs * s1;
+          cs = (cs * c1 - sn * s1) * z1;
+          sn = h1 * z1;
+        }
+      }
+    }
+
+    // the same for a self impedance, Z = 2 Y * F1
+    inline void carson_self(const CarsonTables& t, int imax, double corr,
+      double z1, double& r1, double& xs, int& i5) {
+      if (z1 > 5.0f) {
+        double cs = t.unity / z1;
+        double const c2 = cs * cs;
+        r1 = r1 - c2;
+        for (i5 = 1; i5 <= 7; i5 += 2) {
+          r1 += t.ccars[i5 - 1] * cs;
+          xs += t.dcars[i5 - 1] * cs;
+          cs = cs * c2;
+        }
+        return;
+      }
+      r1 += t.twopi / 16.f;
+      double const zl = std::log(z1);
+      xs += (t.valu4 - zl) * t.onehaf;
+      if (imax == 0)
+        return;
+      double cs = z1;
+      double error = 0.f;
+      for (int m5 = 0; ; ++m5) {
+        i5 = m5 * 4;
+        for (int k5 = 1; k5 <= 4; ++k5) {
+          ++i5;
+          double deltap, deltaq;
+          if (k5 == 1 || k5 == 3) {
+            deltaq = t.bcars[i5 - 1] * cs;
+            deltap = deltaq;
+            if (k5 == 1)
+              deltap = -deltap;
+          }
+          else {
+            deltap = (t.ccars[i5 - 1] - zl) * t.bcars[i5 - 1] * cs;
+            double const h1 = -t.dcars[i5 - 1] * cs;
+            if (k5 == 4) {
+              deltaq = -deltap;
+              deltap = h1;
+            }
+            else
+              deltaq = h1;
+          }
+          r1 += deltap;
+          xs += deltaq;
+          if (i5 == imax)
+            return;
+          if (!(corr > t.corchk)) {
+            if (std::abs(deltap) < corr && std::abs(deltaq) < corr) {
+              if (error > t.onehaf)
+                return;
+              error = t.unity;
+            }
+            else
+              error = 0.f;
+          }
+          cs = cs * z1;
+        }
+      }
+    }
+
+  }
+
+  // The Z matrix of GUTS44 at  freq  ("FORMATION OF Z-MATRIX", statements
+  // 100 to 200): each row its skin effect and internal reactance, each
+  // entry Carson's correction for the earth return. It reads nothing but
+  // its arguments, so the frequencies of a sweep can be evaluated on any
+  // thread and give the same matrices as one after the other.
+  inline void line_z(const LineGeometry& g, double freq, LineZ& out) {
+    const CarsonTables& t = g.tables;
+    std::size_t const kfull = g.rows.size();
+    std::size_t const n = kfull * (kfull + 1) / 2;
+    out.freq = freq;
+    out.r.assign(n, 0.0);
+    out.x.assign(n, 0.0);
+    out.terms.assign(n, -1);
+    out.skin.assign(kfull, SkinTrace());
+    double const omega = t.twopi * freq;
+    double f1 = 0.0;
+    if (g.rearth != 0.f)
+      f1 = t.valu2 * std::sqrt(freq / g.rearth);
+    double const f2 = omega * t.valu3;
+    int imax = 30;
+    if (g.corr == 0.f || g.rearth == 0.f)
+      imax = -1;
+    if (g.corr > t.corchk)
+      imax = int(g.corr - t.onehaf);
+    if (imax > 31)
+      imax = 30;
+    std::size_t ip = 0;
+    for (std::size_t k = 0; k < kfull; ++k) {
+      const LineConductor& c = g.rows[k];
+      double const x1 = c.x;
+      double const y1 = c.y;
+      double r1 = c.r;
+      double h1 = c.tb2;
+      double const h2 = t.unity - 2.0f * h1;
+      if (h1 > 0.f)
+        line_constants::skin(t, h2, r1, freq, r1, h1, out.skin[k]);
+      double g1 = c.gmd;
+      int const ix = c.itb3;
+      double xm = 0.f;
+      double xs = 0.0;
+      if (ix < 2) {
+        xs = g1 / f2;
+        if (ix == 1)
+          xs = xs * freq / 60.0f;
+        xs += std::log(y1 * 2.0f) * t.onehaf;
+        g1 = 24.0f * y1 / std::exp(2.0f * xs);
+      }
+      else {
+        if (ix == 3)
+          g1 = g1 * c.dz / 2.0f;
+        xs = std::log(24.0f * y1 / g1) * t.onehaf;
+      }
+      if (ix == 4)
+        xs += h1 / f2 - t.onehaf * std::log(c.dz * t.onehaf / g1);
+      for (std::size_t i = 0; i < k; ++i, ++ip) {
+        double rm = 0.f;
+        if (!c.segmented) {
+          xm = g.logp[ip] / 4.0f;
+          if (imax >= 0) {
+            double const dx = std::abs(g.rows[i].x - x1);
+            double const h2i = g.rows[i].y + y1;
+            double const s = std::sqrt(h2i * h2i + dx * dx);
+            int i5 = -1;
+            line_constants::carson_mutual(t, imax, g.corr, s * f1, s, dx, h2i, rm, xm, i5);
+            out.terms[ip] = i5;
+          }
+        }
+        out.r[ip] = rm * f2;
+        out.x[ip] = xm * f2;
+      }
+      if (imax >= 0) {
+        r1 = r1 / f2;
+        int i5 = -1;
+        line_constants::carson_self(t, imax, g.corr, y1 * f1 * 2.0f, r1, xs, i5);
+        out.terms[ip] = i5;
+        r1 = r1 * f2;
+      }
+      out.x[ip] = xs * f2;
+      out.r[ip] = r1;
+      ++ip;
+    }
+  }
+
+  // What GUTS44 does with a frequency of a sweep besides its Z matrix, in
+  // the configurations which LINE_FREQUENCY44 takes over: the geometry
+  // (without LOGP, which it forms with P), IC of the earth wires and
+  // bundles, the print flags of the frequency card and the dimensions of
+  // MODAL.
+  struct LineCase {
+    LineGeometry geometry;
+    std::vector<int> ic;            // IC(1 : KFULL - KCIRCT)
+    std::array<int, 17> jprmat{};
+    int j2out = 0, j5out = 0, j6out = 0, j8out = 0, j9out = 0;
+    int jspecl = 0, iw = 0, metrik = 0, imodal = 0, itrnsf = 0;
+    int kcirct = 0, kfull = 0, ndim = 0, ntri = 0, nsqr2 = 0;
+    double fmipkm = 0.0, dist = 0.0, conduc = 0.0;
+
+    bool operator==(const LineCase& o) const {
+      return geometry == o.geometry && ic == o.ic && jprmat == o.jprmat
+        && j2out == o.j2out && j5out == o.j5out && j6out == o.j6out
+        && j8out == o.j8out && j9out == o.j9out && jspecl == o.jspecl
+        && iw == o.iw && metrik == o.metrik && imodal == o.imodal
+        && itrnsf == o.itrnsf && kcirct == o.kcirct && kfull == o.kfull
+        && ndim == o.ndim && ntri == o.ntri && nsqr2 == o.nsqr2
+        && fmipkm == o.fmipkm && dist == o.dist && conduc == o.conduc;
+    }
+  };
+
+  // A frequency of the sweep done by LINE_FREQUENCY44: what it wrote on
+  // LUNIT6, on unit 6, on the punch (LUNIT7) with the cards of the case to
+  // go at  cards_at , and on the .out2 stream; whether it called MODAL,
+  // and T of COMINV then. Not  clean  if a KILL was raised, for GUTS44 to
+  // do the frequency itself.
+  struct LineFrequency {
+    double freq = 0.0;
+    bool clean = false;
+    std::string log, screen, punch, out2;
+    std::size_t cards_at = 0;
+    int cards = -1;                 // N5 of MODAL, 0: up to a blank card
+    bool modal = false;
+    double t = 0.0;
+  };
+
+  // The frequencies of a logarithmic sweep (IK decades of IPS points),
+  // evaluated a window at a time on the step threads before GUTS44 asks
+  // for the first of them: all of a frequency by frequency(), or only its
+  // Z matrix by z() in the configurations LINE_FREQUENCY44 does not take.
+  // GUTS44 writes out what they printed in its own loop, so the output is
+  // in frequency order whatever the number of threads. A frequency outside
+  // the sweep, or a geometry which has changed, is evaluated on the spot;
+  // so are the first and the last frequency of the sweep, which GUTS44
+  // always does itself.
+  class LineSweep {
+  public:
+    static constexpr std::size_t window = 256;
+
+    void pool(StepPool* p) { pool_ = p; }
+    int threads() const { return pool_ ? pool_->size() : 1; }
+
+    // the frequencies of the sweep from  freq , in the order of GUTS44:
+    // FDECAD * EXP(KKK * FACTOR), KKK = 0 (first decade only), ..., IPS
+    void plan(double freq, double factor, int ik, int ips) {
+      planned_.clear();
+      first_ = last_ = 0;
+      ffirst_ = flast_ = 0;
+      double fdecad = freq;
+      for (int iii = 0; iii < ik; ++iii) {
+        for (int kkk = iii == 0 ? 0 : 1; kkk <= ips; ++kkk) {
+          double const pkkk = kkk;
+          planned_.push_back(fdecad * std::exp(pkkk * factor));
+        }
+        fdecad = fdecad * 10.0f;
+      }
+      next_ = 0;
+    }
+
+    // Z of  g  at  freq
+    const LineZ& z(const LineGeometry& g, double freq) {
+      auto const t0 = std::chrono::steady_clock::now();
+      if (g != geometry_) {
+        geometry_ = g;
+        first_ = last_ = 0;
+      }
+      std::size_t const at = find(freq);
+      const LineZ* result = &scratch_;
+      if (at > 0 && at < planned_.size()) {
+        if (at < first_ || at >= last_)
+          evaluate(at);
+        result = &done_[at - first_];
+      }
+      else {
+        line_z(geometry_, freq, scratch_);
+        ++matrices_;
+      }
+      std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+      seconds_ += dt.count();
+      return *result;
+    }
+
+    // frequency  freq  of case  c , by  fn(thread, freq, result)  on the
+    // step threads; 0 if  freq  is not one of the sweep or is its last.
+    // What a thread throws is thrown here.
+    template<class Evaluate>
+    const LineFrequency* frequency(const LineCase& c, double freq, Evaluate fn) {
+      std::size_t const at = find(freq);
+      if (at + 1 >= planned_.size())
+        return nullptr;
+      auto const t0 = std::chrono::steady_clock::now();
+      if (!(c == case_)) {
+        case_ = c;
+        ffirst_ = flast_ = 0;
+      }
+      if (at < ffirst_ || at >= flast_)
+        run(at, fn);
+      std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+      seconds_ += dt.count();
+      return &frequencies_[at - ffirst_];
+    }
+
+    // Z matrices and frequencies evaluated so far, and the seconds GUTS44
+    // waited for them
+    std::int64_t matrices() const { return matrices_; }
+    std::int64_t frequencies() const { return frequencies_done_; }
+    double seconds() const { return seconds_; }
+    // the frequencies of the last sweep, and the last geometry
+    const std::vector<double>& planned() const { return planned_; }
+    const LineGeometry& geometry() const { return geometry_; }
+
+  private:
+    // index of  freq  in  planned_ , its size if none
+    std::size_t find(double freq) {
+      for (std::size_t n = 0; n < planned_.size(); ++n) {
+        std::size_t const i = (next_ + n) % planned_.size();
+        if (planned_[i] == freq) {
+          next_ = i + 1;
+          return i;
+        }
+      }
+      return planned_.size();
+    }
+    // the window of  planned_  from  at , frequency  c, c + n, ...  on
+    // step thread  c  of  n
+    void evaluate(std::size_t at) {
+      first_ = at;
+      last_ = std::min(at + window, planned_.size());
+      done_.resize(last_ - first_);
+      std::size_t const nthread = std::size_t(threads());
+      auto chunk = [&](int c) {
+        for (std::size_t i = first_ + std::size_t(c); i < last_; i += nthread)
+          line_z(geometry_, planned_[i], done_[i - first_]);
+      };
+      if (pool_)
+        pool_->run(chunk);
+      else
+        chunk(0);
+      matrices_ += std::int64_t(last_ - first_);
+    }
+    // the same for whole frequencies, up to the last but one
+    template<class Evaluate>
+    void run(std::size_t at, Evaluate& fn) {
+      ffirst_ = at;
+      flast_ = std::min(at + window, planned_.size() - 1);
+      frequencies_.resize(flast_ - ffirst_);
+      std::size_t const nthread = std::size_t(threads());
+      std::vector<std::exception_ptr> thrown(nthread);
+      auto chunk = [&](int c) {
+        try {
+          for (std::size_t i = ffirst_ + std::size_t(c); i < flast_; i += nthread)
+            fn(c, planned_[i], frequencies_[i - ffirst_]);
+        }
+        catch (...) {
+          thrown[std::size_t(c)] = std::current_exception();
+        }
+      };
+      if (pool_)
+        pool_->run(chunk);
+      else
+        chunk(0);
+      for (auto const& e : thrown) {
+        if (e) {
+          ffirst_ = flast_ = 0;
+          std::rethrow_exception(e);
+        }
+      }
+      frequencies_done_ += std::int64_t(flast_ - ffirst_);
+    }
+
+    StepPool* pool_ = nullptr;
+    std::vector<double> planned_;
+    std::size_t next_ = 0;             // where to look first for a frequency
+    LineGeometry geometry_;
+    std::vector<LineZ> done_;          // planned_[first_ : last_ - 1]
+    std::size_t first_ = 0, last_ = 0;
+    LineZ scratch_;
+    LineCase case_;
+    std::vector<LineFrequency> frequencies_;  // planned_[ffirst_ : flast_ - 1]
+    std::size_t ffirst_ = 0, flast_ = 0;
+    std::int64_t matrices_ = 0;
+    std::int64_t frequencies_done_ = 0;
+    double seconds_ = 0.0;
+  };
+
+}
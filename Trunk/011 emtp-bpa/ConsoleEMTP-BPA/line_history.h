@@ -0,0 +1,438 @@
+/***********************************
+EMTP C++
+History of the constant-parameter distributed lines of SUBTS2 in rings per
+travel time, all lines of one travel time updated side by side each step.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "step_pipeline.h"
+
+namespace emtp {
+
+  // SUBTS2 keeps the history of a mode of travel time N3 steps in cells
+  // II, ..., II + N3 + 1 of XK / XM, shifted by IPOINT every step: it
+  // reads the far-end values at the start of that window, combines the
+  // new terminal voltages with the cell N3 and writes cell N3 + 1. The
+  // windows of all lines follow one another, so each line costs a few
+  // scattered reads and writes, and all the index arithmetic, per step.
+  //
+  // Here the modes of equal N3 share one ring of N3 + 2 rows, each row
+  // holding one cell of every mode side by side. A step then reads and
+  // writes whole rows, four modes per SIMD step, to the same bits as the
+  // FORTRAN code. The lines are found during one ordinary step (record()),
+  // and their history is taken from XK / XM at its end; when SUBTS2 has to
+  // run the FORTRAN code again, the rings go back into XK / XM (flush).
+  // The node currents are still added to F by SUBTS2 in branch order.
+  //
+  // With a StepPool of several threads, a step of many modes is split
+  // into chunks of consecutive lines; the lanes of a chunk are consecutive
+  // in every ring too, so each chunk updates its own lines from end to end.
+  class LineHistory {
+  public:
+    // threads for the steps of the next compile() (nullptr: this one)
+    void pool(StepPool* p) { pool_ = p; }
+
+    bool active() const { return state_ == State::active; }
+    bool recording() const { return state_ == State::recording; }
+    // new initial conditions in XK / XM: forget the rings
+    void invalidate() { state_ = State::idle; }
+
+    // top of SUBTS2: if the rings may not be used this step (allowed
+    // false) they go back into XK / XM; otherwise a step with the rings
+    // updates all histories for the node voltages  e , or a first step
+    // records the lines
+    template<typename D>
+    void begin(bool allowed, double t, int ipoint, int lpast, double unity,
+      const D& e, D& xk, D& xm) {
+      if (state_ != State::idle && t < last_t_) {
+        state_ = State::idle;  // a new time loop, with new XK / XM
+      }
+      last_t_ = t;
+      if (!allowed) {
+        if (state_ == State::active) {
+          shift(ipoint, lpast);
+          flush(ipoint, lpast, xk, xm);
+        }
+        state_ = State::idle;
+        return;
+      }
+      if (state_ != State::active) {
+        groups_.clear();
+        classes_.clear();
+        group_of_.clear();
+        state_ = State::recording;
+        return;
+      }
+      shift(ipoint, lpast);
+      auto const t0 = std::chrono::steady_clock::now();
+      step(e, unity);
+      ns_ += std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - t0).count();
+      ++steps_;
+    }
+
+    // recording step, at the line (or first phase of the line) in branch
+    // K of  it2  phases whose first window starts at cell  ii : kept if it
+    // takes the plain constant-parameter update of every mode
+    template<typename I, typename D>
+    void record(int k, int it2, int ii, const I& kbus, const I& mbus,
+      const I& imodel, const I& nr, const I& litype, const D& cik,
+      const D& ci, const D& ck, const D& qfd) {
+      for (int m = k; m < k + it2; ++m) {
+        if (kbus(m) >= 0 || mbus(m) <= 0 || imodel(m) == -2 || nr(m) < 0
+            || ck(m) < 0.0) {
+          return;
+        }
+      }
+      Group g;
+      g.k = k;
+      g.it2 = it2;
+      g.gus1 = it2;
+      for (int m = 0; m < it2 * it2; ++m)
+        g.q.push_back(qfd(litype(k) + m));
+      for (int m = k; m < k + it2; ++m) {
+        g.n1.push_back(-kbus(m));
+        g.n2.push_back(mbus(m));
+        Mode md;
+        md.ii = ii;
+        md.n3 = nr(m);
+        md.a = cik(m);
+        md.gus2 = ci(m);
+        md.h2 = std::abs(ck(m));
+        g.modes.push_back(md);
+        ii += md.n3 + 2;
+      }
+      groups_.push_back(std::move(g));
+    }
+
+    // end of the recording step: the rings take the history from XK / XM
+    template<typename D>
+    void compile(int ipoint, int lpast, const D& xk, const D& xm) {
+      if (state_ != State::recording) {
+        return;
+      }
+      std::map<int, int> index;  // N3 -> ring
+      for (Group& g : groups_) {
+        for (Mode& md : g.modes) {
+          auto const it = index.emplace(md.n3, int(index.size())).first;
+          if (it->second == int(classes_.size())) {
+            classes_.emplace_back();
+            classes_.back().n3 = md.n3;
+          }
+          md.ring = it->second;
+          md.lane = int(classes_[md.ring].ii.size());
+          classes_[md.ring].ii.push_back(md.ii);
+        }
+      }
+      for (Ring& r : classes_) {
+        std::size_t const n = r.ii.size();
+        r.rows = r.n3 + 2;
+        r.np = (n + lanes - 1) / lanes * lanes;
+        r.head = 0;
+        for (auto* v : { &r.a, &r.d2, &r.h1, &r.h2, &r.loss, &r.vi, &r.vk, &r.hk, &r.hm })
+          v->assign(r.np, 0.0);
+        r.k.assign(std::size_t(r.rows) * r.np, 0.0);
+        r.m.assign(std::size_t(r.rows) * r.np, 0.0);
+      }
+      std::size_t out = 0;
+      for (Group& g : groups_) {
+        g.out = out;
+        out += 2 * std::size_t(g.it2);
+        for (Mode const& md : g.modes) {
+          Ring& r = classes_[md.ring];
+          std::size_t const j = md.lane;
+          r.a[j] = md.a;
+          r.d2[j] = 1.0 - md.a;
+          r.h1[j] = std::abs(md.gus2);
+          r.h2[j] = md.h2;
+          r.loss[j] = md.gus2 < 0.0 ? 0.0 : 1.0;
+          for (int c = 0; c <= md.n3 + 1; ++c) {
+            int const p = at(md.ii, ipoint, c, lpast);
+            r.k[std::size_t(c) * r.np + j] = xk(p);
+            r.m[std::size_t(c) * r.np + j] = xm(p);
+          }
+        }
+        if (int(group_of_.size()) <= g.k) {
+          group_of_.resize(g.k + 1, -1);
+        }
+        group_of_[g.k] = int(&g - groups_.data());
+      }
+      inject_.assign(out, 0.0);
+      partition();
+      last_ipoint_ = ipoint;
+      state_ = groups_.empty() ? State::idle : State::active;
+      modes_ = 0;
+      for (Ring const& r : classes_)
+        modes_ += r.ii.size();
+    }
+
+    // the windows of the last step into XK / XM as the FORTRAN code leaves
+    // them, for a snapshot of the time loop; the rings stay in use
+    template<typename D>
+    void store(int lpast, D& xk, D& xm) {
+      for (Group& g : groups_) {
+        for (Mode const& md : g.modes) {
+          Ring& r = classes_[md.ring];
+          for (int c = 0; c <= md.n3 + 1; ++c) {
+            int const p = at(md.ii, last_ipoint_, c, lpast);
+            xk(p) = r.row(r.k, c)[md.lane];
+            xm(p) = r.row(r.m, c)[md.lane];
+          }
+        }
+      }
+    }
+
+    // active: the line at branch  k  (-1: none), its phases, and the
+    // currents the step left for the nodes of phase  p
+    int group(int k) const {
+      return k < int(group_of_.size()) ? group_of_[k] : -1;
+    }
+    int phases(int g) const { return groups_[g].it2; }
+    int node_k(int g, int p) const { return groups_[g].n1[p]; }
+    int node_m(int g, int p) const { return groups_[g].n2[p]; }
+    double current_k(int g, int p) const { return inject_[groups_[g].out + 2 * p]; }
+    double current_m(int g, int p) const { return inject_[groups_[g].out + 2 * p + 1]; }
+
+    std::size_t modes() const { return modes_; }
+    std::size_t rings() const { return classes_.size(); }
+    std::size_t chunks() const { return chunks_.size(); }
+    std::int64_t steps() const { return steps_; }
+    double ns_per_mode_step() const {
+      return steps_ > 0 && modes_ > 0 ? ns_ / (double(steps_) * modes_) : 0.0;
+    }
+
+  private:
+    static constexpr std::size_t lanes = 4;
+    // modes of a chunk for one thread, at the least
+    static constexpr std::size_t chunk_modes = 512;
+    enum class State { idle, recording, active };
+
+    struct Mode {
+      int ii = 0;
+      int n3 = 0;
+      double a = 0.0;
+      double gus2 = 0.0;
+      double h2 = 0.0;
+      int ring = 0;
+      int lane = 0;
+    };
+    struct Group {
+      int k = 0;
+      int it2 = 0;
+      double gus1 = 0.0;
+      std::vector<double> q;  // QFD(LITYPE(K) ...), IT2 x IT2
+      std::vector<int> n1, n2;
+      std::vector<Mode> modes;
+      std::size_t out = 0;
+    };
+    // modes of one travel time: cell C of the window of lane J in row
+    // (HEAD + C) mod ROWS, at K / M [row * NP + J]
+    struct Ring {
+      int n3 = 0;
+      int rows = 0;
+      int head = 0;
+      std::size_t np = 0;
+      std::vector<int> ii;
+      std::vector<double> a, d2, h1, h2, loss, vi, vk, hk, hm;
+      std::vector<double> k, m;
+      double* row(std::vector<double>& v, int c) {
+        return v.data() + std::size_t((head + c) % rows) * np;
+      }
+    };
+
+    // lines  g0 <= g < g1 , with lanes  lo[r] <= j < hi[r]  of ring r
+    struct Chunk {
+      int g0 = 0;
+      int g1 = 0;
+      std::vector<std::size_t> lo, hi;
+    };
+
+    // cell  c  of the window starting at  ii  for IPOINT  ipoint
+    static int at(int ii, int ipoint, int c, int lpast) {
+      return (ii + ipoint + c - 1) % lpast + 1;
+    }
+    // IPOINT has moved on since the rings were last lined up with it
+    void shift(int ipoint, int lpast) {
+      int const d = ((ipoint - last_ipoint_) % lpast + lpast) % lpast;
+      last_ipoint_ = ipoint;
+      if (d == 0) {
+        return;
+      }
+      for (Ring& r : classes_)
+        r.head = (r.head + d) % r.rows;
+    }
+    template<typename D>
+    void flush(int ipoint, int lpast, D& xk, D& xm) {
+      for (Group& g : groups_) {
+        for (Mode const& md : g.modes) {
+          Ring& r = classes_[md.ring];
+          for (int c = 0; c <= md.n3; ++c) {
+            int const p = at(md.ii, ipoint, c, lpast);
+            xk(p) = r.row(r.k, c)[md.lane];
+            xm(p) = r.row(r.m, c)[md.lane];
+          }
+        }
+      }
+    }
+
+    // consecutive lines of about the same number of modes per thread
+    void partition() {
+      std::size_t modes = 0;
+      for (Group const& g : groups_)
+        modes += g.modes.size();
+      std::size_t n = pool_ ? std::size_t(pool_->size()) : 1;
+      n = std::max<std::size_t>(std::min(n, modes / chunk_modes), 1);
+      chunks_.assign(n, Chunk());
+      std::vector<std::size_t> lane(classes_.size(), 0);
+      std::size_t done = 0;
+      int g = 0;
+      for (std::size_t c = 0; c < n; ++c) {
+        Chunk& ch = chunks_[c];
+        ch.g0 = g;
+        ch.lo = lane;
+        std::size_t const end = modes * (c + 1) / n;
+        while (g < int(groups_.size()) && (c + 1 == n || done < end)) {
+          for (Mode const& md : groups_[g].modes)
+            ++lane[md.ring];
+          done += groups_[g].modes.size();
+          ++g;
+        }
+        ch.g1 = g;
+        ch.hi = lane;
+      }
+      for (std::size_t r = 0; r < classes_.size(); ++r)
+        chunks_.back().hi[r] = classes_[r].np;  // and the padding
+    }
+
+    template<typename D>
+    void step(const D& e, double unity) {
+      if (chunks_.size() == 1) {
+        step(chunks_[0], e, unity);
+        return;
+      }
+      pool_->run([&](int c) {
+        if (c < int(chunks_.size()))
+          step(chunks_[c], e, unity);
+      });
+    }
+    template<typename D>
+    void step(const Chunk& ch, const D& e, double unity) {
+      // mode voltages, times the number of phases (loop at 21194)
+      for (int gi = ch.g0; gi < ch.g1; ++gi) {
+        Group& g = groups_[gi];
+        int const n = g.it2;
+        for (int i = 0; i < n; ++i) {
+          double ci1 = 0.0;
+          double ck1 = 0.0;
+          for (int j = 0; j < n; ++j) {
+            double const yx = g.q[std::size_t(i) * n + j];
+            ci1 += yx * e(g.n1[j]);
+            ck1 += yx * e(g.n2[j]);
+          }
+          Mode const& md = g.modes[i];
+          classes_[md.ring].vi[md.lane] = ci1 * g.gus1;
+          classes_[md.ring].vk[md.lane] = ck1 * g.gus1;
+        }
+      }
+      for (std::size_t ri = 0; ri < classes_.size(); ++ri) {
+        Ring& r = classes_[ri];
+        std::size_t const j = ch.lo[ri];
+        std::size_t const n = ch.hi[ri] - j;
+        far_end(r.row(r.k, r.n3) + j, r.row(r.m, r.n3) + j, &r.vi[j], &r.vk[j],
+          &r.h1[j], &r.h2[j], n);
+        interpolate(r.row(r.k, 0) + j, r.row(r.k, 1) + j, r.row(r.m, 0) + j,
+          r.row(r.m, 1) + j, &r.a[j], &r.d2[j], &r.h2[j], &r.loss[j], &r.hk[j],
+          &r.hm[j], n);
+        std::copy(&r.hk[j], &r.hk[j] + n, r.row(r.k, r.n3 + 1) + j);
+        std::copy(&r.hm[j], &r.hm[j] + n, r.row(r.m, r.n3 + 1) + j);
+      }
+      // back to phase quantities (IPHASE = TI * IMODE)
+      for (int gi = ch.g0; gi < ch.g1; ++gi) {
+        Group& g = groups_[gi];
+        int const n = g.it2;
+        for (int j = 0; j < n; ++j) {
+          double h1 = 0.0;
+          double h2 = 0.0;
+          for (int i = 0; i < n; ++i) {
+            Mode const& md = g.modes[i];
+            double const yx = g.q[std::size_t(i) * n + j];
+            h1 += yx * (classes_[md.ring].hk[md.lane] * unity);
+            h2 += yx * (classes_[md.ring].hm[md.lane] * unity);
+          }
+          inject_[g.out + 2 * j] = h1;
+          inject_[g.out + 2 * j + 1] = h2;
+        }
+      }
+    }
+    // XM(N4) = H1 * VOLTI - H2 * XK(N4),  XK(N4) = H1 * VOLTK - H2 * XM(N4)
+    static void far_end(double* __restrict k4, double* __restrict m4,
+      const double* __restrict vi, const double* __restrict vk,
+      const double* __restrict h1, const double* __restrict h2, std::size_t n) {
+      std::size_t j = 0;
+      for (; j + lanes <= n; j += lanes) {
+        for (std::size_t l = j; l < j + lanes; ++l) {
+          double const xk4 = k4[l];
+          double const xm4 = m4[l];
+          m4[l] = h1[l] * vi[l] - h2[l] * xk4;
+          k4[l] = h1[l] * vk[l] - h2[l] * xm4;
+        }
+      }
+      for (; j < n; ++j) {
+        double const xk4 = k4[j];
+        double const xm4 = m4[j];
+        m4[j] = h1[j] * vi[j] - h2[j] * xk4;
+        k4[j] = h1[j] * vk[j] - h2[j] * xm4;
+      }
+    }
+    // values a fraction A of a step before the window start; lossy
+    // modes (CI >= 0) then spread the loss over both ends
+    static void interpolate(const double* k1, const double* k2,
+      const double* m1, const double* m2, const double* __restrict a,
+      const double* __restrict d2, const double* __restrict h2,
+      const double* __restrict loss, double* __restrict hk,
+      double* __restrict hm, std::size_t n) {
+      std::size_t j = 0;
+      for (; j + lanes <= n; j += lanes) {
+        for (std::size_t l = j; l < j + lanes; ++l) {
+          double const x = k1[l] * a[l] + k2[l] * d2[l];
+          double const y = m1[l] * a[l] + m2[l] * d2[l];
+          double const s = x + y;
+          double const u = (x - y) * h2[l];
+          hk[l] = loss[l] != 0.0 ? (s + u) / 2.0 : x;
+          hm[l] = loss[l] != 0.0 ? (s - u) / 2.0 : y;
+        }
+      }
+      for (; j < n; ++j) {
+        double const x = k1[j] * a[j] + k2[j] * d2[j];
+        double const y = m1[j] * a[j] + m2[j] * d2[j];
+        double const s = x + y;
+        double const u = (x - y) * h2[j];
+        hk[j] = loss[j] != 0.0 ? (s + u) / 2.0 : x;
+        hm[j] = loss[j] != 0.0 ? (s - u) / 2.0 : y;
+      }
+    }
+
+    State state_ = State::idle;
+    double last_t_ = 0.0;
+    int last_ipoint_ = 0;
+    std::vector<Group> groups_;
+    std::vector<Ring> classes_;
+    std::vector<int> group_of_;
+    std::vector<double> inject_;
+    std::vector<Chunk> chunks_;
+    StepPool* pool_ = nullptr;
+    std::size_t modes_ = 0;
+    std::int64_t steps_ = 0;
+    double ns_ = 0.0;
+  };
+
+}
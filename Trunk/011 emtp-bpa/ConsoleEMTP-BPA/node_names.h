@@ -0,0 +1,164 @@
+/***********************************
+EMTP C++
+Symbol table of the 6-character names of EMTP lists (BUS, TEXVEC), in
+place of the linear searches of the input overlays.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <fem.hpp>
+
+namespace emtp {
+
+  // The list stays the one of the COMMON blocks, in the order of the EMTP
+  // node numbers; the index maps each name to the first and the last cell
+  // holding it, so both kinds of FORTRAN loops (the first match, which
+  // jumps out, and the last, which runs to the end) get the same cell.
+  // Names are compared as FORTRAN does, with trailing blanks, and packed
+  // into 64 bits for open addressing. The index follows the cells appended
+  // to the list (the only change the input overlays make between
+  // searches); a cell found must still hold the name and the last cell
+  // indexed must be unchanged, or the index is built again. Other changes
+  // to cells already indexed need invalidate().
+  class NameIndex {
+  public:
+    void invalidate() { n_ = 0; entries_.clear(); names_.assign(1, 0); slots_.clear(); }
+
+    // cell of  name  in  list(1 : n) , 0 if none: the first or the last
+    template<typename List>
+    int first(const List& list, int n, fem::str_cref name) {
+      return find(list, n, name, false);
+    }
+    template<typename List>
+    int last(const List& list, int n, fem::str_cref name) {
+      return find(list, n, name, true);
+    }
+
+    // the searches so far, and the times the index was built again
+    std::int64_t searches() const { return searches_; }
+    std::int64_t rebuilds() const { return rebuilds_; }
+
+  private:
+    struct Entry {
+      std::uint64_t key;
+      int first;
+      int last;
+    };
+
+    // the name blank-padded to 8 characters; false if it is longer and
+    // not blank beyond (no cell of 8 characters can hold it). As in the
+    // comparisons of fem, a name ends at its first NUL (the TACS names).
+    static bool pack(fem::str_cref s, std::uint64_t& key) {
+      char b[8];
+      std::memset(b, ' ', 8);
+      char const* const e = s.elems();
+      int len = s.len();
+      for (int i = 0; i < len; ++i) {
+        if (e[i] == '\0') {
+          len = i;
+          break;
+        }
+      }
+      std::memcpy(b, e, std::size_t(len < 8 ? len : 8));
+      for (int i = 8; i < len; ++i) {
+        if (e[i] != ' ')
+          return false;
+      }
+      std::memcpy(&key, b, 8);
+      return true;
+    }
+    std::size_t slot(std::uint64_t key) const {
+      return std::size_t((key * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+    template<typename List>
+    int find(const List& list, int n, fem::str_cref name, bool last) {
+      ++searches_;
+      std::uint64_t key;
+      if (!pack(name, key))
+        return 0;
+      for (int pass = 0; ; ++pass) {
+        sync(list, n, pass > 0);
+        int const i = lookup(key, last);
+        if (i == 0 || list(i) == name || pass > 0)
+          return i;
+      }
+    }
+    int lookup(std::uint64_t key, bool last) const {
+      if (slots_.empty())
+        return 0;
+      std::size_t const mask = slots_.size() - 1;
+      for (std::size_t s = slot(key); ; s = (s + 1) & mask) {
+        int const e = slots_[s];
+        if (e == 0)
+          return 0;
+        if (entries_[e - 1].key == key)
+          return last ? entries_[e - 1].last : entries_[e - 1].first;
+      }
+    }
+
+    // index the cells  n_ + 1 : n  of the list, after building it again if
+    // cells have gone or the last one indexed has changed
+    template<typename List>
+    void sync(const List& list, int n, bool force) {
+      std::uint64_t key = 0;
+      if (force || n < n_ || (n_ > 0 && (!pack(list(n_), key) || key != names_[n_]))) {
+        invalidate();
+        ++rebuilds_;
+      }
+      for (int i = n_ + 1; i <= n; ++i) {
+        if (!pack(list(i), key))
+          key = ~std::uint64_t(0);
+        names_.push_back(key);
+        insert(key, i);
+      }
+      n_ = n > n_ ? n : n_;
+    }
+    void insert(std::uint64_t key, int i) {
+      if (2 * (entries_.size() + 1) > slots_.size())
+        grow();
+      std::size_t const mask = slots_.size() - 1;
+      for (std::size_t s = slot(key); ; s = (s + 1) & mask) {
+        int const e = slots_[s];
+        if (e == 0) {
+          entries_.push_back({ key, i, i });
+          slots_[s] = int(entries_.size());
+          return;
+        }
+        if (entries_[e - 1].key == key) {
+          entries_[e - 1].last = i;
+          return;
+        }
+      }
+    }
+    void grow() {
+      std::size_t size = slots_.empty() ? 1024 : 2 * slots_.size();
+      shift_ = 64;
+      for (std::size_t s = size; s > 1; s >>= 1)
+        --shift_;
+      slots_.assign(size, 0);
+      std::size_t const mask = size - 1;
+      for (std::size_t e = 0; e < entries_.size(); ++e) {
+        std::size_t s = slot(entries_[e].key);
+        while (slots_[s] != 0)
+          s = (s + 1) & mask;
+        slots_[s] = int(e + 1);
+      }
+    }
+
+    int n_ = 0;                        // cells indexed
+    std::vector<std::uint64_t> names_ = std::vector<std::uint64_t>(1);  // their names, from 1
+    std::vector<Entry> entries_;
+    std::vector<int> slots_;           // entry + 1, 0: empty
+    int shift_ = 64;
+    std::int64_t searches_ = 0;
+    std::int64_t rebuilds_ = 0;
+  };
+
+}
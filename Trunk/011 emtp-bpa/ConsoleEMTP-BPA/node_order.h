@@ -0,0 +1,383 @@
+/***********************************
+EMTP C++
+Fill-reducing node ordering of OVER7: approximate minimum degree on the
+quotient graph, optionally within the stages of a nested dissection.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace emtp {
+
+  // NODORD of the floating-point miscellaneous data card (columns 57-64):
+  // 0 the renumbering of OVER7 (Tinney scheme 2), 1 approximate minimum
+  // degree, 2 nested dissection with minimum degree inside its parts
+  enum class NodeOrdering { tinney = 0, min_degree = 1, dissection = 2 };
+
+  // Node graph of a network, in compressed rows: the neighbours of node i
+  // (0-based) are adj[ptr[i]], ..., adj[ptr[i + 1] - 1].
+  struct NodeGraph {
+    int n = 0;
+    std::vector<int> ptr, adj;
+  };
+
+  // Structure of the factor, by rows of the new numbering: the columns to
+  // the right of the diagonal, in increasing order.
+  struct NodeFactor {
+    std::vector<int> ptr, col;
+    std::int64_t terms = 0;  // in the rows of the eliminated nodes
+    std::int64_t fill = 0;   // of which fill-in
+  };
+
+  namespace node_order {
+
+    // Elimination order of the nodes with  stage[i] >= 0 : stage by stage,
+    // and within a stage the node of least approximate degree first. Nodes
+    // with  stage[i] < 0  (known voltages) are never eliminated, but count
+    // in the degrees of their neighbours.
+    //
+    // Quotient graph as in AMD: an eliminated node becomes an element whose
+    // list holds its uneliminated neighbours; a node keeps its neighbouring
+    // nodes A and elements E. Eliminating p merges the elements of p into
+    // one (absorbing them), and a neighbour i gets the degree bound
+    //   |A(i)| + |L(p) \ i| + sum over e in E(i), e != p, of |L(e) \ L(p)|
+    // An element contained in L(p) is absorbed as well.
+    inline std::vector<int> min_degree(const NodeGraph& g, const std::vector<int>& stage) {
+      int const n = g.n;
+      std::vector<std::vector<int>> A(n), E(n), L(n);
+      std::vector<char> var(n, 1), elem(n, 0), listed(n, 0);
+      std::vector<int> deg(n), head(n + 1, -1), next(n, -1), prev(n, -1);
+      std::vector<int> mark(n, 0), wmark(n, 0), w(n, 0);
+      for (int i = 0; i < n; ++i) {
+        A[i].assign(g.adj.begin() + g.ptr[i], g.adj.begin() + g.ptr[i + 1]);
+        deg[i] = int(A[i].size());
+      }
+      std::vector<int> todo;
+      for (int i = 0; i < n; ++i) {
+        if (stage[i] >= 0)
+          todo.push_back(i);
+      }
+      std::stable_sort(todo.begin(), todo.end(),
+        [&](int a, int b) { return stage[a] < stage[b]; });
+      int mindeg = n, nlisted = 0, nalive = n, tag = 0, wtag = 0;
+      auto insert = [&](int i) {
+        int const d = deg[i];
+        prev[i] = -1;
+        next[i] = head[d];
+        if (head[d] >= 0)
+          prev[head[d]] = i;
+        head[d] = i;
+        listed[i] = 1;
+        ++nlisted;
+        mindeg = std::min(mindeg, d);
+      };
+      auto remove = [&](int i) {
+        if (!listed[i])
+          return;
+        if (prev[i] >= 0)
+          next[prev[i]] = next[i];
+        else
+          head[deg[i]] = next[i];
+        if (next[i] >= 0)
+          prev[next[i]] = prev[i];
+        listed[i] = 0;
+        --nlisted;
+      };
+      std::vector<int> order;
+      order.reserve(todo.size());
+      std::size_t t = 0;
+      int current = 0;
+      for (;;) {
+        if (nlisted == 0) {
+          if (t == todo.size())
+            break;
+          current = stage[todo[t]];
+          for (; t < todo.size() && stage[todo[t]] == current; ++t)
+            insert(todo[t]);
+        }
+        while (head[mindeg] < 0)
+          ++mindeg;
+        int const p = head[mindeg];
+        remove(p);
+        // element p: the neighbours of p and of its elements
+        ++tag;
+        mark[p] = tag;
+        auto& Lp = L[p];
+        for (int v : A[p]) {
+          if (var[v] && mark[v] != tag) {
+            mark[v] = tag;
+            Lp.push_back(v);
+          }
+        }
+        for (int e : E[p]) {
+          if (!elem[e])
+            continue;
+          for (int v : L[e]) {
+            if (var[v] && mark[v] != tag) {
+              mark[v] = tag;
+              Lp.push_back(v);
+            }
+          }
+          elem[e] = 0;
+          std::vector<int>().swap(L[e]);
+        }
+        var[p] = 0;
+        elem[p] = 1;
+        --nalive;
+        std::vector<int>().swap(A[p]);
+        std::vector<int>().swap(E[p]);
+        order.push_back(p);
+        // the lists of the neighbours lose p, the absorbed elements and the
+        // nodes now reached through p
+        for (int i : Lp) {
+          auto& Ei = E[i];
+          Ei.erase(std::remove_if(Ei.begin(), Ei.end(),
+            [&](int e) { return !elem[e]; }), Ei.end());
+          Ei.push_back(p);
+          auto& Ai = A[i];
+          Ai.erase(std::remove_if(Ai.begin(), Ai.end(),
+            [&](int v) { return !var[v] || mark[v] == tag; }), Ai.end());
+        }
+        // |L(e) \ L(p)| of the other elements of these nodes
+        ++wtag;
+        for (int i : Lp) {
+          for (int e : E[i]) {
+            if (e == p || !elem[e])
+              continue;
+            if (wmark[e] != wtag) {
+              wmark[e] = wtag;
+              w[e] = int(L[e].size());
+            }
+            --w[e];
+          }
+        }
+        int const lp = int(Lp.size());
+        for (int i : Lp) {
+          if (stage[i] < 0)
+            continue;
+          std::int64_t d = std::int64_t(A[i].size()) + lp - 1;
+          for (int e : E[i]) {
+            if (e == p || !elem[e])
+              continue;
+            if (w[e] == 0)
+              elem[e] = 0;  // L(e) within L(p)
+            else
+              d += w[e];
+          }
+          d = std::min<std::int64_t>(d, std::int64_t(deg[i]) + lp - 1);
+          d = std::min<std::int64_t>(d, nalive - 1);
+          bool const here = listed[i] != 0;
+          remove(i);
+          deg[i] = int(std::max<std::int64_t>(d, 0));
+          if (here)
+            insert(i);
+        }
+      }
+      return order;
+    }
+
+    // Stages of a nested dissection of the nodes with  stage0[i] >= 0 ;
+    // the others keep stage -1. Each connected part larger than  leaf  is
+    // split by a level of a breadth-first search from a pseudo-peripheral
+    // node; the nodes of this separator which touch only one side join
+    // that side. Parts are stage 0, a separator at depth d stage 2^20 - d,
+    // so min_degree() numbers the separators after what they separate.
+    inline std::vector<int> dissection_stages(const NodeGraph& g,
+      const std::vector<int>& stage0, int leaf = 64) {
+      int const n = g.n;
+      int const top = 1 << 20;
+      std::vector<int> stage(n, -1), set(n, -1), level(n, -1), queue;
+      queue.reserve(n);
+      std::vector<std::pair<std::vector<int>, int>> work;
+      {
+        std::vector<int> all;
+        for (int i = 0; i < n; ++i) {
+          if (stage0[i] >= 0)
+            all.push_back(i);
+        }
+        work.emplace_back(std::move(all), 0);
+      }
+      int nset = 0;
+      // breadth-first search of the part  id  from  s ; levels in  level
+      auto bfs = [&](int s, int id) {
+        queue.clear();
+        queue.push_back(s);
+        level[s] = 0;
+        for (std::size_t h = 0; h < queue.size(); ++h) {
+          int const v = queue[h];
+          for (int k = g.ptr[v]; k < g.ptr[v + 1]; ++k) {
+            int const u = g.adj[k];
+            if (set[u] == id && level[u] < 0) {
+              level[u] = level[v] + 1;
+              queue.push_back(u);
+            }
+          }
+        }
+      };
+      while (!work.empty()) {
+        auto nodes = std::move(work.back().first);
+        int const depth = work.back().second;
+        work.pop_back();
+        int const id = nset++;
+        for (int v : nodes) {
+          set[v] = id;
+          level[v] = -1;
+        }
+        for (int s : nodes) {
+          if (level[s] >= 0)
+            continue;
+          // one connected component
+          bfs(s, id);
+          std::vector<int> comp(queue);
+          if (int(comp.size()) <= leaf) {
+            for (int v : comp)
+              stage[v] = 0;
+            continue;
+          }
+          // pseudo-peripheral node: restart from the farthest node while
+          // the eccentricity grows
+          int root = comp.back(), height = level[root];
+          for (int pass = 0; pass < 4; ++pass) {
+            for (int v : comp)
+              level[v] = -1;
+            bfs(root, id);
+            int const far = queue.back();
+            if (level[far] <= height && pass > 0)
+              break;
+            height = level[far];
+            root = far;
+          }
+          for (int v : comp)
+            level[v] = -1;
+          bfs(root, id);
+          int const nlev = level[queue.back()] + 1;
+          if (nlev < 3) {
+            for (int v : comp)
+              stage[v] = 0;
+            continue;
+          }
+          // the level where half of the component is reached
+          std::vector<int> count(nlev, 0);
+          for (int v : comp)
+            ++count[level[v]];
+          int m = 0;
+          for (int sum = 0; m < nlev; ++m) {
+            sum += count[m];
+            if (2 * sum >= int(comp.size()))
+              break;
+          }
+          m = std::min(std::max(m, 1), nlev - 2);
+          std::vector<int> a, b;
+          for (int v : comp) {
+            if (level[v] < m) {
+              a.push_back(v);
+            }
+            else if (level[v] > m) {
+              b.push_back(v);
+            }
+            else {
+              bool touches = false;
+              for (int k = g.ptr[v]; k < g.ptr[v + 1] && !touches; ++k) {
+                int const u = g.adj[k];
+                touches = set[u] == id && level[u] == m + 1;
+              }
+              if (touches)
+                stage[v] = top - depth;
+              else
+                a.push_back(v);
+            }
+          }
+          for (int v : comp)
+            level[v] = -1;
+          // components other than this one are searched with these marks
+          for (int v : comp)
+            level[v] = 0;
+          work.emplace_back(std::move(a), depth + 1);
+          work.emplace_back(std::move(b), depth + 1);
+        }
+      }
+      return stage;
+    }
+
+    // Structure of the factor of  g  in the order  perm  (new -> old), of
+    // which the first  nelim  nodes are eliminated. The rows of the others
+    // hold their later neighbours, fill-in included, as the elimination of
+    // the first  nelim  nodes leaves them.
+    inline NodeFactor symbolic(const NodeGraph& g, const std::vector<int>& perm, int nelim) {
+      int const n = g.n;
+      std::vector<int> inv(n);
+      for (int j = 0; j < n; ++j)
+        inv[perm[j]] = j;
+      std::vector<std::vector<int>> rows(n);
+      std::vector<int> mark(n, -1), child(n, -1), sibling(n, -1);
+      NodeFactor f;
+      std::int64_t orig = 0;
+      auto add = [&](std::vector<int>& row, int j, int x) {
+        if (x > j && mark[x] != j) {
+          mark[x] = j;
+          row.push_back(x);
+          return true;
+        }
+        return false;
+      };
+      for (int j = 0; j < nelim; ++j) {
+        auto& row = rows[j];
+        int const o = perm[j];
+        for (int k = g.ptr[o]; k < g.ptr[o + 1]; ++k)
+          orig += add(row, j, inv[g.adj[k]]);
+        for (int c = child[j]; c >= 0; c = sibling[c]) {
+          for (int x : rows[c])
+            add(row, j, x);
+        }
+        std::sort(row.begin(), row.end());
+        f.terms += std::int64_t(row.size());
+        if (!row.empty() && row[0] < nelim) {
+          sibling[j] = child[row[0]];
+          child[row[0]] = j;
+        }
+      }
+      f.fill = f.terms - orig;
+      // rows of the nodes not eliminated: their later neighbours, and the
+      // fill-in among them, which the roots of the elimination tree carry
+      // (the other columns hold subsets of their parent's known nodes)
+      for (int j = nelim; j < n; ++j) {
+        int const o = perm[j];
+        for (int k = g.ptr[o]; k < g.ptr[o + 1]; ++k) {
+          int const x = inv[g.adj[k]];
+          if (x > j)
+            rows[j].push_back(x);
+        }
+      }
+      for (int j = 0; j < nelim; ++j) {
+        auto const& row = rows[j];
+        if (row.empty() || row[0] < nelim)
+          continue;
+        for (std::size_t a = 0; a < row.size(); ++a) {
+          for (std::size_t b = a + 1; b < row.size(); ++b)
+            rows[row[a]].push_back(row[b]);
+        }
+      }
+      f.ptr.assign(n + 1, 0);
+      for (int j = 0; j < n; ++j) {
+        auto& row = rows[j];
+        if (j >= nelim) {
+          std::sort(row.begin(), row.end());
+          row.erase(std::unique(row.begin(), row.end()), row.end());
+        }
+        f.ptr[j + 1] = f.ptr[j] + int(row.size());
+      }
+      f.col.reserve(f.ptr[n]);
+      for (auto& row : rows)
+        f.col.insert(f.col.end(), row.begin(), row.end());
+      return f;
+    }
+
+  }
+
+}
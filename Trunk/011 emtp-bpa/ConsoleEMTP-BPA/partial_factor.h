@@ -0,0 +1,166 @@
+/***********************************
+EMTP C++
+Partial retriangularization of (Y) in SUBTS1: the factor rows ahead of the
+first row which a switch change or a new (Y) value reaches are kept.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+#include <vector>
+
+namespace emtp {
+
+  // SUBTS1 eliminates rows L = 2, ..., KPARTB of (Y) in turn, each against
+  // the factor rows before it, and appends the result to KM / YKM. Row L
+  // depends on the rows of (Y) which closed switches merge into it (the
+  // KODE chains), on the chains its columns map to, and on the factor
+  // rows before it. So after a change, all rows ahead of the lowest node
+  // whose (Y) row or chain changed, or which neighbours such a chain,
+  // come out with the same bits, and only the rows from there on are
+  // eliminated again: the later the nodes of a switch are numbered, the
+  // fewer rows its opening or closing costs.
+  class PartialFactor {
+  public:
+    // first row to eliminate: 2 (all of them) unless the previous
+    // triangularization was complete and recorded by snapshot(); the
+    // factor rows kept end at  end(first - 1)
+    template<typename K, typename Y, typename S, typename C>
+    int first_row(const K& km, const Y& ykm, const S& kks, const C& kode,
+      int ntot, int kpartb) {
+      bool const valid = valid_;
+      valid_ = false;
+      if (!valid || ntot != ntot_ || kpartb != kpartb_)
+        return 2;
+      for (int L = 1; L <= kpartb; ++L) {
+        if (kks(L) != kks_[L])
+          return 2;
+      }
+      changed_.clear();
+      for (int i = 1; i <= ntot; ++i) {
+        if (kode(i) != kode_[i])
+          changed_.push_back(i);
+      }
+      for (int L = 2; L <= kpartb; ++L) {
+        for (int j = kks(L) - 1; ; --j) {
+          auto const at = std::size_t(j - lo_);
+          if (km(j) != km_[at] || !(ykm(j) == ykm_[at])) {
+            changed_.push_back(L);
+            break;
+          }
+          if (km(j) < 0)
+            break;
+        }
+      }
+      int first = kpartb + 1;
+      // a node of the chain, and the nodes of its row of (Y)
+      auto touch = [&](int x) {
+        if (x > kpartb) {
+          first = 2;  // known nodes have no row to find neighbours in
+          return;
+        }
+        first = std::min(first, x);
+        for (int j = kks(x) - 1; ; --j) {
+          first = std::min(first, std::abs(km(j)));
+          if (km(j) < 0)
+            break;
+        }
+      };
+      for (int d : changed_) {
+        for (int pass = 0; pass < 2 && first > 2; ++pass) {
+          int x = d;
+          for (int n = 0; n <= ntot && first > 2; ++n) {
+            touch(x);
+            int const next = pass == 0 ? kode(x) : kode_[x];
+            if (next <= 1 || next > ntot || next == d)
+              break;
+            x = next;
+          }
+        }
+        if (first <= 2)
+          return 2;
+      }
+      return first;
+    }
+
+    // factor rows end at YKM( end(L) ) after row L
+    void row_end(int L, int ii) {
+      if (int(end_.size()) <= L)
+        end_.resize(L + 1, 0);
+      end_[L] = ii;
+    }
+    int end(int L) const { return L < int(end_.size()) ? end_[L] : 0; }
+    const std::vector<int>& ends() const { return end_; }
+    void set_ends(const std::vector<int>& ends) { end_ = ends; }
+
+    // (Y) and the KODE chains which the factors now in KM / YKM belong to
+    template<typename K, typename Y, typename S, typename C>
+    void snapshot(const K& km, const Y& ykm, const S& kks, const C& kode,
+      int ntot, int kpartb) {
+      ntot_ = ntot;
+      kpartb_ = kpartb;
+      kks_.assign(kpartb + 1, 0);
+      int hi = 0;
+      for (int L = 1; L <= kpartb; ++L) {
+        kks_[L] = kks(L);
+        if (L >= 2)
+          hi = std::max(hi, kks(L) - 1);
+      }
+      kode_.assign(ntot + 1, 0);
+      for (int i = 1; i <= ntot; ++i)
+        kode_[i] = kode(i);
+      lo_ = kks(1);
+      km_.resize(std::max(hi - lo_ + 1, 0));
+      ykm_.resize(km_.size());
+      for (int j = lo_; j <= hi; ++j) {
+        km_[j - lo_] = km(j);
+        ykm_[j - lo_] = ykm(j);
+      }
+      valid_ = true;
+    }
+    void invalidate() { valid_ = false; }
+
+    // one triangularization from row  first  of rows 2, ..., kpartb
+    void count(int first, int kpartb, double seconds) {
+      if (first <= 2) {
+        ++full_;
+        full_seconds_ += seconds;
+      }
+      else {
+        ++partial_;
+        partial_seconds_ += seconds;
+        partial_rows_ += std::max(kpartb - first + 1, 0);
+        partial_total_ += std::max(kpartb - 1, 0);
+      }
+    }
+    std::int64_t full() const { return full_; }
+    std::int64_t partial() const { return partial_; }
+    double full_seconds() const { return full_seconds_; }
+    double partial_seconds() const { return partial_seconds_; }
+    // rows eliminated by the partial ones, and their rows in all
+    std::int64_t partial_rows() const { return partial_rows_; }
+    std::int64_t partial_total() const { return partial_total_; }
+
+  private:
+    bool valid_ = false;
+    int ntot_ = 0;
+    int kpartb_ = 0;
+    int lo_ = 0;
+    std::vector<int> kks_, kode_, km_;
+    std::vector<double> ykm_;
+    std::vector<int> end_;
+    std::vector<int> changed_;
+    std::int64_t full_ = 0;
+    std::int64_t partial_ = 0;
+    std::int64_t partial_rows_ = 0;
+    std::int64_t partial_total_ = 0;
+    double full_seconds_ = 0.0;
+    double partial_seconds_ = 0.0;
+  };
+
+}
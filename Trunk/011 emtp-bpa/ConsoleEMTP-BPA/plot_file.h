@@ -0,0 +1,513 @@
+/***********************************
+EMTP C++
+Time-series ("plot") output of PLTFIL: CSV text, or chunked columnar binary.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <thread>
+#include <vector>
+#include "step_pipeline.h"
+
+namespace emtp {
+
+  enum class PlotFormat { csv, float64, float32 };
+
+  // Binary layout, native byte order. The file is a sequence of records,
+  // each starting with a 4-byte tag:
+  //   "EMTH" table header: int32 value size (8 or 4), int32 nchan,
+  //          int32 length + bytes of the date line, then for each channel
+  //          the name (int32 length + bytes) and int32 decimation  every
+  //   "EMTC" chunk: int32 nstep, then for each channel int32 count and
+  //          count values (a channel keeps steps 0, every, 2*every, ...)
+  // A new "EMTH" starts a new table (a second TACS/network header).
+  namespace plot_file {
+    constexpr char header_tag[4] = { 'E', 'M', 'T', 'H' };
+    constexpr char chunk_tag[4] = { 'E', 'M', 'T', 'C' };
+
+    // one CSV value, as SState("e12.5") formats it
+    inline int format_value(char* buf, std::size_t size, double v) {
+      return std::snprintf(buf, size, "%12.5e", v);
+    }
+  }
+
+  // One output channel: a node voltage, branch voltage/current, machine,
+  // TACS or U.M. variable, in the order of the values handed to PLTFIL.
+  struct PlotChannel {
+    std::string name;
+    int every = 1;               // keep one step in  every
+    std::vector<double> values;  // kept steps of the current chunk
+  };
+
+  // Output channel registry and sink of the time-series rows. The header
+  // writers of OVER15 / TACS1B register the channels; PLTFIL hands over one
+  // step of all of them. The header (date line and channel names) always
+  // goes to the CSV stream, so the .out file documents the columns; the
+  // rows go there too, or to "<out>.bin" in one write per chunk. The
+  // number of channels is not limited; a step costs O(1) per channel.
+  //
+  // With pipeline(true) a row is only copied into a ring, and a writer
+  // thread formats and writes it while the next steps are solved; every
+  // other call waits for the writer to catch up first, so the file is the
+  // same byte for byte.
+  class PlotWriter {
+  public:
+    static constexpr int chunk_steps = 4096;
+    static constexpr std::size_t ring_rows = 64;
+
+    PlotWriter() = default;
+    PlotWriter(const PlotWriter&) = delete;
+    PlotWriter& operator=(const PlotWriter&) = delete;
+    ~PlotWriter() {
+      try { close(); } catch (...) {}
+      pipeline(false);
+    }
+
+    // rows written by a writer thread (true) or by the caller
+    void pipeline(bool on) {
+      if (on == bool(ring_))
+        return;
+      if (on) {
+        ring_ = std::make_unique<SpscRing<Row>>(ring_rows);
+        writer_ = std::thread([this] { write_rows(); });
+        return;
+      }
+      ring_->close();
+      writer_.join();
+      ring_.reset();
+    }
+
+    void open(std::ostream& csv, const std::string& binFile, PlotFormat format) {
+      drain();
+      csv_ = home_ = &csv;
+      format_ = format;
+      binFile_ = homeBin_ = binFile;
+      if (format_ != PlotFormat::csv) {
+        bin_.open(binFile_, std::ios::binary | std::ios::trunc);
+        if (!bin_.is_open())
+          throw std::runtime_error("Cannot open '" + binFile_ + "' !");
+      }
+    }
+    PlotFormat format() const { return format_; }
+
+    // keep one step in  every  of the channels called  name  ("*": all but
+    // the time); applies to channels registered afterwards
+    void decimate(const std::string& name, int every) {
+      decimation_.emplace_back(trim(name), std::max(every, 1));
+    }
+
+    // new table; with  rewind  the output restarts at the top of the file
+    void start(const std::string& date, bool rewind) {
+      drain();
+      end_table();
+      if (rewind) {
+        csv_->clear();
+        csv_->seekp({});
+        if (bin_.is_open()) {
+          bin_.close();
+          bin_.open(binFile_, std::ios::binary | std::ios::trunc);
+        }
+      }
+      *csv_ << date << '\n';
+      date_ = date;
+      channels_.clear();
+      header_done_ = false;
+      nstep_ = 0;
+      chunk_step_ = 0;
+    }
+    void column(const std::string& name) {
+      drain();
+      if (!channels_.empty())
+        *csv_ << ',';
+      *csv_ << name;
+      add_channel(name);
+    }
+    void end_header() {
+      drain();
+      *csv_ << '\n';
+    }
+    int channels() const { return int(channels_.size()); }
+    // rows of the table so far; resume() goes on counting from a snapshot
+    // (snapshot.h), so that the decimated channels keep their phase
+    std::int64_t steps() {
+      drain();
+      return nstep_;
+    }
+    void resume(std::int64_t steps) {
+      drain();
+      nstep_ = steps;
+    }
+
+    // one time step: time, then  n - 1  output variables
+    void row(const double* v, int n) {
+      if (channels_.empty()) {
+        for (int j = 0; j < n; ++j)  // rows without a header
+          add_channel(std::string());
+      }
+      if (ring_) {
+        Row& r = ring_->push();
+        r.v.assign(v, v + n);
+        ring_->commit();
+        return;
+      }
+      put_row(v, n);
+    }
+
+    void flush() {
+      drain();
+      end_chunk();
+    }
+    // the rest of the table to other files (a variant of a sweep, sweep.h),
+    // under the same date and channels; home() goes back to those of open()
+    void branch(std::ostream& csv, const std::string& binFile) {
+      drain();
+      end_branch();
+      csv_ = &csv;
+      binFile_ = binFile;
+      if (format_ != PlotFormat::csv) {
+        bin_.open(binFile_, std::ios::binary | std::ios::trunc);
+        if (!bin_.is_open())
+          throw std::runtime_error("Cannot open '" + binFile_ + "' !");
+      }
+      *csv_ << date_ << '\n';
+      for (std::size_t j = 0; j < channels_.size(); ++j)
+        *csv_ << (j > 0 ? "," : "") << channels_[j].name;
+      *csv_ << '\n';
+      header_done_ = false;
+    }
+    void home() {
+      drain();
+      end_branch();
+      csv_ = home_;
+      binFile_ = homeBin_;
+      if (format_ != PlotFormat::csv) {
+        bin_.open(binFile_, std::ios::binary | std::ios::app);
+        if (!bin_.is_open())
+          throw std::runtime_error("Cannot open '" + binFile_ + "' !");
+      }
+      header_done_ = true;
+    }
+    void close() {
+      drain();
+      end_table();
+      if (bin_.is_open())
+        bin_.close();
+    }
+
+  private:
+    struct Row {
+      std::vector<double> v;
+    };
+    // writer thread
+    void write_rows() {
+      while (Row* r = ring_->front()) {
+        if (!error_) {
+          try {
+            put_row(r->v.data(), int(r->v.size()));
+          }
+          catch (...) {
+            error_ = std::current_exception();
+          }
+        }
+        ring_->pop();
+      }
+    }
+    // wait for the rows handed to the writer
+    void drain() {
+      if (!ring_)
+        return;
+      ring_->drain();
+      if (error_) {
+        std::exception_ptr e;
+        std::swap(e, error_);
+        std::rethrow_exception(e);
+      }
+    }
+
+    void put_row(const double* v, int n) {
+      int const nchan = int(channels_.size());
+      if (format_ == PlotFormat::csv) {
+        char buf[32];
+        for (int j = 0; j < n; ++j) {
+          if (j > 0)
+            line_ += ',';
+          if (j >= nchan || nstep_ % channels_[j].every == 0)
+            line_.append(buf, plot_file::format_value(buf, sizeof(buf), v[j]));
+        }
+        line_ += '\n';
+        csv_->write(line_.data(), line_.size());
+        line_.clear();
+        ++nstep_;
+        return;
+      }
+      if (!header_done_)
+        write_header();
+      for (int j = 0; j < nchan; ++j) {
+        auto& c = channels_[j];
+        if (nstep_ % c.every == 0)
+          c.values.push_back(j < n ? v[j] : std::nan(""));  // missing: NaN
+      }
+      ++nstep_;
+      if (++chunk_step_ >= chunk_steps)
+        end_chunk();
+    }
+    void end_chunk() {
+      if (chunk_step_ == 0)
+        return;
+      if (format_ == PlotFormat::float64)
+        put_chunk<double>();
+      else
+        put_chunk<float>();
+      for (auto& c : channels_)
+        c.values.clear();
+      chunk_step_ = 0;
+    }
+
+    void add_channel(const std::string& name) {
+      PlotChannel c;
+      c.name = name;
+      if (!channels_.empty()) {  // the time is never decimated
+        std::string const key = trim(name);
+        for (auto& d : decimation_) {
+          if (d.first == "*" || d.first == key)
+            c.every = d.second;
+        }
+      }
+      channels_.push_back(std::move(c));
+    }
+    static std::string trim(const std::string& s) {
+      auto const b = s.find_first_not_of(' ');
+      if (b == std::string::npos)
+        return std::string();
+      return s.substr(b, s.find_last_not_of(' ') - b + 1);
+    }
+    void end_branch() {
+      if (bin_.is_open() && !header_done_)
+        write_header();
+      end_chunk();
+      if (bin_.is_open())
+        bin_.close();
+    }
+    // a table without rows still keeps its header
+    void end_table() {
+      if (bin_.is_open() && !header_done_ && !date_.empty())
+        write_header();
+      end_chunk();
+      date_.clear();
+    }
+    void put_bytes(const void* p, std::size_t n) {
+      auto const at = chunk_.size();
+      chunk_.resize(at + n);
+      if (n != 0)
+        std::memcpy(chunk_.data() + at, p, n);
+    }
+    void put_int(std::int32_t v) {
+      put_bytes(&v, sizeof(v));
+    }
+    void put_string(const std::string& s) {
+      put_int(std::int32_t(s.size()));
+      put_bytes(s.data(), s.size());
+    }
+    void write_header() {
+      chunk_.clear();
+      put_bytes(plot_file::header_tag, 4);
+      put_int(format_ == PlotFormat::float64 ? 8 : 4);
+      put_int(std::int32_t(channels_.size()));
+      put_string(date_);
+      for (auto& c : channels_) {
+        put_string(c.name);
+        put_int(c.every);
+      }
+      bin_.write(chunk_.data(), chunk_.size());
+      header_done_ = true;
+    }
+    // all channels of the chunk in one write
+    template<typename T>
+    void put_chunk() {
+      chunk_.clear();
+      put_bytes(plot_file::chunk_tag, 4);
+      put_int(chunk_step_);
+      for (auto& c : channels_) {
+        auto const count = c.values.size();
+        put_int(std::int32_t(count));
+        auto const at = chunk_.size();
+        chunk_.resize(at + count * sizeof(T));
+        T* out = reinterpret_cast<T*>(chunk_.data() + at);
+        for (std::size_t i = 0; i < count; ++i)
+          out[i] = T(c.values[i]);
+      }
+      bin_.write(chunk_.data(), chunk_.size());
+    }
+
+    std::ostream* csv_ = nullptr;
+    std::ofstream bin_;
+    std::string binFile_;
+    std::ostream* home_ = nullptr;  // the files of open()
+    std::string homeBin_;
+    PlotFormat format_ = PlotFormat::csv;
+    std::vector<std::pair<std::string, int>> decimation_;
+    std::string date_;
+    std::vector<PlotChannel> channels_;
+    bool header_done_ = false;
+    std::int64_t nstep_ = 0;     // steps of the table so far
+    int chunk_step_ = 0;         // steps of the current chunk
+    std::vector<char> chunk_;
+    std::string line_;
+    std::unique_ptr<SpscRing<Row>> ring_;
+    std::thread writer_;
+    std::exception_ptr error_;
+  };
+
+  // Reader of the binary plot file written by PlotWriter.
+  class PlotReader {
+  public:
+    explicit PlotReader(const std::string& binFile)
+      : in_(binFile, std::ios::binary) {
+      if (!in_.is_open())
+        throw std::runtime_error("Cannot open '" + binFile + "' !");
+    }
+
+    // advance to the next table; false at the end of the file
+    bool next_table() {
+      std::vector<std::vector<double>> skip;
+      while (in_table_ && next_chunk(skip)) {}
+      char tag[4];
+      if (!in_.read(tag, 4))
+        return false;
+      if (std::memcmp(tag, plot_file::header_tag, 4) != 0)
+        throw std::runtime_error("plot file: table header expected");
+      value_size_ = get_int();
+      int const nchan = get_int();
+      date_ = get_string();
+      names_.resize(nchan);
+      every_.resize(nchan);
+      for (int j = 0; j < nchan; ++j) {
+        names_[j] = get_string();
+        every_[j] = std::max(get_int(), 1);
+      }
+      in_table_ = true;
+      first_step_ = 0;
+      steps_ = 0;
+      return true;
+    }
+    const std::string& date() const { return date_; }
+    const std::vector<std::string>& names() const { return names_; }
+    int channels() const { return int(names_.size()); }
+    int every(int j) const { return every_[j]; }
+
+    // next chunk of the current table: the kept values of each channel;
+    // false at the end of the table
+    bool next_chunk(std::vector<std::vector<double>>& values) {
+      if (!in_table_)
+        return false;
+      char tag[4];
+      auto const pos = in_.tellg();
+      if (!in_.read(tag, 4) || std::memcmp(tag, plot_file::chunk_tag, 4) != 0) {
+        in_.clear();
+        in_.seekg(pos);
+        in_table_ = false;
+        return false;
+      }
+      first_step_ += steps_;
+      steps_ = get_int();
+      values.resize(names_.size());
+      std::vector<float> f;
+      for (auto& v : values) {
+        std::size_t const count = std::size_t(get_int());
+        v.resize(count);
+        if (value_size_ == 8) {
+          read(v.data(), count * 8);
+        }
+        else {
+          f.resize(count);
+          read(f.data(), count * 4);
+          std::copy(f.begin(), f.end(), v.begin());
+        }
+      }
+      return true;
+    }
+    // steps of the last chunk, and the table step of its first one
+    int steps() const { return steps_; }
+    std::int64_t first_step() const { return first_step_; }
+
+    // the CSV text which PlotFormat::csv would have written
+    static void to_csv(const std::string& binFile, std::ostream& csv) {
+      PlotReader r(binFile);
+      std::vector<std::vector<double>> values;
+      std::vector<std::size_t> next;
+      std::string line;
+      char buf[32];
+      while (r.next_table()) {
+        int const nchan = r.channels();
+        csv << r.date() << '\n';
+        if (nchan > 0 && !r.names()[0].empty()) {
+          for (int j = 0; j < nchan; ++j)
+            csv << (j > 0 ? "," : "") << r.names()[j];
+          csv << '\n';
+        }
+        while (r.next_chunk(values)) {
+          next.assign(nchan, 0);
+          for (int i = 0; i < r.steps(); ++i) {
+            std::int64_t const step = r.first_step() + i;
+            line.clear();
+            // the closing step flags time -9999 and carries no variables
+            bool const closing = nchan > 0 && !(-1 < values[0][i]);
+            for (int j = 0; j < nchan; ++j) {
+              bool const kept = step % r.every(j) == 0;
+              double const v = kept ? values[j][next[j]++] : 0.0;
+              if (closing && j > 0)
+                continue;
+              if (j > 0)
+                line += ',';
+              if (kept)
+                line.append(buf, plot_file::format_value(buf, sizeof(buf), v));
+            }
+            line += '\n';
+            csv.write(line.data(), line.size());
+          }
+        }
+      }
+    }
+
+  private:
+    void read(void* p, std::size_t n) {
+      if (!in_.read(static_cast<char*>(p), n))
+        throw std::runtime_error("plot file: unexpected end of file");
+    }
+    std::int32_t get_int() {
+      std::int32_t v = 0;
+      read(&v, sizeof(v));
+      return v;
+    }
+    std::string get_string() {
+      std::string s(std::size_t(get_int()), '\0');
+      if (!s.empty())
+        read(&s[0], s.size());
+      return s;
+    }
+
+    std::ifstream in_;
+    int value_size_ = 8;
+    std::string date_;
+    std::vector<std::string> names_;
+    std::vector<int> every_;
+    bool in_table_ = false;
+    std::int64_t first_step_ = 0;
+    int steps_ = 0;
+  };
+
+}
@@ -0,0 +1,738 @@
+/***********************************
+EMTP C++
+Repeat solution of the time-step network: the triangularized (Y) of SUBTS1,
+compiled into flat index / value arrays for the forward and back
+substitution of SUBTS3, one table per independent partition of the network.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <vector>
+#include "step_pipeline.h"
+
+namespace emtp {
+
+  // compiled (default), the FORTRAN loops of SUBTS3, or both: the loops
+  // give the answer, the compiled kernel is timed and checked against them
+  enum class SolveMode { compiled, legacy, bench };
+
+  // The factor table of SUBTS1 (KM, YKM, KK) holds for each row of the
+  // upper-triangular (Y) a head KM = -L, YKM = 1/Ykk, followed by the
+  // off-diagonal terms KM = k, YKM scaled, the last of them at KK(L). Nodes
+  // above KPARTB have known voltages; KODE chains the nodes which closed
+  // switches merge. SUBTS3 tests all of this term by term, every step.
+  //
+  // build() settles these tests once per triangularization:
+  //  - downward: the terms of known nodes are dropped. Consecutive rows of
+  //    a dense (multiphase) block, where row r updates exactly the pivot of
+  //    row r+1 and the terms of row r+1, form one supernode: the pivots are
+  //    eliminated in turn, then every shared target is loaded once and
+  //    takes the updates of all the rows of the block.
+  //  - backward: the terms of each row in the reverse order of the table,
+  //    then the KODE chain of its pivot as a list of copies.
+  // Every target takes its updates in the order of the FORTRAN loops, so
+  // the result is the same to the last bit.
+  //
+  // Distributed lines connect their ends only through the history sources
+  // of SUBTS2, so (Y) falls apart into blocks between them, which OVER7
+  // orders and SUBTS1 factors without fill from one to another. build()
+  // finds these partitions from the table; with a StepPool of several
+  // threads, it compiles chunks of them of about equal work, one table per
+  // thread, which solve() runs side by side.
+  class RepeatSolution {
+  public:
+    static constexpr int max_block = 64;
+    // terms of a chunk for one thread, at the least
+    static constexpr std::size_t chunk_terms = 4096;
+    // terms a row of the table, at the least, for solve_columns()
+    static constexpr int column_terms_per_row = 3;
+
+    // is the compiled table that of factorization  serial  of this network?
+    bool current(std::int64_t serial, int iupper, int kpartb, int ntot) const {
+      return serial_ == serial && iupper_ == iupper && kpartb_ == kpartb
+        && ntot_ == ntot;
+    }
+    // false: the table is not of the expected shape, use the FORTRAN loops
+    bool built() const { return ok_; }
+    // threads for the partitions of solve() (nullptr: this one)
+    void pool(StepPool* p) {
+      pool_ = p;
+      if ((p ? p->size() : 1) != threads_)
+        serial_ = -1;  // chunked again by the next build()
+    }
+    // false: one table for the whole network, from the next build()
+    void partitioned(bool on) {
+      if (on != partitioned_)
+        serial_ = -1;
+      partitioned_ = on;
+    }
+    // the time of each chunk in solve() (off by default: two clock reads
+    // a chunk a time step)
+    void timed(bool on) { timed_ = on; }
+    bool timed() const { return timed_; }
+
+    // km, ykm, kk, kode: 1-based, as in COMMON
+    template<typename IntArr, typename RealArr>
+    void build(const IntArr& km, const RealArr& ykm, const IntArr& kk,
+      const IntArr& kode, int iupper, int kpartb, int ntot, std::int64_t serial) {
+      serial_ = serial;
+      iupper_ = iupper;
+      kpartb_ = kpartb;
+      ntot_ = ntot;
+      ok_ = false;
+      ++builds_;
+      clear();
+      // rows of the table
+      std::vector<int> head;
+      for (int ii = 1; ii <= iupper; ) {
+        int const L = -km(ii);
+        if (L < 1 || L > kpartb)
+          return;
+        int const last = kk(L);
+        if (last < ii || last > iupper)
+          return;
+        for (int i = ii + 1; i <= last; ++i) {
+          if (km(i) < 1 || km(i) > ntot)
+            return;
+        }
+        head.push_back(ii);
+        ii = last + 1;
+      }
+      int const nrow = int(head.size());
+      head.push_back(iupper + 1);
+      // KODE chains: the nodes which take the voltage of L, above KPARTB
+      // (pre) and of the pivot of each row
+      auto chain = [&](int L, std::vector<int>& to) {
+        int const k = kode(L);
+        if (k == 0 || k > L)
+          return true;
+        for (int n5 = k, n = 0; n5 != L; n5 = kode(n5)) {
+          if (n5 < 1 || n5 > ntot || ++n > ntot)
+            return false;
+          to.push_back(n5);
+        }
+        return true;
+      };
+      std::vector<int> pre_L, pre_end, pre_to, row_end, row_to;
+      for (int L = ntot; L >= kpartb && L >= 1; --L) {
+        std::size_t const at = pre_to.size();
+        if (!chain(L, pre_to))
+          return;
+        if (pre_to.size() != at) {
+          pre_L.push_back(L);
+          pre_end.push_back(int(pre_to.size()));
+        }
+      }
+      for (int r = 0; r < nrow; ++r) {
+        if (!chain(-km(head[r]), row_to))
+          return;
+        row_end.push_back(int(row_to.size()));
+      }
+      // partitions: a node written by the solution is in the partition of
+      // every other node written together with it or read for it. Nodes
+      // which are only read (known voltages) are shared; the branches of
+      // distributed lines bring no terms, so the lines split the network.
+      std::vector<char> written(ntot + 1, 0);
+      for (int r = 0; r < nrow; ++r) {
+        written[-km(head[r])] = 1;
+        for (int i = head[r] + 1; i < head[r + 1]; ++i) {
+          if (km(i) <= kpartb)
+            written[km(i)] = 1;
+        }
+      }
+      for (int n : pre_to)
+        written[n] = 1;
+      for (int n : row_to)
+        written[n] = 1;
+      std::vector<int> up(ntot + 1);
+      for (int n = 0; n <= ntot; ++n)
+        up[n] = n;
+      auto find = [&](int n) {
+        while (up[n] != n)
+          n = up[n] = up[up[n]];
+        return n;
+      };
+      auto unite = [&](int a, int b) { up[find(a)] = find(b); };
+      for (int r = 0, c = 0; r < nrow; ++r) {
+        int const L = -km(head[r]);
+        for (int i = head[r] + 1; i < head[r + 1]; ++i) {
+          if (written[km(i)])
+            unite(L, km(i));
+        }
+        for (; c < row_end[r]; ++c)
+          unite(L, row_to[c]);
+      }
+      for (std::size_t g = 0, c = 0; g < pre_L.size(); ++g) {
+        for (; c < std::size_t(pre_end[g]); ++c)
+          unite(pre_L[g], pre_to[c]);
+      }
+      // rows and KODE copies of each partition, in the order of the table
+      std::vector<int> part_of(ntot + 1, -1);
+      std::vector<std::vector<int>> rows, pres;
+      auto part = [&](int n) {
+        int& p = part_of[partitioned_ ? find(n) : 0];
+        if (p < 0) {
+          p = int(rows.size());
+          rows.emplace_back();
+          pres.emplace_back();
+        }
+        return p;
+      };
+      for (int r = 0; r < nrow; ++r)
+        rows[part(-km(head[r]))].push_back(r);
+      for (std::size_t g = 0; g < pre_L.size(); ++g)
+        pres[part(pre_L[g])].push_back(int(g));
+      // nodes written and terms of each, for the log and the chunks
+      std::size_t const np = rows.size();
+      std::vector<std::size_t> work(np, 0);
+      nodes_.assign(np, 0);
+      for (std::size_t p = 0; p < np; ++p) {
+        for (int r : rows[p]) {
+          nodes_[p] += 1 + row_end[r] - (r > 0 ? row_end[r - 1] : 0);
+          work[p] += std::size_t(head[r + 1] - head[r]);
+        }
+        for (int g : pres[p])
+          nodes_[p] += pre_end[g] - (g > 0 ? pre_end[g - 1] : 0);
+      }
+      // consecutive partitions of about equal work, one chunk per thread,
+      // each compiled as one table of its rows in the order of the table
+      std::size_t total = 0;
+      for (std::size_t w : work)
+        total += w + 1;
+      std::size_t n = pool_ ? std::size_t(pool_->size()) : 1;
+      n = std::max<std::size_t>(std::min({ n, np, total / chunk_terms }), 1);
+      threads_ = pool_ ? pool_->size() : 1;
+      parts_.assign(n, Part());
+      std::vector<int> mark(ntot + 1, -1), pos(ntot + 1, -1);
+      std::vector<int> crows, cpres;
+      for (std::size_t c = 0, p = 0, sum = 0; c < n; ++c) {
+        Part& pt = parts_[c];
+        pt.first = p;
+        crows.clear();
+        cpres.clear();
+        for (; p < np && (c + 1 == n || p == pt.first || sum * n < total * (c + 1)); ++p) {
+          sum += work[p] + 1;
+          crows.insert(crows.end(), rows[p].begin(), rows[p].end());
+          cpres.insert(cpres.end(), pres[p].begin(), pres[p].end());
+          pt.nodes += nodes_[p];
+        }
+        pt.last = p;
+        std::sort(crows.begin(), crows.end());
+        std::sort(cpres.begin(), cpres.end());
+        compile(pt, crows, cpres, head, km, ykm, kpartb,
+          pre_L, pre_end, pre_to, row_end, row_to, mark, pos);
+      }
+      rows_ = nrow;
+      terms_ = iupper - nrow;
+      ok_ = true;
+    }
+
+    // V = [Y] ** -1 * I  over the right side  e  (0-based: e[0] is node 1),
+    // the partitions side by side on the threads of the pool
+    void solve(double* e) {
+      auto run = [&](int c) {
+        if (c >= int(parts_.size()))
+          return;
+        Part& pt = parts_[c];
+        if (!timed_) {
+          pt.forward(e);
+          pt.backward(e);
+          return;
+        }
+        auto const t0 = clock::now();
+        pt.forward(e);
+        pt.backward(e);
+        pt.ns += std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+      };
+      if (pool_ && parts_.size() > 1)
+        pool_->run(run);
+      else
+        run(0);
+      ++steps_;
+    }
+
+    // the chunks are independent: all downward, then all backward
+    void forward(double* e) const {
+      for (auto const& p : parts_)
+        p.forward(e);
+    }
+    void backward(double* e) const {
+      for (auto const& p : parts_)
+        p.backward(e);
+    }
+
+    // does one pass over the factors for  nrhs  columns beat the loops of
+    // SUBTS1? Gathering and scattering the columns costs about as much as
+    // a few terms a node, which the side-by-side updates win back only on
+    // a table of several terms a row, over whole groups of lanes (on the
+    // lines and towers of case0012 with 1 or 2 terms a row, the loops are
+    // faster at any NCOMP: --bench-columns)
+    bool columns_pay(int nrhs) const {
+      return nrhs >= int(lanes) && terms_ >= column_terms_per_row * rows_;
+    }
+
+    // the  nrhs  right sides of SUBTS1 for the compensation of nonlinear
+    // elements (ZNONL: column m from  z[m * ld]), all in one pass over the
+    // factors. The columns are gathered node by node, so that each term
+    // updates the values of all of them side by side; every value takes
+    // its updates in the order of the FORTRAN loops. As there, nodes of
+    // known voltage are not copied down their KODE chains.
+    void solve_columns(double* z, int nrhs, int ld) {
+      if (nrhs <= 0)
+        return;
+      // columns padded with zeros to whole groups of lanes
+      std::size_t const n = (std::size_t(nrhs) + lanes - 1) / lanes * lanes;
+      cols_.assign(std::size_t(ntot_) * n, 0.0);
+      acc_.resize(max_block * n);
+      for (std::size_t m = 0; m < std::size_t(nrhs); ++m) {
+        const double* c = z + m * std::size_t(ld);
+        for (int k = 0; k < ntot_; ++k)
+          cols_[k * n + m] = c[k];
+      }
+      for (auto const& p : parts_) {
+        p.forward_columns(cols_.data(), n, acc_.data());
+        p.backward_columns(cols_.data(), n, acc_.data());
+      }
+      for (std::size_t m = 0; m < std::size_t(nrhs); ++m) {
+        double* c = z + m * std::size_t(ld);
+        for (int k = 0; k < ntot_; ++k)
+          c[k] = cols_[k * n + m];
+      }
+      ++column_solves_;
+      columns_ += nrhs;
+    }
+
+    // SolveMode::bench, around the FORTRAN loops: begin solves a copy of
+    // the right side  e  with the compiled kernel and starts the clock of
+    // the loops; end stops it and compares their answer bit by bit.
+    void bench_begin(const double* e, int n) {
+      copy_.assign(e, e + n);
+      auto const t0 = clock::now();
+      forward(copy_.data());
+      auto const t1 = clock::now();
+      backward(copy_.data());
+      auto const t2 = clock::now();
+      forward_ns_ += std::chrono::duration<double, std::nano>(t1 - t0).count();
+      compiled_ns_ += std::chrono::duration<double, std::nano>(t2 - t0).count();
+      pending_ = true;
+      legacy_t0_ = clock::now();
+    }
+    bool bench_pending() const { return pending_; }
+    void bench_end(const double* e) {
+      legacy_ns_ += std::chrono::duration<double, std::nano>(clock::now() - legacy_t0_).count();
+      pending_ = false;
+      ++bench_steps_;
+      if (std::memcmp(e, copy_.data(), copy_.size() * sizeof(double)) != 0)
+        ++mismatches_;
+    }
+    void count_solve() { ++solves_; }
+    // the same for the columns of SUBTS1
+    void bench_columns_begin(const double* z, int nrhs, int ld) {
+      col_copy_.assign(z, z + std::size_t(std::max(nrhs, 0)) * ld);
+      auto const t0 = clock::now();
+      solve_columns(col_copy_.data(), nrhs, ld);
+      col_compiled_ns_ += std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+      col_pending_ = true;
+      legacy_t0_ = clock::now();
+    }
+    bool bench_columns_pending() const { return col_pending_; }
+    void bench_columns_end(const double* z) {
+      col_legacy_ns_ += std::chrono::duration<double, std::nano>(clock::now() - legacy_t0_).count();
+      col_pending_ = false;
+      if (std::memcmp(z, col_copy_.data(), col_copy_.size() * sizeof(double)) != 0)
+        ++mismatches_;
+    }
+
+    void report(std::ostream& os) const {
+      os << "Repeat solution: " << rows_ << " rows, " << terms_ << " terms, "
+        << supernodes_ << " supernodes of " << rows_merged_ << " rows, "
+        << nodes_.size() << " partitions, " << builds_ << " builds";
+      if (bench_steps_ > 0) {
+        os << "; " << bench_steps_ << " steps, loops " << legacy_ns_ / bench_steps_
+          << " ns/step, compiled " << compiled_ns_ / bench_steps_ << " ns/step (downward "
+          << forward_ns_ / bench_steps_ << "), "
+          << mismatches_ << " mismatches";
+      }
+      else {
+        os << ", " << solves_ << " compiled solutions";
+      }
+      if (column_solves_ > 0) {
+        os << "; " << column_solves_ << " column solutions of " << columns_
+          << " right sides";
+        if (col_legacy_ns_ > 0.0) {
+          os << ", loops " << col_legacy_ns_ / column_solves_ << " ns, compiled "
+            << col_compiled_ns_ / column_solves_ << " ns each";
+        }
+      }
+      os << '\n';
+    }
+
+    // the table of the last factors, the column solutions so far and
+    // their right sides, and with SolveMode::bench the ns of one of them
+    // by the loops and compiled, and the answers which differed
+    int rows() const { return rows_; }
+    int terms() const { return terms_; }
+    long long column_solves() const { return column_solves_; }
+    long long columns() const { return columns_; }
+    double column_ns(bool compiled) const {
+      return column_solves_ > 0
+        ? (compiled ? col_compiled_ns_ : col_legacy_ns_) / column_solves_ : 0.0;
+    }
+    long long mismatches() const { return mismatches_; }
+
+    // partitions of the last factors, and the time steps solved over them
+    long long steps() const { return steps_; }
+    std::size_t partitions() const { return nodes_.size(); }
+    std::size_t chunks() const { return parts_.size(); }
+    int largest_partition() const {
+      return nodes_.empty() ? 0 : *std::max_element(nodes_.begin(), nodes_.end());
+    }
+    int smallest_partition() const {
+      return nodes_.empty() ? 0 : *std::min_element(nodes_.begin(), nodes_.end());
+    }
+    // chunk c: its partitions [first, last) (0-based), nodes, ns per step
+    // (0 unless timed)
+    struct Timing {
+      std::size_t first, last;
+      int nodes;
+      double ns_per_step;
+    };
+    Timing timing(std::size_t c) const {
+      auto const& pt = parts_[c];
+      return { pt.first, pt.last, pt.nodes,
+        steps_ > 0 ? pt.ns / double(steps_) : 0.0 };
+    }
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    // x = x - a * v  over  n  columns, n a multiple of  lanes : four
+    // independent statements the compiler packs into SIMD instructions
+    static constexpr std::size_t lanes = 4;
+    static void sub_scaled(double* __restrict x, const double* __restrict a,
+      double v, std::size_t n) {
+      for (std::size_t m = 0; m < n; m += lanes) {
+        x[m] = x[m] - a[m] * v;
+        x[m + 1] = x[m + 1] - a[m + 1] * v;
+        x[m + 2] = x[m + 2] - a[m + 2] * v;
+        x[m + 3] = x[m + 3] - a[m + 3] * v;
+      }
+    }
+
+    // The compiled table of one chunk of partitions: their rows, in the
+    // order of the table, and the KODE copies above KPARTB of their nodes
+    struct Part {
+      // downward, by block: pivots and 1/Ykk, the terms among the pivots of
+      // the block, targets of the tail and their values (target by target,
+      // one value per row of the block)
+      std::vector<int> piv_;
+      std::vector<double> diag_, intra_;
+      std::vector<int> tail_idx_;
+      std::vector<double> tail_val_;
+      std::vector<int> blk_row_, blk_tail_, blk_val_, blk_intra_;  // ends
+      // backward: KODE copies above KPARTB, then row by row terms, pivot and
+      // chain copies (ends into the flat arrays)
+      std::vector<int> pre_from_, pre_end_, copy_to_;
+      std::vector<int> back_idx_;
+      std::vector<double> back_val_;
+      std::vector<int> back_row_, back_piv_, back_copy_;
+      std::vector<char> back_pair_;  // summed side by side with the next row
+      std::size_t first = 0, last = 0;  // partitions [first, last)
+      int nodes = 0;    // nodes written: pivots and copies
+      double ns = 0.0;  // solution time of the steps
+
+      void forward(double* e) const {
+        double a[max_block];
+        int row = 0, tail = 0, val = 0, intra = 0;
+        for (std::size_t b = 0; b < blk_row_.size(); ++b) {
+          int const rend = blk_row_[b], tend = blk_tail_[b];
+          int const q = rend - row;
+          const int* piv = &piv_[row];
+          const double* diag = &diag_[row];
+          const double* v = tail_val_.data() + val;
+          if (q == 1) {
+            double const ai = e[piv[0]];
+            e[piv[0]] = ai * diag[0];
+            for (int t = tail; t < tend; ++t, ++v)
+              e[tail_idx_[t]] = e[tail_idx_[t]] - ai * *v;
+          }
+          else {
+            const double* c = intra_.data() + intra;
+            for (int i = 0; i < q; ++i) {
+              double const ai = e[piv[i]];
+              e[piv[i]] = ai * diag[i];
+              a[i] = ai;
+              for (int j = i + 1; j < q; ++j)
+                e[piv[j]] = e[piv[j]] - ai * *c++;
+            }
+            for (int t = tail; t < tend; ++t, v += q) {
+              double x = e[tail_idx_[t]];
+              for (int i = 0; i < q; ++i)
+                x = x - a[i] * v[i];
+              e[tail_idx_[t]] = x;
+            }
+          }
+          row = rend;
+          tail = tend;
+          val = blk_val_[b];
+          intra = blk_intra_[b];
+        }
+      }
+
+      void backward(double* e) const {
+        int c = 0;
+        for (std::size_t g = 0; g < pre_from_.size(); ++g) {
+          double const v = e[pre_from_[g]];
+          for (; c < pre_end_[g]; ++c)
+            e[copy_to_[c]] = v;
+        }
+        int i = 0;
+        for (std::size_t r = 0; r < back_piv_.size(); ++r) {
+          if (back_pair_[r]) {
+            int const n0 = back_row_[r] - i, i1 = back_row_[r];
+            int const n1 = back_row_[r + 1] - i1;
+            int const n = std::min(n0, n1);
+            double a0 = 0.0, a1 = 0.0;
+            for (int j = 0; j < n; ++j) {
+              a0 = a0 - e[back_idx_[i + j]] * back_val_[i + j];
+              a1 = a1 - e[back_idx_[i1 + j]] * back_val_[i1 + j];
+            }
+            for (int j = n; j < n0; ++j)
+              a0 = a0 - e[back_idx_[i + j]] * back_val_[i + j];
+            for (int j = n; j < n1; ++j)
+              a1 = a1 - e[back_idx_[i1 + j]] * back_val_[i1 + j];
+            e[back_piv_[r]] += a0;
+            int const L = back_piv_[++r];
+            e[L] += a1;
+            i = back_row_[r];
+            double const v = e[L];
+            for (; c < back_copy_[r]; ++c)
+              e[copy_to_[c]] = v;
+            continue;
+          }
+          double a = 0.0;
+          for (; i < back_row_[r]; ++i)
+            a = a - e[back_idx_[i]] * back_val_[i];
+          int const L = back_piv_[r];
+          e[L] += a;
+          double const v = e[L];
+          for (; c < back_copy_[r]; ++c)
+            e[copy_to_[c]] = v;
+        }
+      }
+
+      // forward() and backward() for  n  interleaved columns (node k of
+      // column m at  e[k * n + m]), less the copies above KPARTB;  a  is
+      // scratch of  max_block * n  values
+      void forward_columns(double* e, std::size_t n, double* a) const {
+        int row = 0, tail = 0, val = 0, intra = 0;
+        for (std::size_t b = 0; b < blk_row_.size(); ++b) {
+          int const rend = blk_row_[b], tend = blk_tail_[b];
+          int const q = rend - row;
+          const int* piv = &piv_[row];
+          const double* diag = &diag_[row];
+          const double* v = tail_val_.data() + val;
+          const double* c = intra_.data() + intra;
+          for (int i = 0; i < q; ++i) {
+            double* p = e + piv[i] * n;
+            double* ai = a + i * n;
+            std::copy(p, p + n, ai);
+            for (std::size_t m = 0; m < n; ++m)
+              p[m] = ai[m] * diag[i];
+            for (int j = i + 1; j < q; ++j)
+              sub_scaled(e + piv[j] * n, ai, *c++, n);
+          }
+          for (int t = tail; t < tend; ++t, v += q) {
+            double* x = e + tail_idx_[t] * n;
+            for (int i = 0; i < q; ++i)
+              sub_scaled(x, a + i * n, v[i], n);
+          }
+          row = rend;
+          tail = tend;
+          val = blk_val_[b];
+          intra = blk_intra_[b];
+        }
+      }
+
+      void backward_columns(double* e, std::size_t n, double* a) const {
+        int c = pre_end_.empty() ? 0 : pre_end_.back();
+        int i = 0;
+        for (std::size_t r = 0; r < back_piv_.size(); ++r) {
+          std::fill(a, a + n, 0.0);
+          for (; i < back_row_[r]; ++i)
+            sub_scaled(a, e + back_idx_[i] * n, back_val_[i], n);
+          double* p = e + back_piv_[r] * n;
+          for (std::size_t m = 0; m < n; ++m)
+            p[m] += a[m];
+          for (; c < back_copy_[r]; ++c)
+            std::copy(p, p + n, e + copy_to_[c] * n);
+        }
+      }
+    };
+
+    // the table of one chunk: rows  rows  of the table (numbered from
+    // 0, starting at  head ) and KODE groups  pres  above KPARTB. mark and
+    // pos: scratch of NTOT + 1, marks by the number of the row in the table
+    template<typename IntArr, typename RealArr>
+    void compile(Part& pt, const std::vector<int>& rows,
+      const std::vector<int>& pres, const std::vector<int>& head,
+      const IntArr& km, const RealArr& ykm, int kpartb,
+      const std::vector<int>& pre_L, const std::vector<int>& pre_end,
+      const std::vector<int>& pre_to, const std::vector<int>& row_end,
+      const std::vector<int>& row_to, std::vector<int>& mark,
+      std::vector<int>& pos) {
+      for (int g : pres) {
+        for (int c = g > 0 ? pre_end[g - 1] : 0; c < pre_end[g]; ++c)
+          pt.copy_to_.push_back(pre_to[c] - 1);
+        pt.pre_from_.push_back(pre_L[g] - 1);
+        pt.pre_end_.push_back(int(pt.copy_to_.size()));
+      }
+      int const nrow = int(rows.size());
+      // backward: rows last to first, terms in reverse
+      for (int j = nrow - 1; j >= 0; --j) {
+        int const r = rows[j];
+        int const L = -km(head[r]);
+        for (int i = head[r + 1] - 1; i > head[r]; --i) {
+          pt.back_idx_.push_back(km(i) - 1);
+          pt.back_val_.push_back(ykm(i));
+        }
+        pt.back_row_.push_back(int(pt.back_idx_.size()));
+        pt.back_piv_.push_back(L - 1);
+        for (int c = r > 0 ? row_end[r - 1] : 0; c < row_end[r]; ++c)
+          pt.copy_to_.push_back(row_to[c] - 1);
+        pt.back_copy_.push_back(int(pt.copy_to_.size()));
+      }
+      // two consecutive rows whose sums do not depend on each other are summed
+      // side by side (each in its own order), as the sums are latency bound
+      pt.back_pair_.assign(nrow, 0);
+      for (int r = 0; r + 1 < nrow; ++r) {
+        int const c0 = r > 0 ? pt.back_copy_[r - 1]
+          : int(pt.pre_end_.empty() ? 0 : pt.pre_end_.back());
+        if (pt.back_copy_[r] != c0)
+          continue;
+        bool indep = true;
+        for (int i = pt.back_row_[r]; i < pt.back_row_[r + 1]; ++i)
+          indep = indep && pt.back_idx_[i] != pt.back_piv_[r];
+        if (indep) {
+          pt.back_pair_[r] = 1;
+          ++r;
+        }
+      }
+      // downward: terms of unknown nodes only
+      std::vector<int> rbeg(nrow + 1, 0), tidx;
+      std::vector<double> tval;
+      std::vector<char> dup(nrow, 0);
+      for (int j = 0; j < nrow; ++j) {
+        int const r = rows[j];
+        rbeg[j] = int(tidx.size());
+        for (int i = head[r] + 1; i < head[r + 1]; ++i) {
+          int const k = km(i);
+          if (k > kpartb)
+            continue;
+          if (mark[k] == r)
+            dup[j] = 1;
+          mark[k] = r;
+          tidx.push_back(k);
+          tval.push_back(ykm(i));
+        }
+      }
+      rbeg[nrow] = int(tidx.size());
+      // row j continues into row j + 1 if its targets are the pivot of
+      // j + 1 and the targets of j + 1
+      auto continues = [&](int j) {
+        int const p = -km(head[rows[j + 1]]);
+        int const stamp = -2 - rows[j];
+        if (dup[j] || dup[j + 1] || rbeg[j + 1] - rbeg[j] != rbeg[j + 2] - rbeg[j + 1] + 1)
+          return false;
+        for (int i = rbeg[j + 1]; i < rbeg[j + 2]; ++i) {
+          if (tidx[i] == p)
+            return false;
+          mark[tidx[i]] = stamp;
+        }
+        mark[p] = stamp;
+        for (int i = rbeg[j]; i < rbeg[j + 1]; ++i) {
+          if (mark[tidx[i]] != stamp)
+            return false;
+        }
+        return true;
+      };
+      for (int r0 = 0; r0 < nrow; ) {
+        int r1 = r0 + 1;
+        while (r1 < nrow && r1 - r0 < max_block && continues(r1 - 1))
+          ++r1;
+        int const q = r1 - r0;
+        for (int j = r0; j < r1; ++j) {
+          pt.piv_.push_back(-km(head[rows[j]]) - 1);
+          pt.diag_.push_back(ykm(head[rows[j]]));
+        }
+        if (q == 1) {
+          for (int i = rbeg[r0]; i < rbeg[r0 + 1]; ++i) {
+            pt.tail_idx_.push_back(tidx[i] - 1);
+            pt.tail_val_.push_back(tval[i]);
+          }
+        }
+        else {
+          // each row: terms of the later pivots, then of the shared tail
+          std::vector<std::vector<double>> coef(q);
+          for (int r = r0; r < r1; ++r) {
+            for (int i = rbeg[r]; i < rbeg[r + 1]; ++i)
+              pos[tidx[i]] = i;
+            for (int j = r + 1; j < r1; ++j)
+              pt.intra_.push_back(tval[pos[-km(head[rows[j]])]]);
+            for (int i = rbeg[r1 - 1]; i < rbeg[r1]; ++i)
+              coef[r - r0].push_back(tval[pos[tidx[i]]]);
+          }
+          for (int i = rbeg[r1 - 1], t = 0; i < rbeg[r1]; ++i, ++t) {
+            pt.tail_idx_.push_back(tidx[i] - 1);
+            for (int r = 0; r < q; ++r)
+              pt.tail_val_.push_back(coef[r][t]);
+          }
+          ++supernodes_;
+          rows_merged_ += q;
+        }
+        pt.blk_row_.push_back(int(pt.piv_.size()));
+        pt.blk_tail_.push_back(int(pt.tail_idx_.size()));
+        pt.blk_val_.push_back(int(pt.tail_val_.size()));
+        pt.blk_intra_.push_back(int(pt.intra_.size()));
+        r0 = r1;
+      }
+    }
+
+    void clear() {
+      parts_.clear();
+      nodes_.clear();
+      steps_ = 0;
+      rows_ = terms_ = supernodes_ = rows_merged_ = 0;
+    }
+
+    std::int64_t serial_ = -1;
+    int iupper_ = -1, kpartb_ = -1, ntot_ = -1;
+    bool ok_ = false;
+    bool partitioned_ = true;
+    bool timed_ = false;
+    std::vector<Part> parts_;  // one per chunk
+    std::vector<int> nodes_;   // nodes written of each partition
+    StepPool* pool_ = nullptr;
+    int threads_ = 1;  // of the pool at build()
+    long long steps_ = 0;
+    // statistics
+    int rows_ = 0, terms_ = 0, supernodes_ = 0, rows_merged_ = 0;
+    long builds_ = 0;
+    long long solves_ = 0, bench_steps_ = 0, mismatches_ = 0;
+    double legacy_ns_ = 0.0, compiled_ns_ = 0.0, forward_ns_ = 0.0;
+    long long column_solves_ = 0, columns_ = 0;
+    double col_legacy_ns_ = 0.0, col_compiled_ns_ = 0.0;
+    std::vector<double> copy_, col_copy_;
+    std::vector<double> cols_, acc_;  // scratch of solve_columns
+    bool pending_ = false, col_pending_ = false;
+    clock::time_point legacy_t0_;
+  };
+
+}
@@ -0,0 +1,280 @@
+/***********************************
+EMTP C++
+Snapshot files of a running time loop: the COMMON blocks and the saved
+locals of the subroutines, written at chosen times and read back to go on
+from there ("START AGAIN").
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fem.hpp>
+
+namespace emtp {
+
+  // What a snapshot file says about itself, ahead of the state.
+  struct SnapshotHeader {
+    std::int32_t version = 0;
+    std::int32_t scale = 1;      // EMTP list scale (DIMENS) of the run
+    std::int32_t loop = 0;       // time loop of the deck, from 1
+    std::int32_t step = 0;       // ISTEP at the snapshot
+    double t = 0.0;              // the step about to be taken
+    double deltat = 0.0;
+    std::int64_t plot_steps = 0; // time-series rows written before it
+    std::uint64_t deck_hash = 0; // of the bytes of the data deck
+    std::string deck;            // and its file name
+  };
+
+  // Binary archive of the state, one direction per object: the same
+  // sequence of calls writes a file (save) or reads it back (load). The
+  // state goes in named blocks; the length of every list is stored with
+  // it and must be the same when it is read, so a file only loads into a
+  // run of the same deck at the same list scale. Pages of the lists which
+  // hold only zeros (most of the EMTP lists) are stored as one byte.
+  class Snapshot {
+  public:
+    static constexpr char magic[9] = "EMTPSNAP";
+    static constexpr std::int32_t version = 2;
+    static constexpr std::size_t page = 4096;
+
+    // save: writes the header
+    Snapshot(const std::string& file, const SnapshotHeader& h)
+      : file_(file), saving_(true), header_(h) {
+      open(std::ios::out | std::ios::trunc);
+      header_io();
+    }
+    // load: reads and checks the header
+    explicit Snapshot(const std::string& file)
+      : file_(file), saving_(false) {
+      open(std::ios::in);
+      header_io();
+    }
+    // the same in memory, for a sweep (see sweep.h)
+    Snapshot(std::vector<char>& mem, const SnapshotHeader& h)
+      : file_("(memory)"), saving_(true), header_(h), mem_(&mem) {
+      mem.clear();
+      header_io();
+    }
+    explicit Snapshot(const std::vector<char>& mem)
+      : file_("(memory)"), saving_(false)
+      , mem_(const_cast<std::vector<char>*>(&mem)) {
+      header_io();
+    }
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    // the header alone, to set up the run which loads the file
+    static SnapshotHeader peek(const std::string& file) {
+      return Snapshot(file).header();
+    }
+
+    bool saving() const { return saving_; }
+    const SnapshotHeader& header() const { return header_; }
+    const std::string& file() const { return file_; }
+    // bytes written or read so far
+    std::int64_t bytes() const { return bytes_; }
+
+    // start of the block  name : its tag is checked on load
+    void block(const char* name) {
+      block_ = name;
+      std::uint32_t tag = hash(name);
+      std::uint32_t const want = tag;
+      item(tag);
+      if (tag != want)
+        fail("block '" + block_ + "' expected");
+    }
+    // the saved locals of a subroutine (cmn_sve): whether they exist, and
+    // if so the object, constructed on load if need be; nullptr if not
+    template<typename T>
+    T* saved(fem::cmn_sve& sve, const char* name) {
+      block(name);
+      bool live = !sve.is_called_first_time();
+      item(live);
+      if (!live)
+        return nullptr;
+      if (sve.is_called_first_time())
+        sve.construct<T>();
+      return &sve.get<T>();
+    }
+
+    template<typename... T>
+    void operator()(T&... v) {
+      (item(v), ...);
+    }
+
+    // end of the file: a last tag on save, checked on load
+    void finish() {
+      block("end");
+      if (saving_ && io_) {
+        io_->flush();
+        if (!*io_)
+          fail("write error");
+      }
+    }
+
+  private:
+    void open(std::ios::openmode mode) {
+      buf_.reset(new char[1 << 20]);
+      io_ = std::make_unique<std::fstream>();
+      io_->rdbuf()->pubsetbuf(buf_.get(), 1 << 20);
+      io_->open(file_, mode | std::ios::binary);
+      if (!io_->is_open())
+        throw std::runtime_error("Cannot open '" + file_ + "' !");
+    }
+    void header_io() {
+      char m[8];
+      std::memcpy(m, magic, 8);
+      raw(m, 8);
+      if (std::memcmp(m, magic, 8) != 0)
+        fail("not a snapshot file");
+      header_.version = version;
+      item(header_.version);
+      if (header_.version != version)
+        fail("version " + std::to_string(header_.version) + ", expected "
+          + std::to_string(version));
+      item(header_.scale);
+      item(header_.loop);
+      item(header_.step);
+      item(header_.t);
+      item(header_.deltat);
+      item(header_.plot_steps);
+      item(header_.deck_hash);
+      item(header_.deck);
+    }
+    [[noreturn]] void fail(const std::string& what) const {
+      throw std::runtime_error("snapshot '" + file_ + "': " + what);
+    }
+    static std::uint32_t hash(const char* s) {
+      std::uint32_t h = 2166136261u;  // FNV-1a
+      for (; *s; ++s)
+        h = (h ^ std::uint8_t(*s)) * 16777619u;
+      return h;
+    }
+
+    void put(const void* p, std::size_t n) {
+      if (mem_)
+        mem_->insert(mem_->end(), static_cast<const char*>(p),
+          static_cast<const char*>(p) + n);
+      else
+        io_->write(static_cast<const char*>(p), std::streamsize(n));
+      bytes_ += std::int64_t(n);
+    }
+    void get(void* p, std::size_t n) {
+      if (mem_) {
+        if (mem_->size() - at_ < n)
+          fail("end of file in block '" + block_ + "'");
+        std::memcpy(p, mem_->data() + at_, n);
+        at_ += n;
+      }
+      else {
+        io_->read(static_cast<char*>(p), std::streamsize(n));
+        if (std::size_t(io_->gcount()) != n)
+          fail("end of file in block '" + block_ + "'");
+      }
+      bytes_ += std::int64_t(n);
+    }
+    void raw(void* p, std::size_t n) {
+      if (saving_)
+        put(p, n);
+      else
+        get(p, n);
+    }
+    // n bytes at p, a page at a time, pages of zeros as one byte; on load
+    // a page which is zero already is not touched (nor committed)
+    void pages(void* p, std::size_t n) {
+      static const char zeros[page] = {};
+      char* b = static_cast<char*>(p);
+      for (std::size_t at = 0; at < n; at += page) {
+        std::size_t const len = n - at < page ? n - at : page;
+        std::uint8_t data = 0;
+        if (saving_) {
+          data = std::memcmp(b + at, zeros, len) != 0;
+          put(&data, 1);
+          if (data)
+            put(b + at, len);
+          continue;
+        }
+        get(&data, 1);
+        if (data)
+          get(b + at, len);
+        else if (std::memcmp(b + at, zeros, len) != 0)
+          std::memset(b + at, 0, len);
+      }
+    }
+    void count(std::int64_t n) {
+      std::int64_t stored = n;
+      item(stored);
+      if (stored != n)
+        fail("list of " + std::to_string(stored) + " entries in block '"
+          + block_ + "', this run has " + std::to_string(n));
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+    item(T& v) {
+      raw(&v, sizeof(T));
+    }
+    template<int N>
+    void item(fem::str<N>& v) {
+      raw(v.elems, N);
+    }
+    template<typename T, std::size_t N>
+    void item(fem::arr_ref<T, N>& v) {
+      static_assert(std::is_trivially_copyable<T>::value, "list of objects");
+      count(v.size_1d());
+      pages(v.begin(), std::size_t(v.size_1d()) * sizeof(T));
+    }
+    template<typename T>
+    void item(std::vector<T>& v) {
+      static_assert(std::is_trivially_copyable<T>::value, "vector of objects");
+      std::int64_t n = std::int64_t(v.size());
+      item(n);
+      if (!saving_)
+        v.resize(std::size_t(n));
+      if (n != 0)
+        raw(v.data(), v.size() * sizeof(T));
+    }
+    void item(std::string& s) {
+      std::int64_t n = std::int64_t(s.size());
+      item(n);
+      if (!saving_)
+        s.resize(std::size_t(n));
+      if (n != 0)
+        raw(&s[0], s.size());
+    }
+
+    std::string file_;
+    bool saving_;
+    SnapshotHeader header_;
+    std::unique_ptr<char[]> buf_;
+    std::unique_ptr<std::fstream> io_;
+    std::vector<char>* mem_ = nullptr;  // in memory: the bytes
+    std::size_t at_ = 0;                // and the next one to read
+    std::int64_t bytes_ = 0;
+    std::string block_ = "header";
+  };
+
+  // Snapshots of a run: the times to write them at, and the file to go on
+  // from (see snapshot_step).
+  struct SnapshotPlan {
+    std::vector<double> times;  // in increasing order
+    std::string base;           // files "<base>.snap1", "<base>.snap2", ...
+    std::string restart;        // snapshot to load, or empty
+    std::string deck;           // input data file of the run
+    std::size_t next = 0;       // first of  times  not yet written
+    int written = 0;            // snapshot files written so far
+    int loops = 0;              // time loops of the deck so far
+    bool loaded = false;        // the restart file was loaded
+  };
+
+}
@@ -0,0 +1,196 @@
+/***********************************
+EMTP C++
+Threads of the time-step loop: a fork-join pool for the chunks of one step,
+and a single-producer / single-consumer ring handing rows to a writer.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace emtp {
+
+  namespace step_pipeline {
+    // spins of a waiting thread before it yields, and yields before it
+    // sleeps: a time step takes microseconds, a wake-up from a condition
+    // variable about as long again
+    constexpr int spins = 256;
+    constexpr int yields = 2048;
+
+    // wait for  ready()  by spinning, then yielding, then on  cv
+    template<typename F>
+    void wait(std::mutex& mtx, std::condition_variable& cv,
+      std::atomic<int>& sleepers, F&& ready) {
+      for (int n = 0; n < spins + yields; ++n) {
+        if (ready())
+          return;
+        if (n >= spins)
+          std::this_thread::yield();
+      }
+      sleepers.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, ready);
+      }
+      sleepers.fetch_sub(1);
+    }
+    inline void wake(std::mutex& mtx, std::condition_variable& cv,
+      std::atomic<int>& sleepers) {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(mtx);
+        cv.notify_all();
+      }
+    }
+  }
+
+  // Persistent workers for the chunks of one time step. run(fn) calls
+  // fn(c) for c = 0, ..., size() - 1, chunk c on thread c (the caller
+  // takes chunk 0), and returns when all are done. Each chunk writes its
+  // own part of the results, so they are the same for any number of
+  // threads.
+  class StepPool {
+  public:
+    StepPool() = default;
+    StepPool(const StepPool&) = delete;
+    StepPool& operator=(const StepPool&) = delete;
+    ~StepPool() { resize(1); }
+
+    // n threads in all, the caller included
+    void resize(int n) {
+      n = n < 1 ? 1 : n;
+      if (n == size())
+        return;
+      if (!workers_.empty()) {
+        stop_.store(true);
+        epoch_.fetch_add(1);
+        {
+          std::lock_guard<std::mutex> lock(mtx_);
+          cv_.notify_all();
+        }
+        for (auto& t : workers_)
+          t.join();
+        workers_.clear();
+        stop_.store(false);
+      }
+      for (int c = 1; c < n; ++c)
+        workers_.emplace_back([this, c] { work(c); });
+    }
+    int size() const { return int(workers_.size()) + 1; }
+
+    template<typename F>
+    void run(F&& fn) {
+      if (workers_.empty()) {
+        fn(0);
+        return;
+      }
+      using Fn = typename std::remove_reference<F>::type;
+      fn_ = [](void* f, int c) { (*static_cast<Fn*>(f))(c); };
+      ctx_ = const_cast<void*>(static_cast<const void*>(&fn));
+      done_.store(0);
+      epoch_.fetch_add(1);
+      step_pipeline::wake(mtx_, cv_, sleepers_);
+      fn(0);
+      int const others = int(workers_.size());
+      step_pipeline::wait(done_mtx_, done_cv_, done_sleepers_,
+        [&] { return done_.load(std::memory_order_acquire) == others; });
+    }
+
+  private:
+    void work(int c) {
+      std::uint64_t seen = 0;
+      for (;;) {
+        step_pipeline::wait(mtx_, cv_, sleepers_,
+          [&] { return epoch_.load(std::memory_order_acquire) != seen; });
+        seen = epoch_.load(std::memory_order_acquire);
+        if (stop_.load())
+          return;
+        fn_(ctx_, c);
+        done_.fetch_add(1, std::memory_order_release);
+        step_pipeline::wake(done_mtx_, done_cv_, done_sleepers_);
+      }
+    }
+
+    std::vector<std::thread> workers_;
+    void (*fn_)(void*, int) = nullptr;
+    void* ctx_ = nullptr;
+    std::atomic<std::uint64_t> epoch_{ 0 };
+    std::atomic<int> done_{ 0 };
+    std::atomic<bool> stop_{ false };
+    std::mutex mtx_, done_mtx_;
+    std::condition_variable cv_, done_cv_;
+    std::atomic<int> sleepers_{ 0 }, done_sleepers_{ 0 };
+  };
+
+  // Single-producer / single-consumer ring of  capacity  slots of T. The
+  // producer fills the slot of  push()  and publishes it with  commit();
+  // the consumer takes the slot of  front()  and frees it with  pop().
+  // Neither side takes a lock unless it has to wait.
+  template<typename T>
+  class SpscRing {
+  public:
+    explicit SpscRing(std::size_t capacity) : slots_(capacity) {}
+
+    // producer: the next free slot, after waiting for one
+    T& push() {
+      std::size_t const h = head_.load(std::memory_order_relaxed);
+      step_pipeline::wait(mtx_, cv_, sleepers_, [&] {
+        return h - tail_.load(std::memory_order_acquire) < slots_.size();
+      });
+      return slots_[h % slots_.size()];
+    }
+    void commit() {
+      head_.store(head_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_release);
+      step_pipeline::wake(mtx_, cv_, sleepers_);
+    }
+    // consumer: the oldest slot, after waiting for one; nullptr once
+    // close() was called and the ring is empty
+    T* front() {
+      std::size_t const t = tail_.load(std::memory_order_relaxed);
+      step_pipeline::wait(mtx_, cv_, sleepers_, [&] {
+        return head_.load(std::memory_order_acquire) != t
+          || closed_.load(std::memory_order_acquire);
+      });
+      if (head_.load(std::memory_order_acquire) == t)
+        return nullptr;
+      return &slots_[t % slots_.size()];
+    }
+    void pop() {
+      tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_release);
+      step_pipeline::wake(mtx_, cv_, sleepers_);
+    }
+    // producer: wait until the consumer has freed every slot
+    void drain() {
+      std::size_t const h = head_.load(std::memory_order_relaxed);
+      step_pipeline::wait(mtx_, cv_, sleepers_,
+        [&] { return tail_.load(std::memory_order_acquire) == h; });
+    }
+    // producer: no more slots; the consumer sees nullptr when done
+    void close() {
+      closed_.store(true, std::memory_order_release);
+      std::lock_guard<std::mutex> lock(mtx_);
+      cv_.notify_all();
+    }
+
+  private:
+    std::vector<T> slots_;
+    std::atomic<std::size_t> head_{ 0 }, tail_{ 0 };
+    std::atomic<bool> closed_{ false };
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::atomic<int> sleepers_{ 0 };
+  };
+
+}
@@ -0,0 +1,128 @@
+/***********************************
+EMTP C++
+Sweeps of switching times: variants of one case which differ only in the
+times of some switches, each run from a copy of the state at the start
+of its time loop, so the steady state and the initial conditions are
+found once for all of them.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace emtp {
+
+  // New times of one switch, found by the names of its two nodes.
+  struct SweepSwitch {
+    std::string bus1, bus2;  // six characters, as on the switch card
+    bool close = false;      // tclose given
+    bool open = false;       // topen given
+    double tclose = 0.0;
+    double topen = 0.0;
+  };
+
+  // One variant: its tag (for the names of its files) and its switches.
+  struct SweepVariant {
+    std::string tag;
+    std::vector<SweepSwitch> switches;
+  };
+
+  // The sweep table is a side file of switch cards grouped by variant:
+  //
+  //   C comment
+  //   VARIANT f1
+  //     BUS  ASTP1 A   0.0120
+  //     BUS  BSTP1 B   0.0125    1.00
+  //   VARIANT f2
+  //     ...
+  //
+  // Each card has the columns of a switch card: node names in 3-8 and
+  // 9-14, TCLOSE in 15-24 and TOPEN in 25-34; a blank time is left as the
+  // data deck has it. A variant can only move times still ahead of the
+  // state it starts from: a time it gives must not be before that state,
+  // nor may it replace a time of the deck already reached there, nor the
+  // TCLOSE of a switch closed there (TCLOSE = -1: closed in the steady
+  // state; its TOPEN may still be swept) or any time of a switch that has
+  // opened. sweep_next throws for each of these.
+  inline std::vector<SweepVariant> read_sweep(const std::string& file) {
+    std::ifstream in(file);
+    if (!in.is_open())
+      throw std::runtime_error("Cannot open '" + file + "' !");
+    auto field = [](const std::string& card, std::size_t col, std::size_t len) {
+      return col - 1 < card.size() ? card.substr(col - 1, len) : std::string();
+    };
+    auto trim = [](const std::string& s) {
+      auto const b = s.find_first_not_of(" \t\r");
+      if (b == std::string::npos)
+        return std::string();
+      return s.substr(b, s.find_last_not_of(" \t\r") - b + 1);
+    };
+    auto number = [&](const std::string& s, int line, bool& given) {
+      std::string const t = trim(s);
+      given = !t.empty();
+      if (!given)
+        return 0.0;
+      char* end = nullptr;
+      double const v = std::strtod(t.c_str(), &end);
+      if (end != t.c_str() + t.size())
+        throw std::runtime_error(file + " (" + std::to_string(line)
+          + "): bad time '" + t + "'");
+      return v;
+    };
+    std::vector<SweepVariant> variants;
+    std::string card;
+    for (int line = 1; std::getline(in, card); ++line) {
+      if (!card.empty() && card.back() == '\r')
+        card.pop_back();
+      if (trim(card).empty() || (card.size() >= 2 && card.compare(0, 2, "C ") == 0)
+          || card == "C")
+        continue;
+      if (card.compare(0, 7, "VARIANT") == 0) {
+        SweepVariant v;
+        v.tag = trim(card.substr(7));
+        bool ok = !v.tag.empty();
+        for (char c : v.tag)
+          ok = ok && (std::isalnum(static_cast<unsigned char>(c)) || c == '-'
+            || c == '_' || c == '.');
+        if (!ok)
+          throw std::runtime_error(file + " (" + std::to_string(line)
+            + "): bad variant tag '" + v.tag + "'");
+        variants.push_back(std::move(v));
+        continue;
+      }
+      if (variants.empty())
+        throw std::runtime_error(file + " (" + std::to_string(line)
+          + "): switch card before the first VARIANT");
+      SweepSwitch s;
+      s.bus1 = field(card, 3, 6);
+      s.bus2 = field(card, 9, 6);
+      s.bus1.resize(6, ' ');
+      s.bus2.resize(6, ' ');
+      s.tclose = number(field(card, 15, 10), line, s.close);
+      s.topen = number(field(card, 25, 10), line, s.open);
+      variants.back().switches.push_back(s);
+    }
+    return variants;
+  }
+
+  // A sweep in progress (see snapshot_step and over20): the state at the
+  // start of the time loop, kept in memory as a snapshot, and the variant
+  // run from it next. The first run of the time loop is the case of the
+  // data deck itself.
+  struct SweepPlan {
+    std::vector<SweepVariant> variants;
+    std::vector<char> state;  // snapshot.h, in memory
+    bool captured = false;
+    std::size_t next = 0;     // variants run so far
+    std::ofstream out;        // .out of the variant running
+  };
+
+}
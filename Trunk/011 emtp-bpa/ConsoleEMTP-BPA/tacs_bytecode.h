@@ -0,0 +1,470 @@
+/***********************************
+EMTP C++
+TACS supplemental variables compiled to a flat code of registers: the
+free-format FORTRAN expressions (IOP / ARG of CSUP) and the old pseudo-
+FORTRAN variables, translated once and run by CSUP each time step.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace emtp {
+
+  // One instruction: register  d  of  a  and  b  (registers), or of the
+  // SPTACS cell  a  (load), or of function  fn  of CSUP (S.N. 111 - 134)
+  struct TacsOp {
+    enum Code : std::uint8_t {
+      load,            // SPTACS(A)
+      add, sub, mul,
+      divide,          // the division of CSUP (S.N. 500)
+      power, negate,
+      function,        // FN of A
+      // of the free-format expressions, against ZFL = 10 * FLZERO
+      not_, and_, or_,
+      eq, ne, lt, le, ge, gt,  // of B and A as D8 and D7 of S.N. 6185
+      // of the old pseudo-FORTRAN variables, against 1.0 (S.N. 101 - 105)
+      and1, or1, not1, nand1, nor1
+    };
+    Code code;
+    std::uint8_t fn;
+    std::int32_t d, a, b;
+  };
+
+  // The code of one supplemental variable. Constants sit in registers of
+  // their own, written once; the others are written by each run.
+  struct TacsCode {
+    int n1 = 0, n2 = 0;       // IVARB(KJSUP + I), IVARB(KKSUP + I) compiled
+    bool tried = false;       // translated, or found not to translate
+    bool ok = false;          // false: CSUP interprets the variable
+    std::vector<TacsOp> ops;
+    std::vector<double> regs;
+    int result = 0;           // register of the value
+    int last_b = -1;          // register of B at the end; -1: B is kept
+  };
+
+  // An element of IVARB as CSUP reads it: the kind of argument, the
+  // operator and the index
+  struct TacsElement {
+    int kind, op, index;
+  };
+
+  namespace tacs_bytecode {
+
+    // A value of the translation: a constant known now, or a register
+    struct Value {
+      bool known;
+      double c;
+      int reg;
+    };
+
+    // The translation: CSUP is followed with the values of the arguments
+    // left open, each arithmetic step it takes becomes an instruction.
+    // The steps only depend on the operators, the function codes and the
+    // numerical arguments, which do not change while the case runs.
+    // Function  fold(m, b)  gives the value of function  m  of a constant
+    // (not called for the random numbers of 34 and the division of 28).
+    template<class Fold>
+    class Translation {
+    public:
+      Translation(TacsCode& code, Fold fold) : code_(code), fold_(fold) {
+        code_.ops.clear();
+        code_.regs.clear();
+      }
+
+      Value constant(double c) { return Value{ true, c, -1 }; }
+      Value load(int cell) {
+        int const d = reg();
+        code_.ops.push_back({ TacsOp::load, 0, d, cell, 0 });
+        return Value{ false, 0.0, d };
+      }
+      Value add(Value x, Value y) {
+        if (x.known && y.known)
+          return constant(x.c + y.c);
+        return emit(TacsOp::add, x, y);
+      }
+      Value sub(Value x, Value y) {
+        if (x.known && y.known)
+          return constant(x.c - y.c);
+        return emit(TacsOp::sub, x, y);
+      }
+      // X * 1.0 is X to the bit
+      Value mul(Value x, Value y) {
+        if (x.known && y.known)
+          return constant(x.c * y.c);
+        if (y.known && y.c == 1.0)
+          return x;
+        if (x.known && x.c == 1.0)
+          return y;
+        return emit(TacsOp::mul, x, y);
+      }
+      Value divide(Value x, Value y) { return emit(TacsOp::divide, x, y); }
+      Value power(Value x, Value y) {
+        if (x.known && y.known)
+          return constant(std::pow(x.c, y.c));
+        return emit(TacsOp::power, x, y);
+      }
+      Value negate(Value x) {
+        if (x.known)
+          return constant(-x.c);
+        return emit(TacsOp::negate, x, x);
+      }
+      Value function(int m, Value x) {
+        if (x.known && m != 28 && m != 34)
+          return constant(fold_(m, x.c));
+        Value const v = emit(TacsOp::function, x, x);
+        code_.ops.back().fn = std::uint8_t(m);
+        return v;
+      }
+      Value logic(TacsOp::Code op, Value x, Value y) { return emit(op, x, y); }
+
+      // the value, and B of CSUP at the end if it was set
+      void finish(Value v, bool set, Value b) {
+        code_.result = materialize(v);
+        code_.last_b = set ? materialize(b) : -1;
+        code_.ok = true;
+      }
+
+    private:
+      int reg() {
+        code_.regs.push_back(0.0);
+        return int(code_.regs.size()) - 1;
+      }
+      int materialize(Value v) {
+        if (!v.known)
+          return v.reg;
+        int const d = reg();
+        code_.regs[std::size_t(d)] = v.c;
+        return d;
+      }
+      Value emit(TacsOp::Code op, Value x, Value y) {
+        int const a = materialize(x);
+        int const b = materialize(y);
+        int const d = reg();
+        code_.ops.push_back({ op, 0, d, a, b });
+        return Value{ false, 0.0, d };
+      }
+
+      TacsCode& code_;
+      Fold fold_;
+    };
+
+    // function code  m  of CSUP S.N. 30 - 60 taken by a function
+    inline bool is_function(int m) { return m >= 11 && m <= 34; }
+
+  }
+
+  // The free-format FORTRAN expression of  e  (S.N. 5000 - 6200 of CSUP):
+  // numerical arguments are SPTACS(KPRSUP + INDEX), given by  constant ,
+  // TACS variables SPTACS(KXTCS + INDEX). False if CSUP would not take a
+  // path of its own (function codes of the old variables, the bounds of
+  // its arrays); the variable is then left to CSUP.
+  template<class Constant, class Fold>
+  bool compile_expression(const std::vector<TacsElement>& e, int kxtcs,
+    Constant constant, Fold fold, TacsCode& code) {
+    using tacs_bytecode::Value;
+    code.ok = false;
+    code.tried = true;
+    int const nop = int(e.size());
+    if (nop < 1 || nop > 50)
+      return false;
+    tacs_bytecode::Translation<Fold> x(code, fold);
+    // IOP, ARG, IFL, IDN, ACC, AMX of CSUP, from 1
+    std::vector<int> iop(std::size_t(nop) + 1, 0);
+    std::vector<Value> arg(std::size_t(nop) + 1, x.constant(0.0));
+    int ifl[21] = {}, idn[22] = {};
+    Value acc[21], amx[21];
+    // B of CSUP, left as it was by an expression without parentheses
+    Value b = x.constant(0.0);
+    bool set = false;
+    for (int k = 1; k <= nop; ++k) {
+      auto const& el = e[std::size_t(k) - 1];
+      iop[k] = el.op;
+      switch (el.kind + 2) {
+        case 2:
+          arg[k] = x.constant(0.0);
+          break;
+        case 3:
+          arg[k] = x.load(kxtcs + el.index);
+          break;
+        case 4:
+          arg[k] = x.constant(el.index);
+          break;
+        default:
+          arg[k] = x.constant(constant(el.index));
+          break;
+      }
+    }
+    int jfl = 1;
+    ifl[1] = nop;
+    int i1 = 0, k1 = 0;
+    // no more steps than CSUP could take on an expression of NOP elements
+    for (int steps = 0; steps < 64 * nop + 64; ) {
+      // S.N. 6010, 6015
+      idn[jfl] = 0;
+      idn[jfl + 1] = 0;
+    s6015:
+      acc[jfl] = x.constant(0.0);
+      amx[jfl] = x.constant(1.0);
+    s6020:
+      if (++steps >= 64 * nop + 64)
+        return false;
+      if (jfl == 0) {
+        x.finish(acc[1], set, b);
+        return true;
+      }
+      i1 = ifl[jfl];
+      if (i1 == 0) {
+        jfl = jfl - 1;
+        goto s6020;
+      }
+      if (i1 < 0 || i1 > nop)
+        return false;
+      k1 = iop[i1];
+      if (k1 == 0)
+        goto s6028;
+      if (k1 <= 7) {
+        switch (k1) {
+          case 1:
+            // (
+            if (idn[jfl] == -1) {
+              jfl = jfl - 1;
+              goto s6020;
+            }
+            {
+              b = acc[jfl];
+              set = true;
+              if (i1 - 1 < 1 || !arg[i1 - 1].known || std::fabs(arg[i1 - 1].c) > 1.e9)
+                return false;
+              int const m = int(arg[i1 - 1].c);
+              if (m != 0) {
+                if (!tacs_bytecode::is_function(m))
+                  return false;
+                b = x.function(m, b);
+              }
+              arg[i1 - 1] = b;
+              jfl = jfl - 1;
+              iop[i1] = 0;
+            }
+            goto s6020;
+          case 2: case 4: case 6:
+            // NOT, then OR (2, 4) or AND (6)
+            arg[i1] = x.logic(TacsOp::not_, arg[i1], arg[i1]);
+            if (k1 == 6)
+              goto s6150;
+            goto s6130;
+          case 3:
+            goto s6130;
+          case 5:
+            goto s6150;
+          case 7:
+            goto s6170;
+        }
+      }
+      if (k1 >= 14) {
+        switch (k1 - 13) {
+          case 1:
+            // *
+            amx[jfl] = x.mul(amx[jfl], arg[i1]);
+            goto s6027;
+          case 2:
+            // /
+            amx[jfl] = x.divide(amx[jfl], arg[i1]);
+            goto s6027;
+          case 3: {
+            // **
+            int i2 = i1;
+            do {
+              i2 = i2 - 1;
+              if (i2 < 1)
+                return false;
+            } while (iop[i2] == 0);
+            if (iop[i2] == 7) {
+              i1 = i2;
+              goto s6170;
+            }
+            arg[i2] = x.power(arg[i2], arg[i1]);
+            goto s6027;
+          }
+          case 5:
+            // -
+            arg[i1] = x.negate(arg[i1]);
+            // fall through
+          case 4:
+            // +
+            acc[jfl] = x.add(acc[jfl], x.mul(arg[i1], amx[jfl]));
+            goto s6026;
+          default:
+            goto s6026;
+        }
+      }
+      // .NN.
+      if (idn[jfl + 1] != -1) {
+        jfl++;
+        if (jfl > 19)
+          return false;
+        ifl[jfl] = i1 - 1;
+        idn[jfl] = -1;
+        goto s6015;
+      }
+      iop[i1] = 0;
+      idn[jfl + 1] = 0;
+      {
+        Value const d7 = acc[jfl];
+        Value const d8 = acc[jfl + 1];
+        static const TacsOp::Code cmp[] = { TacsOp::ne, TacsOp::eq,
+          TacsOp::lt, TacsOp::le, TacsOp::ge, TacsOp::gt };
+        int const i2 = k1 - 7;
+        TacsOp::Code const op = i2 >= 1 && i2 <= 6 ? cmp[i2 - 1] : TacsOp::ne;
+        acc[jfl] = x.logic(op, d7, d8);
+      }
+      goto s6020;
+    s6130:
+      // OR
+      arg[i1] = x.logic(TacsOp::and_, arg[i1], amx[jfl]);
+      acc[jfl] = x.logic(TacsOp::or_, acc[jfl], arg[i1]);
+      goto s6026;
+    s6150:
+      // AND
+      amx[jfl] = x.logic(TacsOp::and_, amx[jfl], arg[i1]);
+      goto s6027;
+    s6026:
+      amx[jfl] = x.constant(1.0);
+    s6027:
+      iop[i1] = 0;
+    s6028:
+      ifl[jfl] = ifl[jfl] - 1;
+      goto s6020;
+    s6170:
+      // )
+      jfl++;
+      if (jfl > 19)
+        return false;
+      ifl[jfl] = i1 - 1;
+      iop[i1] = 0;
+    }
+    return false;
+  }
+
+  // The old pseudo-FORTRAN variable of  e  (S.N. 20 - 205 of CSUP): the
+  // argument is SPTACS(KXTCS + INDEX) if KIND > 0, the numerical argument
+  // SPTACS(KPRSUP + INDEX) if KIND < 0. False with KIND = 0, where CSUP
+  // goes on with the argument of the variable before.
+  template<class Constant, class Fold>
+  bool compile_variable(const std::vector<TacsElement>& e, int kxtcs,
+    Constant constant, Fold fold, TacsCode& code) {
+    using tacs_bytecode::Value;
+    code.ok = false;
+    code.tried = true;
+    tacs_bytecode::Translation<Fold> x(code, fold);
+    Value a = x.constant(0.0);
+    Value b = a;
+    for (auto const& el : e) {
+      int const m = el.op;
+      if (el.kind == 0)
+        return false;
+      b = el.kind > 0 ? x.load(kxtcs + el.index)
+        : x.constant(constant(el.index));
+      static const TacsOp::Code logic[] = { TacsOp::and1, TacsOp::or1,
+        TacsOp::not1, TacsOp::nand1, TacsOp::nor1 };
+      if (m >= 1 && m <= 5) {
+        a = x.logic(logic[m - 1], a, b);
+        continue;
+      }
+      if (m > 34) {
+        a = x.logic(TacsOp::and1, a, b);
+        continue;
+      }
+      if (m > 10)
+        b = x.function(m, b);
+      switch (el.kind > 0 ? el.kind : -el.kind) {
+        case 2:
+          a = x.sub(a, b);
+          break;
+        case 3:
+          a = x.mul(a, b);
+          break;
+        case 4:
+          a = x.divide(a, b);
+          break;
+        case 5:
+          a = x.power(a, b);
+          break;
+        default:
+          a = x.add(a, b);
+          break;
+      }
+    }
+    x.finish(a, !e.empty(), b);
+    return true;
+  }
+
+  // The code of the supplemental variables of a case, by the number of
+  // the variable; dropped by TACS1 with the data of the case
+  class TacsCodes {
+  public:
+    void enabled(bool on) { enabled_ = on; }
+    bool enabled() const { return enabled_; }
+    // CSUP takes the time of each call (the bench)
+    void timed(bool on) { timed_ = on; }
+    bool timed() const { return timed_; }
+
+    void clear() { codes_.clear(); }
+    // the slot of variable  i  (from 1), to be translated again if it was
+    // not translated from  n1 ,  n2
+    TacsCode& slot(int i, int n1, int n2) {
+      if (std::size_t(i) > codes_.size())
+        codes_.resize(std::size_t(i));
+      TacsCode& c = codes_[std::size_t(i) - 1];
+      if (c.tried && (c.n1 != n1 || c.n2 != n2))
+        c = TacsCode();
+      c.n1 = n1;
+      c.n2 = n2;
+      return c;
+    }
+
+    // variables compiled and left to CSUP, their instructions, and the
+    // calls and seconds of CSUP since reset(); seconds only if timed
+    int compiled() const {
+      int n = 0;
+      for (auto const& c : codes_)
+        n += c.ok ? 1 : 0;
+      return n;
+    }
+    int interpreted() const {
+      int n = 0;
+      for (auto const& c : codes_)
+        n += c.tried && !c.ok ? 1 : 0;
+      return n;
+    }
+    std::int64_t instructions() const {
+      std::int64_t n = 0;
+      for (auto const& c : codes_)
+        n += c.ok ? std::int64_t(c.ops.size()) : 0;
+      return n;
+    }
+    void count(double seconds) {
+      ++calls_;
+      seconds_ += seconds;
+    }
+    std::int64_t calls() const { return calls_; }
+    double seconds() const { return seconds_; }
+    void reset() {
+      calls_ = 0;
+      seconds_ = 0.0;
+    }
+
+  private:
+    bool enabled_ = true;
+    bool timed_ = false;
+    std::vector<TacsCode> codes_;
+    std::int64_t calls_ = 0;
+    double seconds_ = 0.0;
+  };
+
+}
@@ -0,0 +1,147 @@
+/***********************************
+EMTP C++
+Simultaneous ZnO solution of ZINCOX: the inverse of the collapsed Thevenin
+matrix of each subnetwork kept from step to step, the Thevenin currents of
+all arresters of the Newton iteration in lockstep, and its statistics.
+
+Licensed under the MIT License <https://opensource.org/licenses/MIT>
+  Copyright(c) 2021, Dr. Alan W. Zhang <alan92127@gmail.com>
+********************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace emtp {
+
+  // ZINCOX takes the Thevenin matrix of a subnetwork of coupled arresters
+  // from the columns ZNONL of SUBTS1, marks its zero and repeated rows
+  // (KSING, KINDEP) and inverts what is left before the Newton iteration
+  // on the arrester currents, every time step. All of that follows from
+  // the Thevenin matrix alone, which changes only with the factors of (Y):
+  // it is kept here per subnetwork, and a step whose matrix is the same to
+  // the bit takes it back instead of the O(n**3) inversion.
+  //
+  // The inverse is also kept transposed, arresters side by side, for the
+  // Thevenin currents of the iteration: each arrester sums its row in the
+  // order of the FORTRAN loop, four arresters per SIMD step.
+  class ZnoNewton {
+  public:
+    // KSING / KINDEP of the n7 arresters and the n17 x n17 inverse (n5
+    // terms) of subnetwork  ns  with the n7 x n7 Thevenin matrix  zthev ,
+    // if kept; otherwise the matrix is held for store()
+    bool restore(int ns, int n7, const double* zthev, double* inv,
+      double* ksing, double* kindep, int& n17, int& n5) {
+      std::size_t const nz = std::size_t(n7) * n7;
+      auto const it = subnet_.find(ns);
+      if (it == subnet_.end() || it->second.n7 != n7
+          || std::memcmp(it->second.zthev.data(), zthev, nz * sizeof(double)) != 0) {
+        pending_.assign(zthev, zthev + nz);
+        current_ = nullptr;
+        return false;
+      }
+      Subnet const& s = it->second;
+      std::copy(s.inv.begin(), s.inv.end(), inv);
+      std::copy(s.ksing.begin(), s.ksing.end(), ksing);
+      std::copy(s.kindep.begin(), s.kindep.end(), kindep);
+      n17 = s.n17;
+      n5 = int(s.inv.size());
+      current_ = &it->second;
+      ++reused_;
+      return true;
+    }
+    // the inverse just computed for the matrix of the last restore()
+    void store(int ns, int n7, const double* inv, const double* ksing,
+      const double* kindep, int n17, int n5) {
+      Subnet& s = subnet_[ns];
+      s.n7 = n7;
+      s.n17 = n17;
+      s.zthev.swap(pending_);
+      s.inv.assign(inv, inv + n5);
+      s.ksing.assign(ksing, ksing + n7);
+      s.kindep.assign(kindep, kindep + n7);
+      // row k of the inverse (volti((k-1)*n17 + j)) as column k
+      s.np = (std::size_t(n17) + lanes - 1) / lanes * lanes;
+      s.invt.assign(std::size_t(n17) * s.np, 0.0);
+      for (int k = 0; k < n17; ++k) {
+        for (int j = 0; j < n17; ++j)
+          s.invt[std::size_t(j) * s.np + k] = inv[std::size_t(k) * n17 + j];
+      }
+      current_ = &s;
+      ++inverted_;
+    }
+    void clear() {
+      subnet_.clear();
+      pending_.clear();
+      current_ = nullptr;
+    }
+
+    // is the transposed inverse of the subnetwork of the last restore() /
+    // store() there for thevenin()?
+    bool lockstep() const { return current_ != nullptr; }
+    // x(k) = 0 - SUM over j of INV(k, j) * d(j) for the n17 independent
+    // arresters at once, d(j) = VOLTK(2j) - VOLTK(2j-1) of the j-th of them
+    // and j in increasing order as in the FORTRAN loop
+    void thevenin(const double* voltk, const double* ksing, double* x) {
+      Subnet const& s = *current_;
+      d_.clear();
+      for (int m = 0; m < s.n7; ++m) {
+        if (ksing[m] == 0)
+          d_.push_back(voltk[2 * m + 1] - voltk[2 * m]);
+      }
+      acc_.assign(s.np, 0.0);
+      double* a = acc_.data();
+      for (int j = 0; j < s.n17; ++j)
+        sub_scaled(a, &s.invt[std::size_t(j) * s.np], d_[j], s.np);
+      std::copy(a, a + s.n17, x);
+    }
+
+    // one Newton solution of  niter  iterations, the last correction
+    // max |DV / VREF| = dv
+    void count(int niter, double dv) {
+      ++solutions_;
+      iterations_ += niter;
+      max_iterations_ = std::max(max_iterations_, niter);
+      max_dv_ = std::max(max_dv_, dv);
+    }
+    std::int64_t solutions() const { return solutions_; }
+    std::int64_t iterations() const { return iterations_; }
+    int max_iterations() const { return max_iterations_; }
+    double max_dv() const { return max_dv_; }
+    std::int64_t inverted() const { return inverted_; }
+    std::int64_t reused() const { return reused_; }
+
+  private:
+    static constexpr std::size_t lanes = 4;
+    static void sub_scaled(double* __restrict x, const double* __restrict a,
+      double v, std::size_t n) {
+      for (std::size_t m = 0; m < n; m += lanes) {
+        x[m] = x[m] - a[m] * v;
+        x[m + 1] = x[m + 1] - a[m + 1] * v;
+        x[m + 2] = x[m + 2] - a[m + 2] * v;
+        x[m + 3] = x[m + 3] - a[m + 3] * v;
+      }
+    }
+
+    struct Subnet {
+      int n7 = 0;
+      int n17 = 0;
+      std::size_t np = 0;
+      std::vector<double> zthev, inv, invt, ksing, kindep;
+    };
+    std::unordered_map<int, Subnet> subnet_;
+    Subnet* current_ = nullptr;
+    std::vector<double> pending_, d_, acc_;
+    std::int64_t solutions_ = 0;
+    std::int64_t iterations_ = 0;
+    int max_iterations_ = 0;
+    double max_dv_ = 0.0;
+    std::int64_t inverted_ = 0;
+    std::int64_t reused_ = 0;
+  };
+
+}
@@ -2,6 +2,8 @@
 #define FEM_ARR_HPP
 
 #include <fem/arr_ref.hpp>
+#include <cstdlib>
+#include <new>
 
 namespace fem {
 
@@ -16,6 +18,19 @@ namespace fem {
       operator=(
         arr const&);
 
+      static
+      T&
+      allocate(
+        size_t size)
+      {
+        if constexpr (zero_bytes_is_fill0<T>::value) {
+          void* p = std::calloc(size == 0 ? 1 : size, sizeof(T));
+          if (p == 0) throw std::bad_alloc();
+          return *static_cast<T*>(p);
+        }
+        return *(new T[size]);
+      }
+
       public:
 
     template <size_t BufferNdims>
@@ -23,7 +38,7 @@ namespace fem {
     arr(
       dims<BufferNdims> const& dims)
     :
-      arr_ref<T, Ndims>(*(new T[dims.size_1d(Ndims)]), dims)
+      arr_ref<T, Ndims>(allocate(dims.size_1d(Ndims)), dims)
     {}
 
     template <size_t BufferNdims>
@@ -31,7 +46,7 @@ namespace fem {
       dims<BufferNdims> const& dims,
       no_fill0_type const&)
     :
-      arr_ref<T, Ndims>(*(new T[dims.size_1d(Ndims)]), dims, no_fill0)
+      arr_ref<T, Ndims>(allocate(dims.size_1d(Ndims)), dims, no_fill0)
     {}
 
     template <size_t BufferNdims>
@@ -39,12 +54,21 @@ namespace fem {
       dims<BufferNdims> const& dims,
       fill0_type const&)
     :
-      arr_ref<T, Ndims>(*(new T[dims.size_1d(Ndims)]), dims, fill0)
-    {}
+      arr_ref<T, Ndims>(allocate(dims.size_1d(Ndims)), dims, no_fill0)
+    {
+      if constexpr (!zero_bytes_is_fill0<T>::value) {
+        std::memset(this->begin(), 0, this->dims_.size_1d() * sizeof(T));
+      }
+    }
 
     ~arr()
     {
-      delete[] this->elems_;
+      if constexpr (zero_bytes_is_fill0<T>::value) {
+        std::free(const_cast<T*>(this->elems_));
+      }
+      else {
+        delete[] this->elems_;
+      }
     }
 
     operator
@@ -117,16 +117,16 @@ namespace fem {
 #define FEM_CMN_SVE(FUNC) \
   bool is_called_first_time = cmn.FUNC##_sve.is_called_first_time(); \
   if (is_called_first_time) { \
-    cmn.FUNC##_sve.construct<FUNC##_save>(); \
+    cmn.FUNC##_sve.template construct<FUNC##_save>(); \
   } \
-  FUNC##_save& sve = cmn.FUNC##_sve.get<FUNC##_save>(); \
+  FUNC##_save& sve = cmn.FUNC##_sve.template get<FUNC##_save>(); \
   fem::no_operation_to_avoid_unused_variable_warning(sve)
 
 #define FEM_CMN_SVE_DYNAMIC_PARAMETERS(FUNC) \
   bool is_called_first_time = cmn.FUNC##_sve.is_called_first_time(); \
   if (is_called_first_time) { \
-    cmn.FUNC##_sve.construct<FUNC##_save>(cmn.dynamic_params); \
+    cmn.FUNC##_sve.template construct<FUNC##_save>(cmn.dynamic_params); \
   } \
-  FUNC##_save& sve = cmn.FUNC##_sve.get<FUNC##_save>()
+  FUNC##_save& sve = cmn.FUNC##_sve.template get<FUNC##_save>()
 
 #endif // GUARD
@@ -7,6 +7,9 @@
 #include <fem/utils/misc.hpp>
 #include <fem/utils/token.hpp>
 #include <vector>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <stdexcept>
 #include <cstring>
 
@@ -210,6 +213,38 @@ namespace fem { namespace format {
       }
   };
 
+  typedef std::shared_ptr<std::vector<utils::token> const> token_list;
+
+  // Tokens of a FORMAT specification, parsed once per thread and format
+  // text. Keyed by the text, not the pointer: formats built at run time
+  // in a reused buffer must not pick up stale tokens.
+  inline token_list
+  cached_tokens(
+    char const* fmt,
+    unsigned fmt_stop)
+  {
+    struct entry
+    {
+      std::string text;
+      token_list tokens;
+    };
+    static thread_local
+      std::unordered_map<std::string_view, std::unique_ptr<entry> > cache;
+    std::string_view key(fmt, fmt_stop);
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second->tokens;
+    if (cache.size() >= 4096) cache.clear(); // live loops keep their tokens
+    std::unique_ptr<entry> e(new entry);
+    e->text.assign(fmt, fmt_stop);
+    tokenizer tz(fmt, fmt_stop);
+    e->tokens = std::make_shared<std::vector<utils::token> const>(
+      std::move(tz.tokens));
+    token_list result = e->tokens;
+    key = e->text;
+    cache.emplace(key, std::move(e));
+    return result;
+  }
+
   struct repeat_point
   {
     unsigned i_fmt;
@@ -229,7 +264,7 @@ namespace fem { namespace format {
 
   struct token_loop
   {
-    std::vector<utils::token> fmt_tokens;
+    token_list tokens; // shared with the cache; never modified
     unsigned i_fmt;
     unsigned i_fmt_wrap;
     unsigned simple_repeat;
@@ -237,6 +272,7 @@ namespace fem { namespace format {
 
     token_loop()
     :
+      tokens(empty_tokens()),
       i_fmt(0),
       i_fmt_wrap(0),
       simple_repeat(0)
@@ -245,19 +281,25 @@ namespace fem { namespace format {
     token_loop(
       str_cref fmt)
     :
+      tokens(cached_tokens(fmt.elems(), fmt.len())),
       i_fmt(0),
       i_fmt_wrap(0),
       simple_repeat(0)
+    {}
+
+    static token_list const&
+    empty_tokens()
     {
-      format::tokenizer tz(fmt.elems(), fmt.len());
-      fmt_tokens.swap(tz.tokens);
-      repeat_points.reserve(32); // uncritical; avoids reallocation in most
-    }                            // cases
+      static const token_list empty =
+        std::make_shared<std::vector<utils::token> const>();
+      return empty;
+    }
 
     utils::token const*
     next_executable_token(
       bool final=false)
     {
+      std::vector<utils::token> const& fmt_tokens = *tokens;
       if (simple_repeat != 0) {
         simple_repeat--;
         i_fmt--;
@@ -134,8 +134,8 @@ namespace fem {
         else {
           size_t run_away_counter = 0;
           while (true) {
-            file_name = std::filesystem::temp_directory_path().string()
-              + "io_unit_scratch_" + utils::random_name_simple(8);
+            file_name = (std::filesystem::temp_directory_path()
+              / ("io_unit_scratch_" + utils::random_name_simple(8))).string();
             if (!utils::path::exists(file_name.c_str())) {
               break;
             }
@@ -308,6 +308,7 @@ namespace fem {
   struct io : utils::noncopyable
   {
     std::map<int, io_unit> units;
+    std::map<int, std::string*> captures;
 
     io()
     {
@@ -404,10 +405,29 @@ namespace fem {
       return false;
     }
 
+    //! Records written to  unit  are appended to  *buffer  instead of
+    //! its file, until capture(unit, 0).
+    void
+    capture(
+      int unit,
+      std::string* buffer)
+    {
+      if (buffer == 0) captures.erase(unit);
+      else captures[unit] = buffer;
+    }
+
     utils::slick_ptr<utils::simple_ostream>
     simple_ostream(
       int unit)
     {
+      if (!captures.empty()) {
+        typedef std::map<int, std::string*>::const_iterator it;
+        it c = captures.find(unit);
+        if (c != captures.end()) {
+          return utils::slick_ptr<utils::simple_ostream>(new
+            utils::simple_ostream_to_std_string(*c->second));
+        }
+      }
       io_unit* u_ptr = unit_ptr(unit, /*auto_open*/ true);
       std_file& sf = u_ptr->stream;
       if (!u_ptr->prev_op_was_write) {
@@ -208,6 +208,12 @@ namespace fem {
     static str<StrLen> get() { return str<StrLen>(); }
   };
 
+  template <int StrLen>
+  struct zero_bytes_is_fill0<str<StrLen> >
+  {
+    static const bool value = true;
+  };
+
 } // namespace fem
 
 #endif // GUARD
@@ -107,13 +107,11 @@ namespace fem { namespace utils {
         1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16};
       typedef utils::int64_t i64;
       TBXX_ASSERT(sizeof(i64) >= sizeof(double));
-      static i64 multipliers_i64[max_nd_significant+1] = {0};
-      if (multipliers_i64[0] == 0) {
-        multipliers_i64[0] = 1;
-        for(int i=1;i<=max_nd_significant;i++) {
-          multipliers_i64[i] = multipliers_i64[i-1] * 10;
-        }
-      }
+      static const i64 multipliers_i64[max_nd_significant+1] = {
+        1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL,
+        10000000LL, 100000000LL, 1000000000LL, 10000000000LL,
+        100000000000LL, 1000000000000LL, 10000000000000LL,
+        100000000000000LL, 1000000000000000LL, 10000000000000000LL};
       int nd_significant = std::min(nd, max_nd_significant);
       int nd_unknown = nd - nd_significant;
       double multiplier = multipliers_dbl[nd_significant];
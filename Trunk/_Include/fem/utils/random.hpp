@@ -3,7 +3,11 @@
 
 #include <fem/size_t.hpp>
 #include <string>
+#include <cstdint>
 #include <ctime>
+#include <functional>
+#include <random>
+#include <thread>
 
 namespace fem { namespace utils {
 
@@ -12,18 +16,16 @@ namespace fem { namespace utils {
   random_name_simple(
     size_t size)
   {
-    static bool first_call = true;
-    static size_t random_state;
-    static const size_t random_mod = 225150U;
-    if (first_call) {
-      first_call = false;
-      random_state = static_cast<size_t>(std::time(0)) % random_mod;
-    }
+    // per-thread engine: concurrent simulations must not draw the same
+    // scratch-file names from a shared sequence
+    static thread_local std::mt19937_64 engine(
+      (static_cast<std::uint64_t>(std::random_device()()) << 32)
+      ^ static_cast<std::uint64_t>(std::time(0))
+      ^ std::hash<std::thread::id>()(std::this_thread::get_id()));
     std::string result;
     result.reserve(size);
     for(size_t i=0;i<size;i++) {
-      random_state = (random_state * 9538U + 50294U) % random_mod;
-      size_t j = random_state % (i == 0 ? 26U : 36U);
+      size_t j = static_cast<size_t>(engine() % (i == 0 ? 26U : 36U));
       result.push_back("abcdefghijklmnopqrstuvwxyz0123456789"[j]);
     }
     return result;
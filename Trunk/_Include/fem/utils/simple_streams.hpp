@@ -98,12 +98,7 @@ namespace fem { namespace utils {
     put(char c) { s.push_back(c); }
 
     void
-    put(char const* str, size_t str_sz)
-    {
-      for(size_t i=0;i<str_sz;i++) {
-        s.push_back(str[i]);
-      }
-    }
+    put(char const* str, size_t str_sz) { s.append(str, str_sz); }
 
     void
     flush() {}
@@ -124,12 +119,7 @@ namespace fem { namespace utils {
     put(char c) { std::fputc(c, f); }
 
     void
-    put(char const* str, size_t str_sz)
-    {
-      for(size_t i=0;i<str_sz;i++) {
-        std::fputc(str[i], f);
-      }
-    }
+    put(char const* str, size_t str_sz) { std::fwrite(str, 1, str_sz, f); }
 
     void
     flush() { std::fflush(f); }
@@ -3,6 +3,7 @@
 
 #include <fem/data_type_star.hpp>
 #include <complex>
+#include <type_traits>
 
 namespace fem {
 
@@ -56,6 +57,23 @@ namespace fem {
   enum fill0_type { fill0 };
   enum no_fill0_type { no_fill0 };
 
+  /*! True if an all-zero byte pattern is a valid, fully constructed T.
+      Such arrays are obtained zeroed from the allocator, so large
+      COMMON blocks are backed by demand-zero pages and only the pages
+      actually touched by a case are ever committed.
+   */
+  template <typename T>
+  struct zero_bytes_is_fill0
+  {
+    static const bool value = std::is_trivial<T>::value;
+  };
+
+  template <typename T>
+  struct zero_bytes_is_fill0<std::complex<T> >
+  {
+    static const bool value = true;
+  };
+
 } // namespace fem
 
 #endif // GUARD
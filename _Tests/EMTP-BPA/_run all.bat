@@ -9,6 +9,17 @@ call "_bin\ConsoleEMTP-BPA.exe" "!name!\test.dat"
 copy /Y "!name!\*.out" "!name!\!name!_result.txt" >NUL
 )
 
+rem case0016: case0007 swept by --sweep. The rows of its TOPEN variant are the result;
+rem a variant moving a TCLOSE already reached must be refused, else no result is left
+call "_bin\ConsoleEMTP-BPA.exe" --sweep "case0016\sweep.dat" "case0016\test.dat"
+copy /Y "case0016\test.dat.out.topen" "case0016\case0016_result.txt" >NUL
+call "_bin\ConsoleEMTP-BPA.exe" --sweep "case0016\badsweep.dat" "case0016\test.dat" > "case0016\badsweep.txt"
+findstr /C:"has already closed" "case0016\badsweep.txt" >NUL || del "case0016\case0016_result.txt"
+
+rem case0017: a STATISTICS case, its energizations on the worker threads
+call "_bin\ConsoleEMTP-BPA.exe" "case0017\test.dat"
+copy /Y "case0017\*.out" "case0017\case0017_result.txt" >NUL
+
 
 rem call "_bin\ConsoleEMTP-BPA.exe" "case0001\test.dat"
 rem copy /Y "case0001\*.out" "case0001\case0001_result.txt" >NUL